@@ -3,8 +3,6 @@
 # Fail on failing QTest execution
 set -e
 
-find . -executable -type f -name "tst_*" | while read line; do
-    echo "Running unit test: "
-    echo "${line}"
-    ($line)
-done
\ No newline at end of file
+# Tests are registered with CTest; the simulation test suites are split into
+# shards which are executed in parallel.
+ctest --output-on-failure -j "$(nproc 2>/dev/null || echo 4)"
@@ -0,0 +1,397 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QTimer>
+
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+
+#include "cachesim/l1cacheshim.h"
+#include "cli/programutilities.h"
+#include "io/iomanager.h"
+#include "pipelinediagrammodel.h"
+#include "processorhandler.h"
+#include "processorregistry.h"
+#include "ripessettings.h"
+#include "version/version.h"
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+// windows.h must be included before psapi.h
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+// Simulation throughput benchmark. Runs a fixed set of workloads on every
+// processor model under a set of simulator configurations, and reports the
+// achieved simulation speed (cycles/second) alongside the peak resident set
+// size as JSON. Each benchmark runs in a process of its own, such that the
+// peak resident set size is that of a single benchmark.
+
+using namespace Ripes;
+
+namespace {
+
+struct Workload {
+  QString name;
+  // Returns the path (ELF) or source text (assembly) of the workload for a
+  // processor with the given register width.
+  std::function<QString(unsigned xlen)> source;
+  bool isELF = false;
+};
+
+struct Config {
+  QString name;
+  bool caches = false;
+  bool reversal = false;
+  bool pipeline = false;
+};
+
+// Touches a 4 KiB buffer word by word, exercising the data memory and caches.
+const QString s_memoryKernel = R"(
+.data
+buf: .zero 4096
+.text
+        li s0, 50
+outer:
+        la t0, buf
+        li t1, 1024
+inner:
+        lw t2, 0(t0)
+        addi t2, t2, 1
+        sw t2, 0(t0)
+        addi t0, t0, 4
+        addi t1, t1, -1
+        bnez t1, inner
+        addi s0, s0, -1
+        bnez s0, outer
+        li a7, 10
+        ecall
+)";
+
+// Data-dependent branches on a xorshift sequence, exercising control hazards.
+const QString s_branchKernel = R"(
+.text
+        li s0, 20000
+        li s1, 12345
+loop:
+        slli t0, s1, 13
+        xor s1, s1, t0
+        srli t0, s1, 17
+        xor s1, s1, t0
+        slli t0, s1, 5
+        xor s1, s1, t0
+        andi t1, s1, 1
+        beqz t1, even
+        addi s2, s2, 1
+        j next
+even:
+        addi s3, s3, 1
+next:
+        andi t1, s1, 2
+        bnez t1, skip
+        addi s4, s4, 1
+skip:
+        addi s0, s0, -1
+        bnez s0, loop
+        li a7, 10
+        ecall
+)";
+
+QString readFile(const QString &path) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly))
+    return QString();
+  return file.readAll();
+}
+
+std::vector<Workload> workloads() {
+  const QString examples = RIPES_EXAMPLES_DIR;
+  return {
+      {"complexMul",
+       [=](unsigned) {
+         return readFile(examples + "/assembly/complexMul.s");
+       }},
+      {"factorial",
+       [=](unsigned) { return readFile(examples + "/assembly/factorial.s"); }},
+      {"ranpi",
+       [=](unsigned xlen) {
+         return examples + "/ELF/RanPi-RV" + QString::number(xlen);
+       },
+       true},
+      {"memory", [](unsigned) { return s_memoryKernel; }},
+      {"branch", [](unsigned) { return s_branchKernel; }},
+  };
+}
+
+const std::vector<Config> s_configs = {
+    {"base", false, false, false},
+    {"caches", true, false, false},
+    {"reversal", false, true, false},
+    {"pipeline", false, false, true},
+    {"all", true, true, true},
+};
+
+/// Returns the peak resident set size of this process in bytes, or -1 if
+/// unavailable on the host platform.
+long long peakRSS() {
+#if defined(Q_OS_WIN)
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    return static_cast<long long>(pmc.PeakWorkingSetSize);
+  return -1;
+#elif defined(Q_OS_UNIX)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return -1;
+#if defined(Q_OS_MACOS)
+  return usage.ru_maxrss; // bytes
+#else
+  return usage.ru_maxrss * 1024LL; // kilobytes
+#endif
+#else
+  return -1;
+#endif
+}
+
+QString loadWorkload(const Workload &workload) {
+  const QString source =
+      workload.source(ProcessorHandler::currentISA()->bits());
+  auto program = std::make_shared<Program>();
+  if (workload.isELF) {
+    QFile file(source);
+    const QString err = loadElfFile(*program, file);
+    if (!err.isEmpty())
+      return err;
+  } else {
+    if (source.isEmpty())
+      return "Could not read workload source";
+    auto res = ProcessorHandler::getAssembler()->assembleRaw(
+        source, &IOManager::get().assemblerSymbols());
+    if (!res.errors.empty())
+      return "Assembly failed: " + res.errors.front().errorMessage();
+    *program = res.program;
+  }
+  ProcessorHandler::loadProgram(program);
+  return QString();
+}
+
+/// Runs the currently loaded program to completion through
+/// ProcessorHandler::run. Returns false on timeout.
+bool runToCompletion(int timeoutMs) {
+  QEventLoop loop;
+  QObject::connect(ProcessorHandler::get(), &ProcessorHandler::runFinished,
+                   &loop, &QEventLoop::quit);
+  bool hadTimeout = false;
+  QTimer timeoutTimer;
+  timeoutTimer.setSingleShot(true);
+  QObject::connect(&timeoutTimer, &QTimer::timeout, &loop, [&] {
+    hadTimeout = true;
+    loop.quit();
+  });
+  ProcessorHandler::run();
+  timeoutTimer.start(timeoutMs);
+  loop.exec();
+  if (hadTimeout)
+    ProcessorHandler::stopRun();
+  return !hadTimeout;
+}
+
+QJsonObject benchmark(ProcessorID id, const Workload &workload,
+                      const Config &config, int minTimeMs) {
+  QJsonObject result;
+  result["processor"] = enumToString<ProcessorID>(id);
+  result["workload"] = workload.name;
+  result["config"] = config.name;
+
+  const auto &desc = ProcessorRegistry::getDescription(id);
+  ProcessorHandler::selectProcessor(id, desc.isaInfo().supportedExtensions,
+                                    desc.defaultRegisterVals);
+  ProcessorHandler::getProcessorNonConst()->setMaxReverseCycles(
+      config.reversal ? RipesSettings::value(RIPES_SETTING_REWINDSTACKSIZE)
+                            .toUInt()
+                      : 0);
+
+  std::unique_ptr<L1CacheShim> dShim, iShim;
+  std::shared_ptr<CacheSim> dCache, iCache;
+  if (config.caches) {
+    dShim = std::make_unique<L1CacheShim>(L1CacheShim::CacheType::DataCache,
+                                          nullptr);
+    iShim = std::make_unique<L1CacheShim>(L1CacheShim::CacheType::InstrCache,
+                                          nullptr);
+    dCache = std::make_shared<CacheSim>(nullptr);
+    iCache = std::make_shared<CacheSim>(nullptr);
+    dShim->setNextLevelCache(dCache);
+    iShim->setNextLevelCache(iCache);
+  }
+  std::unique_ptr<PipelineDiagramModel> pipelineModel;
+  if (config.pipeline)
+    pipelineModel = std::make_unique<PipelineDiagramModel>();
+
+  const QString err = loadWorkload(workload);
+  if (!err.isEmpty()) {
+    result["error"] = err;
+    return result;
+  }
+
+  // Repeat the workload until the minimum measurement time has elapsed.
+  long long cycles = 0;
+  long long instructions = 0;
+  unsigned repetitions = 0;
+  QElapsedTimer timer;
+  timer.start();
+  do {
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+    if (!runToCompletion(/*timeoutMs=*/60000)) {
+      result["error"] = "Workload did not finish";
+      return result;
+    }
+    cycles += ProcessorHandler::getProcessor()->getCycleCount();
+    instructions += ProcessorHandler::getProcessor()->getInstructionsRetired();
+    ++repetitions;
+  } while (timer.elapsed() < minTimeMs);
+  const double seconds = timer.nsecsElapsed() / 1e9;
+
+  result["repetitions"] = static_cast<int>(repetitions);
+  result["cycles"] = cycles;
+  result["instructions"] = instructions;
+  result["seconds"] = seconds;
+  result["cyclesPerSecond"] = cycles / seconds;
+  result["peakRSS"] = peakRSS();
+  return result;
+}
+
+/// Runs a benchmark in a child process (see the --child option).
+QJsonObject benchmarkInChild(ProcessorID id, const Workload &workload,
+                             const Config &config, int minTimeMs) {
+  QProcess process;
+  process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+  process.start(QCoreApplication::applicationFilePath(),
+                {"--child", "--proc", enumToString<ProcessorID>(id),
+                 "--workload", workload.name, "--config", config.name,
+                 "--min-time", QString::number(minTimeMs)});
+  if (!process.waitForFinished(-1) ||
+      process.exitStatus() != QProcess::NormalExit ||
+      process.exitCode() != 0) {
+    QJsonObject result;
+    result["processor"] = enumToString<ProcessorID>(id);
+    result["workload"] = workload.name;
+    result["config"] = config.name;
+    result["error"] = "Benchmark process did not exit successfully";
+    return result;
+  }
+  return QJsonDocument::fromJson(process.readAllStandardOutput()).object();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  QCoreApplication app(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      "Ripes simulation throughput benchmark. Reports cycles/second and peak "
+      "RSS for each combination of processor model, workload and simulator "
+      "configuration as JSON.");
+  parser.addHelpOption();
+  parser.addOption(QCommandLineOption(
+      "proc", "Only run the given processor models (comma separated).",
+      "names"));
+  parser.addOption(QCommandLineOption(
+      "workload", "Only run the given workloads (comma separated).", "names"));
+  parser.addOption(QCommandLineOption(
+      "config", "Only run the given configurations (comma separated).",
+      "names"));
+  parser.addOption(QCommandLineOption(
+      "min-time", "Minimum measurement time per benchmark in milliseconds.",
+      "ms", "250"));
+  parser.addOption(QCommandLineOption(
+      "output", "Output file. If not set, results are printed to stdout.",
+      "path"));
+  QCommandLineOption childOption(
+      "child", "Run the single selected benchmark in this process, and print "
+               "its result to stdout.");
+  childOption.setFlags(QCommandLineOption::HiddenFromHelp);
+  parser.addOption(childOption);
+  parser.process(app);
+
+  // Benchmarks modify the simulator settings; use a temporary settings store
+  // rather than the user's.
+  QTemporaryDir settingsDir;
+  QSettings::setDefaultFormat(QSettings::IniFormat);
+  QSettings::setPath(QSettings::IniFormat, QSettings::UserScope,
+                     settingsDir.path());
+
+  auto selected = [&](const QString &option, const QString &name) {
+    return !parser.isSet(option) ||
+           parser.value(option).split(",").contains(name);
+  };
+  const int minTimeMs = parser.value("min-time").toInt();
+
+  // Pipeline recording is otherwise capped at a small number of cycles.
+  RipesSettings::setValue(RIPES_SETTING_PIPEDIAGRAM_MAXCYCLES,
+                          std::numeric_limits<int>::max());
+
+  QJsonArray results;
+  for (const auto &desc : ProcessorRegistry::getAvailableProcessors()) {
+    const ProcessorID id = desc.first;
+    if (!selected("proc", enumToString<ProcessorID>(id)))
+      continue;
+    for (const auto &workload : workloads()) {
+      if (!selected("workload", workload.name))
+        continue;
+      for (const auto &config : s_configs) {
+        if (!selected("config", config.name))
+          continue;
+        if (parser.isSet(childOption)) {
+          const auto result = benchmark(id, workload, config, minTimeMs);
+          std::cout << QJsonDocument(result)
+                           .toJson(QJsonDocument::Compact)
+                           .toStdString();
+          return 0;
+        }
+        auto result = benchmarkInChild(id, workload, config, minTimeMs);
+        std::cerr << result["processor"].toString().toStdString() << " "
+                  << workload.name.toStdString() << " "
+                  << config.name.toStdString() << ": "
+                  << static_cast<long long>(
+                         result["cyclesPerSecond"].toDouble())
+                  << " cycles/s" << std::endl;
+        results.append(result);
+      }
+    }
+  }
+
+  if (parser.isSet(childOption)) {
+    std::cerr << "ERROR: No benchmark selected" << std::endl;
+    return 1;
+  }
+
+  QJsonObject report;
+  report["version"] = getRipesVersion();
+  report["results"] = results;
+  const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+  if (parser.isSet("output")) {
+    QFile out(parser.value("output"));
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      std::cerr << "ERROR: Failed to open output file" << std::endl;
+      return 1;
+    }
+    out.write(json);
+  } else {
+    std::cout << json.toStdString();
+  }
+  return 0;
+}
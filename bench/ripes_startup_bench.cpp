@@ -0,0 +1,207 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(Q_OS_UNIX)
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+#endif
+
+// Command line startup benchmark. Repeatedly starts the Ripes command line
+// interface, both through the GUI executable ('Ripes --mode cli') and through
+// the headless executable ('ripes-cli'), and reports the wall-clock time and
+// peak resident set size of each started process as JSON.
+
+namespace {
+
+struct Executable {
+  QString name;
+  QString path;
+  QStringList args;
+};
+
+struct Scenario {
+  QString name;
+  QStringList args;
+};
+
+struct Sample {
+  double seconds = 0;
+  /// Peak resident set size of the process in bytes, or -1 if unavailable on
+  /// the host platform.
+  long long peakRSS = -1;
+  int exitCode = -1;
+};
+
+const std::vector<Executable> s_executables = {
+    {"gui", RIPES_GUI_EXECUTABLE, {"--mode", "cli"}},
+    {"headless", RIPES_CLI_EXECUTABLE, {}},
+};
+
+std::vector<Scenario> scenarios() {
+  const QString examples = RIPES_EXAMPLES_DIR;
+  return {
+      // Application startup and command line parsing only.
+      {"help", {"--help"}},
+      // Startup, assembly and simulation of a small program.
+      {"factorial",
+       {"--src", examples + "/assembly/factorial.s", "-t", "asm", "--proc",
+        "RV32_SS", "--cycles"}},
+  };
+}
+
+#if defined(Q_OS_UNIX)
+Sample spawn(const QString &program, const QStringList &args) {
+  Sample sample;
+  std::vector<std::string> argStrings = {program.toStdString()};
+  for (const auto &arg : args)
+    argStrings.push_back(arg.toStdString());
+  std::vector<char *> argv;
+  for (auto &arg : argStrings)
+    argv.push_back(arg.data());
+  argv.push_back(nullptr);
+
+  // Discard the output of the started process.
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null",
+                                   O_WRONLY, 0);
+  posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null",
+                                   O_WRONLY, 0);
+
+  QElapsedTimer timer;
+  timer.start();
+  pid_t pid;
+  const int err = posix_spawn(&pid, argv[0], &actions, nullptr, argv.data(),
+                              environ);
+  posix_spawn_file_actions_destroy(&actions);
+  if (err != 0)
+    return sample;
+
+  int status = 0;
+  struct rusage usage;
+  if (wait4(pid, &status, 0, &usage) != pid)
+    return sample;
+  sample.seconds = timer.nsecsElapsed() / 1e9;
+#if defined(Q_OS_MACOS)
+  sample.peakRSS = usage.ru_maxrss; // bytes
+#else
+  sample.peakRSS = usage.ru_maxrss * 1024LL; // kilobytes
+#endif
+  if (WIFEXITED(status))
+    sample.exitCode = WEXITSTATUS(status);
+  return sample;
+}
+#else
+Sample spawn(const QString &program, const QStringList &args) {
+  Sample sample;
+  QProcess process;
+  process.setStandardOutputFile(QProcess::nullDevice());
+  process.setStandardErrorFile(QProcess::nullDevice());
+  QElapsedTimer timer;
+  timer.start();
+  process.start(program, args);
+  if (!process.waitForFinished(-1))
+    return sample;
+  sample.seconds = timer.nsecsElapsed() / 1e9;
+  if (process.exitStatus() == QProcess::NormalExit)
+    sample.exitCode = process.exitCode();
+  return sample;
+}
+#endif
+
+double median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  return values.empty() ? 0 : values.at(values.size() / 2);
+}
+
+QJsonObject benchmark(const Executable &exec, const Scenario &scenario,
+                      unsigned repetitions) {
+  QJsonObject result;
+  result["executable"] = exec.name;
+  result["scenario"] = scenario.name;
+
+  std::vector<double> seconds;
+  long long peakRSS = -1;
+  for (unsigned i = 0; i < repetitions; ++i) {
+    const Sample sample = spawn(exec.path, exec.args + scenario.args);
+    if (sample.exitCode != 0) {
+      result["error"] = "Process did not exit successfully";
+      return result;
+    }
+    seconds.push_back(sample.seconds);
+    peakRSS = std::max(peakRSS, sample.peakRSS);
+  }
+
+  result["repetitions"] = static_cast<int>(repetitions);
+  result["medianSeconds"] = median(seconds);
+  result["minSeconds"] = *std::min_element(seconds.begin(), seconds.end());
+  result["peakRSS"] = peakRSS;
+  return result;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  QCoreApplication app(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      "Ripes command line startup benchmark. Reports the startup time and peak "
+      "RSS of the command line interface, started through the GUI and the "
+      "headless executables, as JSON.");
+  parser.addHelpOption();
+  parser.addOption(QCommandLineOption(
+      "repetitions", "Number of times each process is started.", "n", "20"));
+  parser.addOption(QCommandLineOption(
+      "output", "Output file. If not set, results are printed to stdout.",
+      "path"));
+  parser.process(app);
+
+  const unsigned repetitions =
+      std::max(1u, parser.value("repetitions").toUInt());
+
+  QJsonArray results;
+  for (const auto &scenario : scenarios()) {
+    for (const auto &exec : s_executables) {
+      auto result = benchmark(exec, scenario, repetitions);
+      std::cerr << exec.name.toStdString() << " "
+                << scenario.name.toStdString() << ": "
+                << result["medianSeconds"].toDouble() * 1000 << " ms, "
+                << static_cast<long long>(result["peakRSS"].toDouble()) / 1024
+                << " KiB" << std::endl;
+      results.append(result);
+    }
+  }
+
+  QJsonObject report;
+  report["results"] = results;
+  const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+  if (parser.isSet("output")) {
+    QFile out(parser.value("output"));
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      std::cerr << "ERROR: Failed to open output file" << std::endl;
+      return 1;
+    }
+    out.write(json);
+  } else {
+    std::cout << json.toStdString();
+  }
+  return 0;
+}
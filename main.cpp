@@ -4,7 +4,9 @@
 #include <QMessageBox>
 #include <QResource>
 #include <QTimer>
+#include <cstring>
 #include <iostream>
+#include <memory>
 
 #include "src/cli/clioptions.h"
 #include "src/cli/clirunner.h"
@@ -55,7 +57,21 @@ CommandLineParseResult parseCommandLine(QCommandLineParser &parser,
   }
 }
 
-int guiMode(QApplication &app) {
+/// Returns true if Ripes is started in CLI mode. This is determined ahead of
+/// parsing the command line, given that the command line parser requires an
+/// application instance, and CLI mode must not instantiate a QApplication.
+bool isCLIMode(int argc, char **argv) {
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--mode=cli") == 0)
+      return true;
+    if (std::strcmp(argv[i], "--mode") == 0 && i + 1 < argc &&
+        std::strcmp(argv[i + 1], "cli") == 0)
+      return true;
+  }
+  return false;
+}
+
+int guiMode() {
   Ripes::MainWindow m;
 
 #ifdef Q_OS_WASM
@@ -72,7 +88,7 @@ int guiMode(QApplication &app) {
   m.setWindowState(Qt::WindowMaximized);
   QTimer::singleShot(100, &m, [&m] { m.fitToView(); });
 
-  return app.exec();
+  return QApplication::exec();
 }
 
 int CLIMode(QCommandLineParser &parser, Ripes::CLIModeOptions &options) {
@@ -91,7 +107,13 @@ int main(int argc, char **argv) {
   Q_INIT_RESOURCE(layouts);
   Q_INIT_RESOURCE(fonts);
 
-  QApplication app(argc, argv);
+  // CLI mode runs without the widget stack; only the GUI requires a
+  // QApplication.
+  std::unique_ptr<QCoreApplication> app;
+  if (isCLIMode(argc, argv))
+    app = std::make_unique<QCoreApplication>(argc, argv);
+  else
+    app = std::make_unique<QApplication>(argc, argv);
   QCoreApplication::setApplicationName("Ripes");
 
   QCommandLineParser parser;
@@ -107,7 +129,11 @@ int main(int argc, char **argv) {
     parser.showHelp();
     return 0;
   case CommandLineGUI:
-    return guiMode(app);
+    if (!qobject_cast<QApplication *>(app.get())) {
+      std::cerr << "ERROR: Invalid mode" << std::endl;
+      return 1;
+    }
+    return guiMode();
   case CommandLineCLI:
     return CLIMode(parser, options);
   }
@@ -0,0 +1,50 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <iostream>
+
+#include "src/cli/clioptions.h"
+#include "src/cli/clirunner.h"
+
+// Entry point of the headless Ripes executable. This provides the command line
+// interface of Ripes ('Ripes --mode cli') without linking the Qt widget and
+// chart libraries, allowing for fast startup when scripting simulations.
+
+int main(int argc, char **argv) {
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("Ripes");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      "Ripes command line interface.\n"
+      "Assembles/compiles and executes a program on an arbitrary processor "
+      "model,\nand reports the resulting execution telemetry.");
+  // Accepted for compatibility with 'Ripes --mode cli'.
+  parser.addOption(
+      QCommandLineOption("mode", "Ripes mode [cli]", "mode", "cli"));
+  Ripes::CLIModeOptions options;
+  Ripes::addCLIOptions(parser, options);
+  const QCommandLineOption helpOption = parser.addHelpOption();
+
+  if (!parser.parse(QCoreApplication::arguments())) {
+    std::cerr << "ERROR: " << parser.errorText().toStdString() << std::endl;
+    parser.showHelp();
+    return 0;
+  }
+  if (parser.isSet(helpOption)) {
+    parser.showHelp();
+    return 0;
+  }
+  if (parser.value("mode") != "cli") {
+    std::cerr << "ERROR: Invalid mode: " << parser.value("mode").toStdString()
+              << std::endl;
+    return 1;
+  }
+
+  QString err;
+  if (!Ripes::parseCLIOptions(parser, err, options)) {
+    std::cerr << "ERROR: " << err.toStdString() << std::endl;
+    parser.showHelp();
+    return 0;
+  }
+  return Ripes::CLIRunner(options).run();
+}
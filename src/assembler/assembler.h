@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <numeric>
 #include <set>
+#include <unordered_set>
 #include <variant>
 
 #include "STLExtras.h"
@@ -22,10 +23,16 @@ namespace Ripes {
 namespace Assembler {
 
 /**
- * A macro for running an assembler pass with error handling
+ * A macro for running an assembler pass with error handling. If the assembler
+ * was aborted during the pass (through the 'abort' flag in scope), the
+ * (partial) pass result is discarded.
  */
 #define runPass(resName, resType, passFunction, ...)                           \
   auto passFunction##_res = passFunction(__VA_ARGS__);                         \
+  if (isAborted(abort)) {                                                      \
+    result.aborted = true;                                                     \
+    return result;                                                             \
+  }                                                                            \
   if (auto *errors = std::get_if<Errors>(&passFunction##_res)) {               \
     result.errors.insert(result.errors.end(), errors->begin(), errors->end()); \
     assert(result.errors.size() != 0);                                         \
@@ -90,7 +97,8 @@ public:
 
   AssembleResult
   assemble(const QStringList &programLines, const SymbolMap *symbols = nullptr,
-           const QString &sourceHash = QString()) const override {
+           const QString &sourceHash = QString(),
+           const std::atomic<bool> *abort = nullptr) const override {
     AssembleResult result;
 
     /// by default, emit to .text until otherwise specified
@@ -101,17 +109,17 @@ public:
     }
 
     /// Tokenize each source line and separate symbol from remainder of tokens
-    runPass(tokenizedLines, SourceProgram, pass0, programLines);
+    runPass(tokenizedLines, SourceProgram, pass0, programLines, abort);
 
     /// Pseudo instruction expansion
-    runPass(expandedLines, SourceProgram, pass1, tokenizedLines);
+    runPass(expandedLines, SourceProgram, pass1, tokenizedLines, abort);
 
     /** Assemble. During assembly, we generate:
      * - linkageMap: Recording offsets of instructions which require linkage
      * with symbols
      */
     LinkRequests needsLinkage;
-    runPass(program, Program, pass2, expandedLines, needsLinkage);
+    runPass(program, Program, pass2, expandedLines, needsLinkage, abort);
 
     // Symbol linkage
     runPass(unused, NoPassResult, pass3, program, needsLinkage);
@@ -225,6 +233,10 @@ protected:
     // Reference to the immediate field which resolves the symbol and the
     // requested symbol
     _FieldLinkRequest fieldRequest;
+
+    // The requested symbol expression, compiled when the link request is
+    // created and evaluated once all symbols have been defined.
+    CompiledExpr expr;
   };
 
   Reg_T linkReqAddress(const LinkRequest &req) const {
@@ -237,11 +249,13 @@ protected:
    * @brief pass0
    * Line tokenization and source line recording
    */
-  std::variant<Errors, SourceProgram> pass0(const QStringList &program) const {
+  std::variant<Errors, SourceProgram>
+  pass0(const QStringList &program, const std::atomic<bool> *abort) const {
     Errors errors;
     SourceProgram tokenizedLines;
     tokenizedLines.reserve(program.size());
-    Symbols symbols;
+    // All non-local symbols defined in the program, for duplicate detection.
+    std::unordered_set<Symbol> symbols;
 
     /** @brief carry
      * A symbol should refer to the next following assembler line; whether an
@@ -253,6 +267,8 @@ protected:
      */
     Symbols carry;
     for (auto line : llvm::enumerate(program)) {
+      if (isAborted(abort))
+        break;
       if (line.value().isEmpty())
         continue;
       TokenizedSrcLine tsl(line.index());
@@ -320,12 +336,15 @@ protected:
    * Pseudo-op expansion. If @return errors is empty, pass succeeded.
    */
   std::variant<Errors, SourceProgram>
-  pass1(const SourceProgram &tokenizedLines) const {
+  pass1(const SourceProgram &tokenizedLines,
+        const std::atomic<bool> *abort) const {
     Errors errors;
     SourceProgram expandedLines;
     expandedLines.reserve(tokenizedLines.size());
 
     for (auto tokenizedLine : llvm::enumerate(tokenizedLines)) {
+      if (isAborted(abort))
+        break;
       auto expandedOps = expandPseudoOp(tokenizedLine.value());
       if (expandedOps.isResult()) {
         /** @note: Original source line is kept for all resulting lines after
@@ -364,7 +383,8 @@ protected:
    * for symbol resolution.
    */
   std::variant<Errors, Program> pass2(const SourceProgram &tokenizedLines,
-                                      LinkRequests &needsLinkage) const {
+                                      LinkRequests &needsLinkage,
+                                      const std::atomic<bool> *abort) const {
     // Initialize program with initialized segments:
     Program program;
     for (const auto &iter : m_sectionBasePointers) {
@@ -380,6 +400,8 @@ protected:
 
     bool wasDirective;
     for (const auto &line : tokenizedLines) {
+      if (isAborted(abort))
+        break;
       // Get offset of currently emitting position in memory relative to section
       // position
       VInt addr_offset = currentSection->data.size();
@@ -409,10 +431,13 @@ protected:
         program.sourceMapping[addr_offset].insert(line.sourceLine());
 
         if (!machineCode.linksWithSymbol.symbol.isEmpty()) {
+          runOperation(linkExpr, compileExpression, line,
+                       machineCode.linksWithSymbol.symbol, m_symbolMap);
           LinkRequest req(line.sourceLine());
           req.offset = addr_offset;
           req.fieldRequest = machineCode.linksWithSymbol;
           req.section = m_currentSection;
+          req.expr = linkExpr;
           needsLinkage.push_back(req);
         }
 
@@ -444,11 +469,11 @@ protected:
 
     // Register address symbols in program struct.
     /// @todo: also consider relative symbols here.
-    for (const auto &iter : m_symbolMap.abs) {
-      if (iter.first.is(Symbol::Type::Address)) {
-        program.symbols[iter.second] = iter.first;
+    m_symbolMap.forEachAbsSymbol([&](const Symbol &symbol, VIntS value) {
+      if (symbol.is(Symbol::Type::Address)) {
+        program.symbols[value] = symbol;
       }
-    }
+    });
 
     return {program};
   }
@@ -457,17 +482,15 @@ protected:
   pass3(Program &program, const LinkRequests &needsLinkage) const {
     Errors errors;
     for (const LinkRequest &linkRequest : needsLinkage) {
-      const auto &symbol = linkRequest.fieldRequest.symbol;
       Reg_T symbolValue;
 
-      // Add the special __address__ symbol indicating the address of the
-      // instruction itself. Not done through addSymbol given that we redefine
-      // this symbol on each line.
+      // The special __address__ symbol of the expression evaluates to the
+      // address of the instruction itself.
       const Reg_T linkRequestAddress = linkReqAddress(linkRequest);
-      m_symbolMap.abs["__address__"] = linkRequestAddress;
 
       // Expression evaluation also performs symbol evaluation
-      auto exprRes = evalExpr(linkRequest, symbol);
+      auto exprRes = evaluate(linkRequest, linkRequest.expr, m_symbolMap,
+                              linkRequestAddress);
       if (auto *err = std::get_if<Error>(&exprRes)) {
         errors.push_back(*err);
         continue;
@@ -50,11 +50,13 @@ using Section = QString;
 
 /**
  * @brief The Result struct
- * An assembly result is determined to be valid iff errors is empty.
+ * An assembly result is determined to be valid iff errors is empty and the
+ * assembler was not aborted.
  */
 struct AssembleResult {
   Errors errors;
   Program program;
+  bool aborted = false;
 };
 
 struct DisassembleResult {
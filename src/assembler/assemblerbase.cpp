@@ -29,24 +29,22 @@ void AssemblerBase::setSegmentBase(Section seg, AInt base) {
   m_sectionBasePointers[seg] = base;
 }
 
-AssembleResult AssemblerBase::assembleRaw(const QString &program,
-                                          const SymbolMap *symbols) const {
+AssembleResult
+AssemblerBase::assembleRaw(const QString &program, const SymbolMap *symbols,
+                           const std::atomic<bool> *abort) const {
   const auto programLines = program.split(QRegularExpression("[\r\n]"));
   return assemble(programLines, symbols,
-                  Program::calculateHash(program.toUtf8()));
+                  Program::calculateHash(program.toUtf8()), abort);
 }
 
 /// Resolves an expression through either the built-in symbol map, or through
 /// the expression evaluator.
 ExprEvalRes AssemblerBase::evalExpr(const Location &location,
                                     const QString &expr) const {
-  auto relativeMap = m_symbolMap.copyRelativeTo(location.sourceLine());
-
-  auto symbolValue = relativeMap.find(expr);
-  if (symbolValue != relativeMap.end()) {
-    return symbolValue->second;
+  if (auto symbolValue = m_symbolMap.resolve(expr, location.sourceLine())) {
+    return symbolValue.value();
   } else {
-    return evaluate(location, expr, &relativeMap);
+    return evaluate(location, expr, &m_symbolMap);
   }
 }
 
@@ -2,6 +2,7 @@
 
 #include <QRegularExpression>
 
+#include <atomic>
 #include <optional>
 
 #include "assembler_defines.h"
@@ -36,12 +37,19 @@ public:
   /// a set of predefined symbols may be provided to the assemble call. If
   /// programLines does not represent the source program directly (possibly due
   /// to conversion of newline/cr/..., an explicit hash of the source program
-  /// can be provided for later identification.
+  /// can be provided for later identification. If @p abort is provided, the
+  /// assembler will periodically poll the flag and stop assembling as soon as
+  /// it is set, returning a result marked as aborted.
   virtual AssembleResult
   assemble(const QStringList &programLines, const SymbolMap *symbols = nullptr,
-           const QString &sourceHash = QString()) const = 0;
+           const QString &sourceHash = QString(),
+           const std::atomic<bool> *abort = nullptr) const = 0;
+  /// Assembles an input program provided as a single string. @p abort allows
+  /// for background assembly jobs to be cancelled once they have been
+  /// superseded (see assemble()).
   AssembleResult assembleRaw(const QString &program,
-                             const SymbolMap *symbols = nullptr) const;
+                             const SymbolMap *symbols = nullptr,
+                             const std::atomic<bool> *abort = nullptr) const;
 
   /// Disassembles an input program relative to the provided base address.
   virtual DisassembleResult disassemble(const Program &program,
@@ -102,6 +110,12 @@ protected:
   /// Returns the comment-delimiting character for this assembler.
   virtual QChar commentDelimiter() const = 0;
 
+  /// Returns true if an assemble call provided with the @p abort flag has been
+  /// requested to abort.
+  static bool isAborted(const std::atomic<bool> *abort) {
+    return abort && abort->load(std::memory_order_relaxed);
+  }
+
   /**
    * @brief m_sectionBasePointers maintains the base position for the segments
    * annoted by the Segment enum class.
@@ -56,18 +56,29 @@ public:
    * and intended to be immutable outside of the assembler.
    */
   const std::map<unsigned, QString> &toMap() const {
-    if (_mapcache.size() != size()) {
+    if (_mapcacheSize != size()) {
       _mapcache.clear();
-      std::map<unsigned, QString> m;
       for (const auto &iter : *this) {
         _mapcache[iter.sourceLine()] = iter.errorMessage();
       }
+      // Multiple errors may refer to the same source line; track the number
+      // of errors cached rather than the size of the cache.
+      _mapcacheSize = size();
     }
     return _mapcache;
   }
 
+  /// Returns the error message of source line @p line, or nullptr if no error
+  /// is reported for the line.
+  const QString *errorAt(unsigned line) const {
+    const auto &map = toMap();
+    auto it = map.find(line);
+    return it == map.end() ? nullptr : &it->second;
+  }
+
 private:
   mutable std::map<unsigned, QString> _mapcache;
+  mutable size_t _mapcacheSize = 0;
 };
 
 /// An Assembler Result structure is a variant which carries either an error
@@ -1,5 +1,8 @@
 #include "expreval.h"
 
+#include <QVarLengthArray>
+
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -230,42 +233,42 @@ ExprRes parseLeft(const Location &loc, const QString &s, int &pos, int &depth) {
   }
 }
 
-VIntS evaluate(const std::shared_ptr<Expr> &expr,
-               const AbsoluteSymbolMap *variables) {
+VIntS evaluate(const std::shared_ptr<Expr> &expr, const SymbolMap *symbols,
+               unsigned line) {
   // There is a bug in GCC for variant visitors on incomplete variant types
   // (recursive), So instead we'll macro our way towards something that looks
   // like a pattern match for the variant type.
   IfExpr(Add, v) {
-    return evaluate(v->lhs, variables) + evaluate(v->rhs, variables);
+    return evaluate(v->lhs, symbols, line) + evaluate(v->rhs, symbols, line);
   }
   FiExpr;
   IfExpr(Div, v) {
-    return evaluate(v->lhs, variables) / evaluate(v->rhs, variables);
+    return evaluate(v->lhs, symbols, line) / evaluate(v->rhs, symbols, line);
   }
   FiExpr;
   IfExpr(Mul, v) {
-    return evaluate(v->lhs, variables) * evaluate(v->rhs, variables);
+    return evaluate(v->lhs, symbols, line) * evaluate(v->rhs, symbols, line);
   }
   FiExpr;
   IfExpr(Sub, v) {
-    return evaluate(v->lhs, variables) - evaluate(v->rhs, variables);
+    return evaluate(v->lhs, symbols, line) - evaluate(v->rhs, symbols, line);
   }
   FiExpr;
   IfExpr(Mod, v) {
-    return evaluate(v->lhs, variables) % evaluate(v->rhs, variables);
+    return evaluate(v->lhs, symbols, line) % evaluate(v->rhs, symbols, line);
   }
   FiExpr;
   IfExpr(And, v) {
-    return evaluate(v->lhs, variables) & evaluate(v->rhs, variables);
+    return evaluate(v->lhs, symbols, line) & evaluate(v->rhs, symbols, line);
   }
   FiExpr;
   IfExpr(Or, v) {
-    return evaluate(v->lhs, variables) | evaluate(v->rhs, variables);
+    return evaluate(v->lhs, symbols, line) | evaluate(v->rhs, symbols, line);
   }
   FiExpr;
   IfExpr(SignExtend, v) {
-    return vsrtl::signextend(evaluate(v->lhs, variables),
-                             evaluate(v->rhs, variables));
+    return vsrtl::signextend(evaluate(v->lhs, symbols, line),
+                             evaluate(v->rhs, symbols, line));
   }
   FiExpr;
   IfExpr(Nothing, v) {
@@ -277,10 +280,9 @@ VIntS evaluate(const std::shared_ptr<Expr> &expr,
     bool ok = false;
     auto value = getImmediate(v->v, ok);
     if (!ok) {
-      if (variables != nullptr) {
-        auto it = variables->find(v->v);
-        if (it != variables->end()) {
-          value = it->second;
+      if (symbols != nullptr) {
+        if (auto symbolValue = symbols->resolve(v->v, line)) {
+          value = symbolValue.value();
           ok = true;
         }
       }
@@ -298,24 +300,182 @@ VIntS evaluate(const std::shared_ptr<Expr> &expr,
   Q_UNREACHABLE();
 }
 
-ExprEvalRes evaluate(const Location &loc, const QString &s,
-                     const AbsoluteSymbolMap *variables) {
+ExprRes parse(const Location &loc, const QString &s) {
   QString sNoWhitespace = s;
   sNoWhitespace.replace(" ", "");
   int pos = 0;
   int depth = 0;
-  auto exprTree = parseLeft(loc, sNoWhitespace, pos, depth);
+  return parseLeft(loc, sNoWhitespace, pos, depth);
+}
+
+ExprEvalRes evaluate(const Location &loc, const QString &s,
+                     const SymbolMap *symbols) {
+  auto exprTree = parse(loc, s);
   if (auto *err = std::get_if<Error>(&exprTree)) {
     return *err;
   }
   const auto exprTreeRes = std::get<std::shared_ptr<Expr>>(exprTree);
   try {
-    return {evaluate(exprTreeRes, variables)};
+    return {evaluate(exprTreeRes, symbols, loc.sourceLine())};
   } catch (const std::runtime_error &e) {
     return {Error(loc, e.what())};
   }
 }
 
+/// Appends the postfix bytecode of @p expr to @p compiled. @p depth is the
+/// evaluation stack depth prior to the appended code.
+void compile(const std::shared_ptr<Expr> &expr, CompiledExpr &compiled,
+             SymbolMap &symbols, unsigned &depth) {
+  using Op = CompiledExpr::Op;
+  auto emit = [&](Op op, ExprEvalVT value = 0) {
+    compiled.code.push_back({op, value});
+    if (op < Op::Add) {
+      compiled.maxDepth = std::max(compiled.maxDepth, ++depth);
+    } else {
+      --depth;
+    }
+  };
+
+#define CompileBinOp(TExpr)                                                    \
+  IfExpr(TExpr, v) {                                                           \
+    compile(v->lhs, compiled, symbols, depth);                                 \
+    compile(v->rhs, compiled, symbols, depth);                                 \
+    emit(Op::TExpr);                                                           \
+    return;                                                                    \
+  }                                                                            \
+  FiExpr;
+
+  CompileBinOp(Add);
+  CompileBinOp(Div);
+  CompileBinOp(Mul);
+  CompileBinOp(Sub);
+  CompileBinOp(Mod);
+  CompileBinOp(And);
+  CompileBinOp(Or);
+  CompileBinOp(SignExtend);
+#undef CompileBinOp
+
+  IfExpr(Nothing, v) {
+    Q_UNUSED(v);
+    emit(Op::Imm, 0);
+    return;
+  }
+  FiExpr;
+  IfExpr(Literal, v) {
+    bool ok = false;
+    const auto value = getImmediate(v->v, ok);
+    if (ok) {
+      emit(Op::Imm, value);
+    } else if (auto ref = SymbolMap::parseRelativeRef(v->v)) {
+      emit(ref->forward ? Op::RelSymbolAfter : Op::RelSymbolBefore,
+           ref->symbol);
+    } else if (v->v == QStringLiteral("__address__")) {
+      emit(Op::Address);
+    } else {
+      emit(Op::Symbol, symbols.intern(v->v));
+    }
+    return;
+  }
+  FiExpr;
+
+  Q_UNREACHABLE();
+}
+
+Result<CompiledExpr> compileExpression(const Location &loc, const QString &s,
+                                       SymbolMap &symbols) {
+  auto exprTree = parse(loc, s);
+  if (auto *err = std::get_if<Error>(&exprTree)) {
+    return *err;
+  }
+  CompiledExpr compiled;
+  unsigned depth = 0;
+  compile(std::get<std::shared_ptr<Expr>>(exprTree), compiled, symbols, depth);
+  return {compiled};
+}
+
+ExprEvalRes evaluate(const Location &loc, const CompiledExpr &expr,
+                     const SymbolMap &symbols, ExprEvalVT address) {
+  using Op = CompiledExpr::Op;
+  // Expressions are rarely deep enough for the stack to leave its inline
+  // storage.
+  QVarLengthArray<ExprEvalVT, 32> stack;
+  stack.reserve(expr.maxDepth);
+
+  for (const auto &instr : expr.code) {
+    switch (instr.op) {
+    case Op::Imm:
+      stack.append(instr.value);
+      continue;
+    case Op::Address:
+      stack.append(address);
+      continue;
+    case Op::Symbol: {
+      const auto value = symbols.value(instr.value);
+      if (!value.has_value()) {
+        return {Error(loc, QString("Unknown symbol '%1'")
+                               .arg(symbols.symbol(instr.value).v))};
+      }
+      stack.append(value.value());
+      continue;
+    }
+    case Op::RelSymbolBefore:
+    case Op::RelSymbolAfter: {
+      const bool forward = instr.op == Op::RelSymbolAfter;
+      const auto value = symbols.resolve(
+          SymbolMap::RelativeRef{static_cast<SymbolMap::RelativeSymbol>(
+                                     instr.value),
+                                 forward},
+          loc.sourceLine());
+      if (!value.has_value()) {
+        return {Error(loc, QString("Unknown symbol '%1%2'")
+                               .arg(instr.value)
+                               .arg(forward ? 'f' : 'b'))};
+      }
+      stack.append(value.value());
+      continue;
+    }
+    default:
+      break;
+    }
+
+    // Binary operator
+    const ExprEvalVT rhs = stack.takeLast();
+    ExprEvalVT &lhs = stack.last();
+    switch (instr.op) {
+    case Op::Add:
+      lhs += rhs;
+      break;
+    case Op::Sub:
+      lhs -= rhs;
+      break;
+    case Op::Mul:
+      lhs *= rhs;
+      break;
+    case Op::Div:
+    case Op::Mod:
+      if (rhs == 0) {
+        return {Error(loc, "Division by zero in expression")};
+      }
+      lhs = instr.op == Op::Div ? lhs / rhs : lhs % rhs;
+      break;
+    case Op::And:
+      lhs &= rhs;
+      break;
+    case Op::Or:
+      lhs |= rhs;
+      break;
+    case Op::SignExtend:
+      lhs = vsrtl::signextend(lhs, rhs);
+      break;
+    default:
+      Q_UNREACHABLE();
+    }
+  }
+
+  assert(stack.size() == 1 && "Malformed compiled expression");
+  return {stack.last()};
+}
+
 bool couldBeExpression(const QString &s) {
   return std::any_of(s_exprTokens.begin(), s_exprTokens.end(),
                      [&s](const auto &ch) { return s.contains(ch); });
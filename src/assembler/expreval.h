@@ -5,6 +5,7 @@
 #include "symbolmap.h"
 #include <QRegularExpression>
 #include <variant>
+#include <vector>
 
 namespace Ripes {
 namespace Assembler {
@@ -22,9 +23,64 @@ using ExprEvalRes = Result<ExprEvalVT>;
  * implemented - to ensure precedence, parentheses must be implemented. The
  * functionality is mainly intended to be used by the assembler to expand
  * complex pseudoinstructions and as such not by the user.
+ * Symbols within the expression are resolved through @p symbols, relative to
+ * the source line of the provided location.
  */
 ExprEvalRes evaluate(const Location &, const QString &,
-                     const AbsoluteSymbolMap *variables = nullptr);
+                     const SymbolMap *symbols = nullptr);
+
+/**
+ * @brief The CompiledExpr struct
+ * An expression compiled to flat postfix bytecode. Symbols are referenced by
+ * their ID within a SymbolMap rather than by name, such that an expression may
+ * be parsed once, before all of its symbols are defined, and then evaluated
+ * without any string processing or allocation.
+ */
+struct CompiledExpr {
+  enum class Op : uint8_t {
+    // Operand pushing operations
+    Imm,             // value: immediate
+    Symbol,          // value: SymbolID of an absolute symbol
+    RelSymbolBefore, // value: relative symbol number
+    RelSymbolAfter,  // value: relative symbol number
+    Address,         // the __address__ symbol, provided at evaluation
+    // Binary operators, popping two operands and pushing the result
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Mod,
+    And,
+    Or,
+    SignExtend
+  };
+  struct Instr {
+    Op op;
+    ExprEvalVT value;
+  };
+
+  std::vector<Instr> code;
+  // Maximum evaluation stack depth of the expression.
+  unsigned maxDepth = 0;
+};
+
+/**
+ * @brief compileExpression
+ * Parses the expression @p s into a CompiledExpr. Symbols within the
+ * expression are interned into @p symbols, but need not be defined until
+ * evaluation.
+ */
+Result<CompiledExpr> compileExpression(const Location &, const QString &s,
+                                       SymbolMap &symbols);
+
+/**
+ * @brief evaluate
+ * Evaluates the compiled expression @p expr using the symbol values of
+ * @p symbols, relative to the source line of the provided location. @p address
+ * is the value of the __address__ symbol.
+ */
+ExprEvalRes evaluate(const Location &, const CompiledExpr &expr,
+                     const SymbolMap &symbols, ExprEvalVT address = 0);
 
 /**
  * @brief couldBeExpression
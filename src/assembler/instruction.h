@@ -365,8 +365,8 @@ struct Imm : public Field<Reg_T> {
       const int value = vsrtl::signextend(reconstructed, width);
       const Reg_T symbolAddress =
           value + (symbolType == SymbolType::Absolute ? 0 : address);
-      if (symbolMap.count(symbolAddress)) {
-        line.push_back("<" + symbolMap.at(symbolAddress).v + ">");
+      if (auto it = symbolMap.find(symbolAddress); it != symbolMap.end()) {
+        line.push_back("<" + it->second.v + ">");
       }
     }
 
@@ -1,152 +1,148 @@
 #include "objdump.h"
 
 #include "../processorhandler.h"
-#include <QDataStream>
+
+#include <algorithm>
+#include <climits>
 
 namespace Ripes {
 namespace Assembler {
 
-static void incrementAddressOffsetMap(const QString &text, AddrOffsetMap &map,
-                                      int &offsets,
-                                      const QString &symbol = QString()) {
-  map[text.count('\n')] = {offsets++, symbol};
+static const QString s_indent = "    ";
+
+ObjdumpListing::ObjdumpListing(const std::shared_ptr<const Program> &program,
+                               Format format)
+    : m_program(program), m_format(format) {
+  if (!m_program)
+    return;
+  m_textSection = m_program->getSection(TEXT_SECTION_NAME);
+  if (!m_textSection)
+    return;
+
+  m_assembler = ProcessorHandler::getAssembler();
+  m_regBytes = ProcessorHandler::currentISA()->bytes();
+  m_instrBytes = ProcessorHandler::currentISA()->instrBytes();
+
+  // Number of non-instruction lines emitted so far.
+  unsigned infoOffsets = 0;
+  auto addInfoLine = [&](Line::Kind kind, AInt address,
+                         const QString &symbol = QString()) {
+    m_addrOffsetMap.emplace_hint(m_addrOffsetMap.end(), m_lines.size(),
+                                 std::make_pair(infoOffsets++, symbol));
+    m_lines.push_back({kind, 0, address});
+  };
+
+  const AInt end = m_textSection->address + m_textSection->data.length();
+  for (AInt addr = m_textSection->address; addr < end;) {
+    // symbol label
+    if (auto symbolIt = m_program->symbols.find(addr);
+        symbolIt != m_program->symbols.end()) {
+      // We are adding non-instruction lines to the listing. Record the line
+      // number as well as the sum of invalid lines up to the given point.
+      addInfoLine(Line::Blank, addr);
+      addInfoLine(Line::Label, addr, symbolIt->second.v);
+    }
+
+    // The instruction is disassembled to determine its size. Its text is
+    // rendered once the line is requested.
+    const auto disres =
+        m_assembler->disassemble(readWord(addr), m_program->symbols, addr);
+    m_lines.push_back(
+        {Line::Instruction, static_cast<uint8_t>(disres.bytesDisassembled),
+         addr});
+
+    if (disres.err.has_value() || disres.bytesDisassembled == 0) {
+      // Error during disassembled; we'll just have to increment the address
+      // counter by the default instruction size of the ISA.
+      addr += m_instrBytes;
+    } else
+      addr += disres.bytesDisassembled;
+  }
 }
 
-/**
- * Stringifer
- * A stringifier is a function that takes a vector of bytes (representing an
- * instruction word) alongside a base address, and returns a string
- * representation of the data.
- */
-using Stringifier =
-    std::function<OpDisassembleResult(const std::vector<char> &, AInt)>;
-
-QString stringifyProgram(std::weak_ptr<const Program> program,
-                         Stringifier stringifier,
-                         AddrOffsetMap &addrOffsetMap) {
-  if (auto sp = program.lock()) {
-    const auto *textSection = sp->getSection(TEXT_SECTION_NAME);
-    if (!textSection)
-      return QString();
-
-    QString out;
-    auto dataStream = QDataStream(textSection->data);
-    std::vector<char> buffer;
-    const unsigned regBytes = ProcessorHandler::currentISA()->bytes();
-    const unsigned instrBytes = ProcessorHandler::currentISA()->instrBytes();
-
-    int infoOffsets = 0;
-    const QString indent = "    ";
-
-    AInt addr = textSection->address;
-    while (addr < textSection->address + textSection->data.length()) {
-      /// Ensure that we always have sizeof(Instr_T) bytes in the buffer, even
-      /// though some of these bytes may be invalid (due to reading past the end
-      /// of stream). For the end-of-program edge,case, the while loop will exit
-      /// before we start decoding invalid data.
-      size_t curBufSize = buffer.size();
-      if (curBufSize < sizeof(Instr_T)) {
-        buffer.resize(sizeof(Instr_T));
-        dataStream.readRawData(buffer.data() + curBufSize,
-                               sizeof(Instr_T) - curBufSize);
-      }
-
-      // symbol label
-      if (sp->symbols.count(addr)) {
-        const auto &symbol = sp->symbols.at(addr);
-        // We are adding non-instruction lines to the output string. Record the
-        // line number as well as the sum of invalid lines up to the given
-        // point.
-        incrementAddressOffsetMap(out, addrOffsetMap, infoOffsets);
-        out += "\n";
-        incrementAddressOffsetMap(out, addrOffsetMap, infoOffsets, symbol.v);
-        out += QString::number(addr, 16).rightJustified(regBytes * 2, '0') +
-               " <" + symbol.v + ">:\n";
-      }
-
-      // Instruction address
-      out += indent + QString::number(addr, 16) + ":" + indent + indent;
-
-      // Stringified instruction
-      auto disres = stringifier(buffer, addr);
-      if (disres.err.has_value()) {
-        // Error during disassembled; we'll just have to increment the address
-        // counter by the default instruction size of the ISA. std::min with
-        // buffer size in the edge case that we're erroring on a single
-        // instruction which is smaller than the default instruction width.
-        addr += std::min(static_cast<unsigned>(buffer.size()), instrBytes);
-      } else
-        addr += disres.bytesDisassembled;
-      assert(buffer.size() >= disres.bytesDisassembled);
-
-      // Instruction word
-      QString wordString;
-      for (size_t i = 0; i < disres.bytesDisassembled; ++i) {
-        auto it = buffer.begin();
-        wordString.prepend(QString()
-                               .setNum(static_cast<uint8_t>(*it), 16)
-                               .rightJustified(2, '0'));
-        buffer.erase(it);
-      }
-
-      out += wordString + indent + indent;
-
-      // Pad if < default instruction width to align disassembled instruction
-      // with default instruction width column
-      int dBytes = instrBytes - disres.bytesDisassembled;
-      while (dBytes > 0) {
-        out += indent;
-        dBytes -= indent.size() / 2;
-      }
-
-      out += disres.repr + "\n";
+VInt ObjdumpListing::readWord(AInt address) const {
+  const AInt offset = address - m_textSection->address;
+  const AInt available = m_textSection->data.length() - offset;
+  const unsigned bytes =
+      std::min(static_cast<AInt>(m_instrBytes), std::min(available, AInt(8)));
+  VInt word = 0;
+  for (unsigned i = 0; i < bytes; ++i) {
+    word |= static_cast<VInt>(
+                static_cast<uint8_t>(m_textSection->data.at(offset + i)))
+            << (CHAR_BIT * i);
+  }
+  return word;
+}
+
+QString ObjdumpListing::line(unsigned index) const {
+  const Line &entry = m_lines.at(index);
+  switch (entry.kind) {
+  case Line::Blank:
+    return QString();
+  case Line::Label:
+    return QString::number(entry.address, 16)
+               .rightJustified(m_regBytes * 2, '0') +
+           " <" + m_addrOffsetMap.at(index).second + ">:";
+  case Line::Instruction:
+    break;
+  }
+
+  const VInt word = readWord(entry.address);
+
+  // Instruction address
+  QString out =
+      s_indent + QString::number(entry.address, 16) + ":" + s_indent + s_indent;
+
+  // Instruction word
+  for (int i = entry.bytes - 1; i >= 0; --i) {
+    out += QString::number((word >> (CHAR_BIT * i)) & 0xFF, 16)
+               .rightJustified(2, '0');
+  }
+  out += s_indent + s_indent;
+
+  // Pad if < default instruction width to align disassembled instruction
+  // with default instruction width column
+  int dBytes = m_instrBytes - entry.bytes;
+  while (dBytes > 0) {
+    out += s_indent;
+    dBytes -= s_indent.size() / 2;
+  }
+
+  if (m_format == Format::Binary) {
+    // Emit the byte representation of the instruction.
+    for (int i = entry.bytes - 1; i >= 0; --i) {
+      out += QString::number((word >> (CHAR_BIT * i)) & 0xFF, 2)
+                 .rightJustified(8, '0');
     }
-    return out;
+  } else {
+    out += m_assembler->disassemble(word, m_program->symbols, entry.address)
+               .repr;
+  }
+  return out;
+}
+
+QString ObjdumpListing::text(unsigned first, unsigned last) const {
+  QString out;
+  last = std::min(last, lineCount());
+  for (unsigned i = first; i < last; ++i) {
+    out += line(i);
+    out += '\n';
   }
-  return QString();
+  return out;
 }
 
 QString objdump(const std::shared_ptr<const Program> &program,
                 AddrOffsetMap &addrOffsetMap) {
-  auto assembler = ProcessorHandler::getAssembler();
-  const unsigned instrBytes = ProcessorHandler::currentISA()->instrBytes();
-  return stringifyProgram(
-      program,
-      [&program, &assembler, instrBytes](const std::vector<char> &buffer,
-                                         AInt address) {
-        VInt instr = 0;
-        for (unsigned i = 0; i < instrBytes; ++i) {
-          instr |= (buffer[i] & 0xFF) << (CHAR_BIT * i);
-        }
-        return assembler->disassemble(instr, program->symbols, address);
-      },
-      addrOffsetMap);
+  ObjdumpListing listing(program, ObjdumpListing::Format::Disassembly);
+  addrOffsetMap = listing.addrOffsetMap();
+  return listing.text();
 }
 
 QString binobjdump(const std::shared_ptr<const Program> &program,
                    AddrOffsetMap &addrOffsetMap) {
-  auto assembler = ProcessorHandler::getAssembler();
-  const unsigned instrBytes = ProcessorHandler::currentISA()->instrBytes();
-  return stringifyProgram(
-      program,
-      [&program, &assembler, instrBytes](const std::vector<char> &buffer,
-                                         AInt address) {
-        /// Use disassembler to determine # of bytes disassembled, and then emit
-        /// the byte representation.
-        VInt instr = 0;
-        for (unsigned i = 0; i < instrBytes; ++i) {
-          instr |= (buffer[i] & 0xFF) << (CHAR_BIT * i);
-        }
-        auto disRes = assembler->disassemble(instr, program->symbols, address);
-        disRes.repr.clear();
-        for (size_t i = 0; i < disRes.bytesDisassembled; ++i) {
-          disRes.repr.prepend(QString()
-                                  .setNum(static_cast<uint8_t>(buffer[i]), 2)
-                                  .rightJustified(8, '0'));
-        }
-        return disRes;
-      },
-      addrOffsetMap);
+  ObjdumpListing listing(program, ObjdumpListing::Format::Binary);
+  addrOffsetMap = listing.addrOffsetMap();
+  return listing.text();
 }
 
 } // namespace Assembler
@@ -6,6 +6,7 @@
 #include <QString>
 
 #include <memory>
+#include <vector>
 
 namespace Ripes {
 namespace Assembler {
@@ -23,6 +24,58 @@ namespace Assembler {
  */
 using AddrOffsetMap = std::map<unsigned, std::pair<unsigned, QString>>;
 
+class AssemblerBase;
+
+/**
+ * @brief The ObjdumpListing class
+ * Line-oriented model of the objdump view of the text section of a program.
+ * Constructing a listing lays out the view in a single linear pass, recording
+ * the kind and address of each line alongside the AddrOffsetMap of the view.
+ * The text of a line is only rendered when requested, such that a view may
+ * render just the lines which are visible.
+ */
+class ObjdumpListing {
+public:
+  enum class Format { Disassembly, Binary };
+
+  ObjdumpListing() = default;
+  ObjdumpListing(const std::shared_ptr<const Program> &program, Format format);
+
+  unsigned lineCount() const { return m_lines.size(); }
+
+  /// Renders the text of line @p index, excluding the line terminator.
+  QString line(unsigned index) const;
+
+  /// Renders lines [@p first, @p last), each terminated by a newline.
+  QString text(unsigned first, unsigned last) const;
+  QString text() const { return text(0, lineCount()); }
+
+  const AddrOffsetMap &addrOffsetMap() const { return m_addrOffsetMap; }
+
+private:
+  struct Line {
+    enum Kind : uint8_t { Blank, Label, Instruction };
+    Kind kind;
+    // Number of bytes disassembled for instruction lines.
+    uint8_t bytes;
+    AInt address;
+  };
+
+  /// Returns the instruction word at @p address. Bytes beyond the end of the
+  /// text section are read as zero.
+  VInt readWord(AInt address) const;
+
+  std::shared_ptr<const Program> m_program;
+  std::shared_ptr<AssemblerBase> m_assembler;
+  const ProgramSection *m_textSection = nullptr;
+  Format m_format = Format::Disassembly;
+  unsigned m_regBytes = 0;
+  unsigned m_instrBytes = 0;
+
+  std::vector<Line> m_lines;
+  AddrOffsetMap m_addrOffsetMap;
+};
+
 QString objdump(const std::shared_ptr<const Program> &program,
                 AddrOffsetMap &addrOffsetMap);
 QString binobjdump(const std::shared_ptr<const Program> &program,
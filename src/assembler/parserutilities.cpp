@@ -169,7 +169,7 @@ Result<QStringList> tokenizeQuotes(const Location &location,
         escape = false;
       substr.push_back(ch);
     } else {
-      if (ch == ' ' || ch == ',' || ch == '\t') {
+      if (isTokenSeparator(ch)) {
         if (!substr.isEmpty())
           pushSubstr();
       } else
@@ -187,5 +187,60 @@ Result<QStringList> tokenizeQuotes(const Location &location,
   return {tokens};
 }
 
+static bool isWordChar(QChar ch) {
+  return ch.isLetterOrNumber() || ch == '_' || ch == '.' || ch == '$';
+}
+
+void lexLine(QStringView line, QChar commentDelimiter,
+             std::vector<LexedToken> &tokens) {
+  tokens.clear();
+  const int n = line.size();
+  int i = 0;
+  while (i < n) {
+    const QChar ch = line.at(i);
+    const int start = i;
+    auto push = [&](TokenClass tokenClass) {
+      tokens.push_back({tokenClass, start, i - start});
+    };
+
+    if (isTokenSeparator(ch) || ch.isSpace()) {
+      ++i;
+    } else if (ch == commentDelimiter) {
+      i = n;
+      push(TokenClass::Comment);
+    } else if (ch == '"') {
+      bool escape = false;
+      for (++i; i < n; ++i) {
+        if (escape) {
+          escape = false;
+        } else if (line.at(i) == '\\') {
+          escape = true;
+        } else if (line.at(i) == '"') {
+          ++i;
+          break;
+        }
+      }
+      push(TokenClass::String);
+    } else if (isWordChar(ch) ||
+               ((ch == '-' || ch == '+') && i + 1 < n &&
+                line.at(i + 1).isDigit() &&
+                (i == 0 || !isWordChar(line.at(i - 1))))) {
+      // Words; identifiers, labels and (possibly signed) immediates.
+      const bool immediate = ch.isDigit() || ch == '-' || ch == '+';
+      for (++i; i < n && isWordChar(line.at(i)); ++i)
+        ;
+      if (i < n && line.at(i) == ':') {
+        ++i;
+        push(TokenClass::Label);
+      } else {
+        push(immediate ? TokenClass::Immediate : TokenClass::Identifier);
+      }
+    } else {
+      ++i;
+      push(TokenClass::Punctuation);
+    }
+  }
+}
+
 } // namespace Assembler
 } // namespace Ripes
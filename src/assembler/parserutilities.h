@@ -1,7 +1,9 @@
 #pragma once
 
 #include <QStringList>
+#include <QStringView>
 #include <variant>
+#include <vector>
 
 #include "assembler_defines.h"
 #include "assemblererror.h"
@@ -32,5 +34,37 @@ Result<LineTokens> joinParentheses(const Location &location,
 /// Quote-aware string tokenization.
 Result<QStringList> tokenizeQuotes(const Location &location,
                                    const QString &line);
+
+/// Returns true if @p ch separates the tokens of a source line.
+inline bool isTokenSeparator(QChar ch) {
+  return ch == ' ' || ch == ',' || ch == '\t';
+}
+
+/// Lexical classes of the tokens of a source line.
+enum class TokenClass {
+  Identifier,
+  Label,
+  Immediate,
+  String,
+  Comment,
+  Punctuation
+};
+
+/// A lexed token; a class and the range of the source line it spans.
+struct LexedToken {
+  TokenClass tokenClass;
+  int start;
+  int length;
+};
+
+/**
+ * @brief lexLine performs a single pass over a source line, splitting it into
+ * classified tokens. Tokens are separated and quoted as in tokenizeQuotes.
+ * Unlike tokenizeQuotes, lexing never fails; unterminated strings extend to
+ * the end of the line. @p tokens is cleared before lexing, such that its
+ * storage may be reused between lines.
+ */
+void lexLine(QStringView line, QChar commentDelimiter,
+             std::vector<LexedToken> &tokens);
 } // namespace Assembler
 } // namespace Ripes
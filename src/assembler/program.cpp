@@ -1,5 +1,8 @@
 #include "program.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "processorhandler.h"
 
 namespace Ripes {
@@ -98,6 +101,33 @@ const DisassembledProgram &Program::getDisassembled() const {
   return disassembled;
 }
 
+SourceLineIndex::SourceLineIndex(
+    const std::map<VInt, std::set<unsigned>> &mapping) {
+  m_entries.reserve(mapping.size());
+  for (const auto &[address, lines] : mapping) {
+    m_entries.push_back({address, static_cast<unsigned>(m_lines.size())});
+    m_lines.insert(m_lines.end(), lines.begin(), lines.end());
+  }
+}
+
+SourceLineIndex::Lines SourceLineIndex::lines(VInt address) const {
+  auto it = std::lower_bound(
+      m_entries.begin(), m_entries.end(), address,
+      [](const Entry &entry, VInt addr) { return entry.address < addr; });
+  if (it == m_entries.end() || it->address != address)
+    return {};
+  const unsigned last = std::next(it) == m_entries.end()
+                            ? m_lines.size()
+                            : std::next(it)->firstLine;
+  return {m_lines.data() + it->firstLine, m_lines.data() + last};
+}
+
+const SourceLineIndex &Program::getSourceLineIndex() const {
+  if (!sourceLineIndex.has_value())
+    sourceLineIndex.emplace(sourceMapping);
+  return sourceLineIndex.value();
+}
+
 QString Program::calculateHash(const QByteArray &data) {
   return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
 }
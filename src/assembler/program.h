@@ -5,8 +5,10 @@
 #include <QMap>
 #include <QMetaType>
 #include <QString>
+#include <map>
 #include <optional>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "ripes_types.h"
@@ -65,7 +67,9 @@ public:
   unsigned type = 0;
 };
 
-using ReverseSymbolMap = std::map<AInt, Symbol>;
+/// Mapping of [address : symbol], used for symbol resolution during
+/// disassembly.
+using ReverseSymbolMap = std::unordered_map<AInt, Symbol>;
 
 struct LoadFileParams {
   QString filepath;
@@ -113,6 +117,43 @@ private:
   std::map<VInt, unsigned> addressToIndexMap;
 };
 
+/**
+ * @brief The SourceLineIndex class
+ * A compact index of [instruction address : source lines], built from a
+ * program source mapping. Entries are stored contiguously and sorted by
+ * address, such that a lookup is a binary search without any allocations.
+ */
+class SourceLineIndex {
+public:
+  /// A range of source lines.
+  struct Lines {
+    const unsigned *first = nullptr;
+    const unsigned *last = nullptr;
+    const unsigned *begin() const { return first; }
+    const unsigned *end() const { return last; }
+    bool empty() const { return first == last; }
+  };
+
+  SourceLineIndex() = default;
+  explicit SourceLineIndex(const std::map<VInt, std::set<unsigned>> &mapping);
+
+  bool empty() const { return m_entries.empty(); }
+
+  /// Returns the source lines which the instruction at @p address originated
+  /// from. The range is empty if no source lines were recorded.
+  Lines lines(VInt address) const;
+
+private:
+  struct Entry {
+    VInt address;
+    // Index of the first source line of this entry in m_lines. The lines of an
+    // entry extend to the first line of the next entry.
+    unsigned firstLine;
+  };
+  std::vector<Entry> m_entries;
+  std::vector<unsigned> m_lines;
+};
+
 /**
  * @brief The Program struct
  * Wrapper around a program to be loaded into simulator memory. Text section
@@ -143,7 +184,10 @@ public:
   /// Returns the disassembled version of this program. The result is an ordered
   /// map of [instruction address : disassembled instruction]
   const DisassembledProgram &getDisassembled() const;
-  const SourceMapping &getSourceMapping() const;
+
+  /// Returns a compact index of the source mapping of this program. The index
+  /// is built on first use and shared by all users of the program.
+  const SourceLineIndex &getSourceLineIndex() const;
 
   /// Calculates a hash used for source identification.
   static QString calculateHash(const QByteArray &data);
@@ -151,8 +195,19 @@ public:
 private:
   /// A caching of the disassembled version of this program.
   mutable DisassembledProgram disassembled;
+  /// A caching of the indexed source mapping of this program.
+  mutable std::optional<SourceLineIndex> sourceLineIndex;
 };
 
 } // namespace Ripes
 
+namespace std {
+template <>
+struct hash<Ripes::Symbol> {
+  size_t operator()(const Ripes::Symbol &s) const noexcept {
+    return qHash(s.v);
+  }
+};
+} // namespace std
+
 Q_DECLARE_METATYPE(Ripes::SourceType);
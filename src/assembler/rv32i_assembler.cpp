@@ -13,7 +13,8 @@
 namespace Ripes {
 namespace Assembler {
 
-RV32I_Assembler::RV32I_Assembler(const ISAInfo<ISA::RV32I> *isa)
+RV32I_Assembler::RV32I_Assembler(const ISAInfo<ISA::RV32I> *isa,
+                                 bool detached)
     : Assembler<Reg_T>(isa) {
   auto [instrs, pseudos] = initInstructions(isa);
 
@@ -21,6 +22,21 @@ RV32I_Assembler::RV32I_Assembler(const ISAInfo<ISA::RV32I> *isa)
   auto relocations = rvRelocations<Reg_T>();
   initialize(instrs, pseudos, directives, relocations);
 
+  // A detached assembler only takes a snapshot of the segment pointer
+  // settings, given that it may be used outside of the GUI thread.
+  if (detached) {
+    setSegmentBase(
+        ".text",
+        RipesSettings::value(RIPES_SETTING_ASSEMBLER_TEXTSTART).toULongLong());
+    setSegmentBase(
+        ".data",
+        RipesSettings::value(RIPES_SETTING_ASSEMBLER_DATASTART).toULongLong());
+    setSegmentBase(
+        ".bss",
+        RipesSettings::value(RIPES_SETTING_ASSEMBLER_BSSSTART).toULongLong());
+    return;
+  }
+
   // Initialize segment pointers and monitor settings changes to segment
   // pointers
   connect(RipesSettings::getObserver(RIPES_SETTING_ASSEMBLER_TEXTSTART),
@@ -14,7 +14,9 @@ class RV32I_Assembler : public QObject, public Assembler<uint32_t> {
 
 public:
   using Reg_T = uint32_t;
-  RV32I_Assembler(const ISAInfo<ISA::RV32I> *isa);
+  /// If @p detached, the assembler does not follow changes to the segment
+  /// pointer settings after construction.
+  RV32I_Assembler(const ISAInfo<ISA::RV32I> *isa, bool detached = false);
 
 private:
   std::tuple<_InstrVec, _PseudoInstrVec>
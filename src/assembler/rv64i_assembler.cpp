@@ -15,7 +15,8 @@
 namespace Ripes {
 namespace Assembler {
 
-RV64I_Assembler::RV64I_Assembler(const ISAInfo<ISA::RV64I> *isa)
+RV64I_Assembler::RV64I_Assembler(const ISAInfo<ISA::RV64I> *isa,
+                                 bool detached)
     : Assembler<Reg_T>(isa) {
   auto [instrs, pseudos] = initInstructions(isa);
 
@@ -23,6 +24,21 @@ RV64I_Assembler::RV64I_Assembler(const ISAInfo<ISA::RV64I> *isa)
   auto relocations = rvRelocations<Reg_T>();
   initialize(instrs, pseudos, directives, relocations);
 
+  // A detached assembler only takes a snapshot of the segment pointer
+  // settings, given that it may be used outside of the GUI thread.
+  if (detached) {
+    setSegmentBase(
+        ".text",
+        RipesSettings::value(RIPES_SETTING_ASSEMBLER_TEXTSTART).toULongLong());
+    setSegmentBase(
+        ".data",
+        RipesSettings::value(RIPES_SETTING_ASSEMBLER_DATASTART).toULongLong());
+    setSegmentBase(
+        ".bss",
+        RipesSettings::value(RIPES_SETTING_ASSEMBLER_BSSSTART).toULongLong());
+    return;
+  }
+
   // Initialize segment pointers and monitor settings changes to segment
   // pointers
   connect(RipesSettings::getObserver(RIPES_SETTING_ASSEMBLER_TEXTSTART),
@@ -13,7 +13,9 @@ class RV64I_Assembler : public QObject, public Assembler<uint64_t> {
   using Reg_T = uint64_t;
 
 public:
-  RV64I_Assembler(const ISAInfo<ISA::RV64I> *isa);
+  /// If @p detached, the assembler does not follow changes to the segment
+  /// pointer settings after construction.
+  RV64I_Assembler(const ISAInfo<ISA::RV64I> *isa, bool detached = false);
 
 private:
   std::tuple<_InstrVec, _PseudoInstrVec>
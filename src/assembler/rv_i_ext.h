@@ -183,12 +183,11 @@ struct RV_I {
           int64_t immediate = getImmediateSext32(line.tokens.at(2), canConvert);
 
           if (!canConvert) {
-            auto absSymbols = symbols.copyRelativeTo(line.sourceLine());
             // Check if the immediate has been made available in the symbol set
             // at this point...
-            auto it = absSymbols.find(line.tokens.at(2));
-            if (it != absSymbols.end()) {
-              immediate = it->second;
+            if (auto symbolValue =
+                    symbols.resolve(line.tokens.at(2), line.sourceLine())) {
+              immediate = symbolValue.value();
             } else {
               if (unsignedFitErr) {
                 return Result<std::vector<LineTokens>>{
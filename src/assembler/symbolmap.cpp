@@ -1,22 +1,38 @@
 #include "symbolmap.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace Ripes {
 namespace Assembler {
 
+SymbolID SymbolMap::intern(const Symbol &s) {
+  auto [it, inserted] = m_ids.try_emplace(s, m_symbols.size());
+  if (inserted) {
+    m_symbols.push_back(s);
+    m_values.push_back(std::nullopt);
+  }
+  return it->second;
+}
+
 /// Adds a symbol to the current symbol mapping of this assembler.
 std::optional<Error> SymbolMap::addAbsSymbol(const unsigned &line,
                                              const Symbol &s, VInt v) {
-  if (abs.count(s)) {
+  const SymbolID id = intern(s);
+  if (m_values[id].has_value()) {
     return {Error(line, "Multiple definitions of symbol '" + s.v + "'")};
   }
-  abs[s] = v;
+  // The symbol may have been interned through a reference; retain the type of
+  // its definition.
+  m_symbols[id] = s;
+  m_values[id] = v;
   return {};
 }
 
 std::optional<Error> SymbolMap::addRelSymbol(const unsigned &line,
                                              const Symbol &s, VInt v) {
   assert(s.isLocal());
-  auto &it = rel[s.v.toInt()];
+  auto &it = m_rel[s.v.toInt()];
   if (it.count(line))
     return {Error(line, QString::fromStdString(
                             "Multiple definitions of relative symbol '" +
@@ -26,24 +42,53 @@ std::optional<Error> SymbolMap::addRelSymbol(const unsigned &line,
   return {};
 }
 
-AbsoluteSymbolMap SymbolMap::copyRelativeTo(unsigned line,
-                                            const QString &beforeSuffix,
-                                            const QString &afterSuffix) const {
-  AbsoluteSymbolMap res = abs;
-
-  for (auto &relSymbols : rel) {
-    auto ub = relSymbols.second.upper_bound(line);
-    if (ub != relSymbols.second.end())
-      res[QString::number(relSymbols.first) + afterSuffix] = ub->second;
+std::optional<SymbolMap::RelativeRef>
+SymbolMap::parseRelativeRef(const QString &name, QChar beforeSuffix,
+                            QChar afterSuffix) {
+  // A relative symbol reference is a decimal number (without leading zeros)
+  // followed by a direction suffix.
+  if (name.size() < 2)
+    return std::nullopt;
+  const QChar suffix = name.back();
+  if (suffix != beforeSuffix && suffix != afterSuffix)
+    return std::nullopt;
+  const QStringView number = QStringView(name).chopped(1);
+  const bool isNumber =
+      std::all_of(number.begin(), number.end(),
+                  [](QChar ch) { return ch >= '0' && ch <= '9'; }) &&
+      (number.size() == 1 || number.front() != '0');
+  if (!isNumber)
+    return std::nullopt;
+  return RelativeRef{number.toInt(), suffix == afterSuffix};
+}
 
-    if (ub != relSymbols.second.begin()) {
-      auto lb = ub;
-      std::advance(lb, -1);
-      res[QString::number(relSymbols.first) + beforeSuffix] = lb->second;
+std::optional<VIntS> SymbolMap::resolve(const QString &name,
+                                        unsigned line) const {
+  if (!m_rel.empty()) {
+    if (auto ref = parseRelativeRef(name)) {
+      if (auto value = resolve(ref.value(), line))
+        return value;
     }
   }
 
-  return res;
+  if (auto id = find(name))
+    return m_values[id.value()];
+  return std::nullopt;
+}
+
+std::optional<VIntS> SymbolMap::resolve(const RelativeRef &ref,
+                                        unsigned line) const {
+  auto relSymbols = m_rel.find(ref.symbol);
+  if (relSymbols == m_rel.end())
+    return std::nullopt;
+  auto ub = relSymbols->second.upper_bound(line);
+  if (ref.forward) {
+    if (ub != relSymbols->second.end())
+      return ub->second;
+  } else if (ub != relSymbols->second.begin()) {
+    return std::prev(ub)->second;
+  }
+  return std::nullopt;
 }
 
 } // namespace Assembler
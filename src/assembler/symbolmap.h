@@ -2,22 +2,57 @@
 
 #include "assembler_defines.h"
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace Ripes {
 namespace Assembler {
 
-using AbsoluteSymbolMap = std::map<Symbol, VIntS>;
+/// Identifier of a symbol interned within a SymbolMap. IDs are dense, starting
+/// from 0, and remain valid until the symbol map is cleared.
+using SymbolID = unsigned;
+
+/**
+ * @brief The SymbolMap struct
+ * Symbol table of the assembler. Absolute symbols are interned on first use;
+ * each unique symbol name is assigned a SymbolID, through which its value may
+ * be accessed without any string comparisons. Name lookups are hashed.
+ *
+ * Relative (numerical) symbols may be defined multiple times, and are resolved
+ * relative to the source line of the reference, ie. '1b' refers to the nearest
+ * preceding definition of '1', and '1f' to the nearest following definition.
+ */
 struct SymbolMap {
-  AbsoluteSymbolMap abs;
   using RelativeSymbol = int;
   using SourceLine = unsigned;
-  std::map<RelativeSymbol, std::map<SourceLine, VIntS>> rel;
 
   void clear() {
-    abs.clear();
-    rel.clear();
+    m_symbols.clear();
+    m_values.clear();
+    m_ids.clear();
+    m_rel.clear();
+  }
+
+  /// Returns the ID of symbol @p s, interning it if it has not been seen
+  /// before. Interning a symbol does not define it.
+  SymbolID intern(const Symbol &s);
+
+  /// Returns the ID of the symbol named @p name, if it has been interned.
+  std::optional<SymbolID> find(const QString &name) const {
+    auto it = m_ids.find(name);
+    if (it == m_ids.end())
+      return std::nullopt;
+    return it->second;
   }
 
+  const Symbol &symbol(SymbolID id) const { return m_symbols.at(id); }
+
+  /// Returns the value of the (absolute) symbol @p id, if it has been defined.
+  std::optional<VIntS> value(SymbolID id) const { return m_values.at(id); }
+
+  /// Sets the value of the symbol @p id, overwriting any previous definition.
+  void setValue(SymbolID id, VInt v) { m_values.at(id) = v; }
+
   std::optional<Error> addSymbol(const TokenizedSrcLine &line, const Symbol &s,
                                  VInt v) {
     return s.isLocal() ? addRelSymbol(line.sourceLine(), s, v)
@@ -45,12 +80,44 @@ struct SymbolMap {
   std::optional<Error> addRelSymbol(const unsigned &line, const Symbol &s,
                                     VInt v);
 
-  /// Returns a copy of this symbol map with relative symbols copied relative to
-  /// 'line'. Relative symbols may be suffixed with additional strings in cases
-  /// of being before/after the provided source line.
-  AbsoluteSymbolMap copyRelativeTo(unsigned line,
-                                   const QString &beforeSuffix = "b",
-                                   const QString &afterSuffix = "f") const;
+  /// A reference to a relative symbol, ie. '1b' (backward) or '1f' (forward).
+  struct RelativeRef {
+    RelativeSymbol symbol;
+    bool forward;
+  };
+
+  /// Parses @p name as a relative symbol reference. Relative symbols are
+  /// referenced by their number suffixed with @p beforeSuffix or
+  /// @p afterSuffix.
+  static std::optional<RelativeRef> parseRelativeRef(const QString &name,
+                                                     QChar beforeSuffix = 'b',
+                                                     QChar afterSuffix = 'f');
+
+  /// Resolves the symbol @p name as referenced from source line @p line.
+  std::optional<VIntS> resolve(const QString &name, unsigned line) const;
+
+  /// Resolves the relative symbol reference @p ref as referenced from source
+  /// line @p line.
+  std::optional<VIntS> resolve(const RelativeRef &ref, unsigned line) const;
+
+  /// Calls @p f with each defined absolute symbol and its value, in order of
+  /// interning.
+  template <typename F>
+  void forEachAbsSymbol(F f) const {
+    for (SymbolID id = 0; id < m_symbols.size(); ++id) {
+      if (m_values[id].has_value())
+        f(m_symbols[id], m_values[id].value());
+    }
+  }
+
+private:
+  /// Interned symbols and their values, indexed by SymbolID.
+  std::vector<Symbol> m_symbols;
+  std::vector<std::optional<VIntS>> m_values;
+  std::unordered_map<Symbol, SymbolID> m_ids;
+
+  /// Relative symbols, as [symbol number : [source line : value]].
+  std::unordered_map<RelativeSymbol, std::map<SourceLine, VIntS>> m_rel;
 };
 
 } // namespace Assembler
@@ -3,25 +3,17 @@
 #include <QGraphicsLineItem>
 #include <QGraphicsRectItem>
 #include <QGraphicsScene>
+#include <QGraphicsSceneHoverEvent>
 #include <QGraphicsSimpleTextItem>
+#include <QPainter>
 #include <QPen>
+#include <QStyleOptionGraphicsItem>
+
+#include <cmath>
 
 #include "processorhandler.h"
 #include "radix.h"
 
-namespace {
-
-// Return a set of all keys in a map
-template <typename TK, typename TV>
-std::set<TK> keys(std::map<TK, TV> const &input_map) {
-  std::set<TK> keyset;
-  for (auto const &element : input_map) {
-    keyset.insert(element.first);
-  }
-  return keyset;
-}
-} // namespace
-
 namespace Ripes {
 
 /**
@@ -87,189 +79,282 @@ CacheGraphic::CacheGraphic(CacheSim &cache)
   connect(&cache, &CacheSim::cacheInvalidated, this,
           &CacheGraphic::cacheInvalidated);
 
+  // The exposed rect of the style option is required to only paint the visible
+  // cache lines.
+  setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+  setAcceptHoverEvents(true);
+
   cacheInvalidated();
 }
 
-void CacheGraphic::updateLineReplFields(unsigned lineIdx) {
-  auto *cacheLine = m_cache.getLine(lineIdx);
+QString CacheGraphic::addressString() const {
+  return "0x" +
+         QString("0").repeated(ProcessorHandler::currentISA()->bytes() * 2);
+}
+
+QRectF CacheGraphic::boundingRect() const {
+  return m_linesRect.united(childrenBoundingRect());
+}
 
+QRectF CacheGraphic::lineRect(unsigned lineIdx) const {
+  return QRectF(m_linesRect.left(), lineIdx * m_lineHeight,
+                m_linesRect.width(), m_lineHeight);
+}
+
+QRectF CacheGraphic::blockColumnRect(unsigned blockIdx) const {
+  return QRectF(m_widthBeforeBlocks + blockIdx * m_blockWidth, 0,
+                m_blockWidth, m_cacheHeight);
+}
+
+QRectF CacheGraphic::blockRect(unsigned lineIdx, unsigned wayIdx,
+                               unsigned blockIdx) const {
+  return QRectF(m_widthBeforeBlocks + blockIdx * m_blockWidth,
+                lineIdx * m_lineHeight + wayIdx * m_setHeight, m_blockWidth,
+                m_setHeight);
+}
+
+const CacheGraphic::LineSnapshot *
+CacheGraphic::line(unsigned lineIdx) const {
+  const auto it = m_lines.find(lineIdx);
+  if (it != m_lines.end()) {
+    return &it->second;
+  }
+  if (ProcessorHandler::isRunning()) {
+    return nullptr;
+  }
+
+  auto &snapshot = m_lines[lineIdx];
+  const auto *cacheLine = m_cache.getLine(lineIdx);
   if (cacheLine == nullptr) {
-    // Nothing to do
-    return;
+    return &snapshot;
   }
+  const unsigned bytes = ProcessorHandler::currentISA()->bytes();
+  for (const auto &[wayIdx, way] : *cacheLine) {
+    auto &waySnapshot = snapshot[wayIdx];
+    waySnapshot.way = way;
+    if (!way.valid) {
+      continue;
+    }
+    for (int blockIdx = 0; blockIdx < m_cache.getBlocks(); ++blockIdx) {
+      const AInt address = m_cache.buildAddress(way.tag, lineIdx, blockIdx);
+      waySnapshot.blocks.push_back(
+          ProcessorHandler::getMemory().readMemConst(address, bytes));
+    }
+  }
+  return &snapshot;
+}
 
-  if (m_cacheTextItems.at(0).at(0).lru == nullptr) {
-    // The current cache configuration does not have any replacement field
-    return;
+std::optional<CacheSim::CacheIndex>
+CacheGraphic::indexAt(const QPointF &pos) const {
+  if (pos.x() < m_widthBeforeBlocks || pos.x() >= m_cacheWidth ||
+      pos.y() < 0 || pos.y() >= m_cacheHeight) {
+    return {};
   }
 
-  for (const auto &way : m_cacheTextItems[lineIdx]) {
-    // If LRU was just initialized, the actual (software) LRU value may be very
-    // large. Mask to the number of actual LRU bits.
-    unsigned lruVal = cacheLine->at(way.first).lru;
-    lruVal &= vsrtl::generateBitmask(m_cache.getWaysBits());
-    const QString lruText = QString::number(lruVal);
-    way.second.lru->setText(lruText);
-
-    // LRU text might have changed; update LRU field position to center in
-    // column
-    const qreal y = lineIdx * m_lineHeight + way.first * m_setHeight;
-    const qreal x =
-        m_widthBeforeLRU + m_lruWidth / 2 - m_fm.horizontalAdvance(lruText) / 2;
-
-    way.second.lru->setPos(x, y);
+  CacheSim::CacheIndex index;
+  index.line = static_cast<unsigned>(pos.y() / m_lineHeight);
+  index.way = std::min<unsigned>(
+      (pos.y() - index.line * m_lineHeight) / m_setHeight,
+      m_cache.getWays() - 1);
+  index.block =
+      std::min<unsigned>((pos.x() - m_widthBeforeBlocks) / m_blockWidth,
+                         m_cache.getBlocks() - 1);
+
+  const auto *snapshot = line(index.line);
+  if (snapshot == nullptr) {
+    return {};
+  }
+  const auto wayIt = snapshot->find(index.way);
+  if (wayIt == snapshot->end() || !wayIt->second.way.valid) {
+    return {};
   }
+  return index;
 }
 
-QString CacheGraphic::addressString() const {
-  return "0x" +
-         QString("0").repeated(ProcessorHandler::currentISA()->bytes() * 2);
+std::optional<AInt> CacheGraphic::addressAt(const QPointF &pos) const {
+  const auto index = indexAt(pos);
+  if (!index) {
+    return {};
+  }
+  const auto &way = line(index->line)->at(index->way).way;
+  return m_cache.buildAddress(way.tag, index->line, index->block);
 }
 
-void CacheGraphic::updateWay(unsigned lineIdx, unsigned wayIdx) {
-  const auto &it = m_cacheTextItems.find(lineIdx);
-  if (it == m_cacheTextItems.end()) {
-    return;
+void CacheGraphic::hoverMoveEvent(QGraphicsSceneHoverEvent *event) {
+  // Block tooltips are generated on demand for the block under the cursor.
+  QString tooltip;
+  if (const auto index = indexAt(event->pos())) {
+    const auto &way = line(index->line)->at(index->way).way;
+    const AInt address =
+        m_cache.buildAddress(way.tag, index->line, index->block);
+    tooltip = "Address: " +
+              encodeRadixValue(address, Radix::Hex,
+                               ProcessorHandler::currentISA()->bytes());
+    if (way.dirtyBlocks.count(index->block)) {
+      tooltip += "\n> Dirty";
+    }
   }
-  const auto &wayIt = it->second.find(wayIdx);
-  if (wayIt == it->second.end()) {
+  setToolTip(tooltip);
+  QGraphicsObject::hoverMoveEvent(event);
+}
+
+void CacheGraphic::paint(QPainter *painter,
+                         const QStyleOptionGraphicsItem *option, QWidget *) {
+  const QRectF exposed = option->exposedRect.intersected(m_linesRect);
+  if (exposed.isEmpty()) {
     return;
   }
-  CacheWay &way = wayIt->second;
 
-  CacheSim::CacheWay simWay = CacheSim::CacheWay();
+  const unsigned firstLine =
+      static_cast<unsigned>(std::max(qreal(0), exposed.top() / m_lineHeight));
+  const unsigned lastLine = std::min<unsigned>(
+      std::ceil(exposed.bottom() / m_lineHeight), m_cache.getLines());
 
-  if (auto *cacheLine = m_cache.getLine(lineIdx)) {
-    simWay = cacheLine->at(wayIdx);
-  };
+  painter->save();
+  painter->setFont(m_font);
+  paintHighlighting(painter, firstLine, lastLine);
+  for (unsigned lineIdx = firstLine; lineIdx < lastLine; ++lineIdx) {
+    paintLine(painter, lineIdx);
+  }
+  paintGrid(painter, firstLine, lastLine);
+  painter->restore();
+}
 
-  const unsigned bytes = ProcessorHandler::currentISA()->bytes();
-  // ======================== Update block text fields ======================
-  if (simWay.valid) {
-    for (int i = 0; i < m_cache.getBlocks(); ++i) {
-      QGraphicsSimpleTextItem *blockTextItem = nullptr;
-      if (way.blocks.count(i) == 0) {
-        // Block text item has not yet been created
-        const qreal x =
-            m_widthBeforeBlocks + i * m_blockWidth +
-            (m_blockWidth / 2 - m_fm.horizontalAdvance(addressString()) / 2);
-        const qreal y = lineIdx * m_lineHeight + wayIdx * m_setHeight;
-
-        way.blocks[i] = createGraphicsTextItemSP(x, y);
-        blockTextItem = way.blocks[i].get();
-      } else {
-        blockTextItem = way.blocks.at(i).get();
-      }
+void CacheGraphic::paintCentered(QPainter *painter, const QString &text,
+                                 qreal x, qreal width, qreal y) const {
+  painter->drawText(
+      QPointF(x + width / 2 - m_fm.horizontalAdvance(text) / 2,
+              y + m_fm.ascent()),
+      text);
+}
 
-      // Update block text
-      const AInt addressForBlock = m_cache.buildAddress(simWay.tag, lineIdx, i);
-      const auto data =
-          ProcessorHandler::getMemory().readMemConst(addressForBlock, bytes);
-      const QString text = encodeRadixValue(
-          data, Radix::Hex, ProcessorHandler::currentISA()->bytes());
-      blockTextItem->setText(text);
-      QString tooltip =
-          "Address: " +
-          encodeRadixValue(addressForBlock, Radix::Hex,
-                           ProcessorHandler::currentISA()->bytes());
-      if (simWay.dirtyBlocks.count(i)) {
-        tooltip += "\n> Dirty";
-      }
-      blockTextItem->setToolTip(tooltip);
-      // Store the address within the userrole of the block text. Doing this, we
-      // are able to easily retrieve the address for the block if the block is
-      // clicked.
-      blockTextItem->setData(Qt::UserRole,
-                             QVariant::fromValue(addressForBlock));
-    }
-  } else {
-    // The way is invalid so no block text should be present
-    way.blocks.clear();
+void CacheGraphic::paintHighlighting(QPainter *painter, unsigned firstLine,
+                                     unsigned lastLine) const {
+  if (!m_transaction) {
+    return;
   }
 
-  // =========================== Update dirty field =========================
-  if (way.dirty) {
-    way.dirty->setText(QString::number(simWay.dirty));
+  // Highlight the currently indexed cache line and block column
+  QColor indexColor(Qt::yellow);
+  indexColor.setAlphaF(0.25);
+  const auto &index = m_transaction->index;
+  if (index.line >= firstLine && index.line < lastLine) {
+    painter->fillRect(QRectF(0, index.line * m_lineHeight, m_cacheWidth,
+                             m_lineHeight),
+                      indexColor);
   }
+  QRectF columnRect = blockColumnRect(index.block);
+  columnRect.setTop(firstLine * m_lineHeight);
+  columnRect.setBottom(lastLine * m_lineHeight);
+  painter->fillRect(columnRect, indexColor);
+}
 
-  // =========================== Update valid field =========================
-  if (way.valid) {
-    way.valid->setText(QString::number(simWay.valid));
-  }
+void CacheGraphic::paintLine(QPainter *painter, unsigned lineIdx) const {
+  static const WaySnapshot s_invalidWay;
+  const auto *snapshot = line(lineIdx);
+  const unsigned bytes = ProcessorHandler::currentISA()->bytes();
+  const bool hasDirty = m_cache.getWritePolicy() == WritePolicy::WriteBack;
+  const bool hasLRU = m_cache.getReplacementPolicy() == ReplPolicy::LRU &&
+                      m_cache.getWays() > 1;
+
+  QColor dirtyColor(Qt::darkCyan);
+  dirtyColor.setAlphaF(0.4);
+
+  for (int wayIdx = 0; snapshot != nullptr && wayIdx < m_cache.getWays();
+       ++wayIdx) {
+    const WaySnapshot *waySnapshot = &s_invalidWay;
+    const auto wayIt = snapshot->find(wayIdx);
+    if (wayIt != snapshot->end()) {
+      waySnapshot = &wayIt->second;
+    }
+    const CacheSim::CacheWay *way = &waySnapshot->way;
+    const qreal y = lineIdx * m_lineHeight + wayIdx * m_setHeight;
 
-  // ============================ Update tag field ==========================
-  if (simWay.valid) {
-    QGraphicsSimpleTextItem *tagTextItem = way.tag.get();
-    if (tagTextItem == nullptr) {
-      const qreal x =
-          m_widthBeforeTag +
-          (m_tagWidth / 2 - m_fm.horizontalAdvance(addressString()) / 2);
-      const qreal y = lineIdx * m_lineHeight + wayIdx * m_setHeight;
-      way.tag = createGraphicsTextItemSP(x, y);
-      tagTextItem = way.tag.get();
+    // ==================== Dirty blocks and access highlighting ==============
+    for (const unsigned blockIdx : way->dirtyBlocks) {
+      painter->fillRect(blockRect(lineIdx, wayIdx, blockIdx), dirtyColor);
     }
-    const QString tagText = encodeRadixValue(
-        simWay.tag, Radix::Hex, ProcessorHandler::currentISA()->bytes());
-    tagTextItem->setText(tagText);
-  } else {
-    // The way is invalid so no tag text should be present
-    if (way.tag) {
-      way.tag.reset();
+    if (m_transaction && m_transaction->index.line == lineIdx &&
+        m_transaction->index.way == static_cast<unsigned>(wayIdx)) {
+      QColor hitColor = m_transaction->isHit ? Qt::green : Qt::red;
+      hitColor.setAlphaF(m_transaction->isHit ? 0.4 : 0.8);
+      painter->fillRect(
+          blockRect(lineIdx, wayIdx, m_transaction->index.block), hitColor);
     }
-  }
 
-  // ==================== Update dirty blocks highlighting ==================
-  const std::set<unsigned> graphicDirtyBlocks = keys(way.dirtyBlocks);
-  std::set<unsigned> newDirtyBlocks;
-  std::set<unsigned> dirtyBlocksToDelete;
-  std::set_difference(
-      graphicDirtyBlocks.begin(), graphicDirtyBlocks.end(),
-      simWay.dirtyBlocks.begin(), simWay.dirtyBlocks.end(),
-      std::inserter(dirtyBlocksToDelete, dirtyBlocksToDelete.begin()));
-  std::set_difference(simWay.dirtyBlocks.begin(), simWay.dirtyBlocks.end(),
-                      graphicDirtyBlocks.begin(), graphicDirtyBlocks.end(),
-                      std::inserter(newDirtyBlocks, newDirtyBlocks.begin()));
-
-  // Delete blocks which are not in sync with the current dirty status of the
-  // way
-  for (const unsigned &blockToDelete : dirtyBlocksToDelete) {
-    way.dirtyBlocks.erase(blockToDelete);
-  }
-  // Create all required new blocks
-  for (const auto &blockIdx : newDirtyBlocks) {
-    const auto topLeft = QPointF(blockIdx * m_blockWidth + m_widthBeforeBlocks,
-                                 lineIdx * m_lineHeight + wayIdx * m_setHeight);
-    const auto bottomRight =
-        QPointF((blockIdx + 1) * m_blockWidth + m_widthBeforeBlocks,
-                lineIdx * m_lineHeight + (wayIdx + 1) * m_setHeight);
-    way.dirtyBlocks[blockIdx] =
-        std::make_unique<QGraphicsRectItem>(QRectF(topLeft, bottomRight), this);
-
-    const auto &dirtyRectItem = way.dirtyBlocks[blockIdx];
-    dirtyRectItem->setZValue(-1);
-    dirtyRectItem->setOpacity(0.4);
-    dirtyRectItem->setBrush(Qt::darkCyan);
+    painter->setPen(Qt::black);
+
+    // ======================== Valid, dirty and LRU fields ===================
+    paintCentered(painter, QString::number(way->valid), 0, m_bitWidth, y);
+    if (hasDirty) {
+      paintCentered(painter, QString::number(way->dirty), m_widthBeforeDirty,
+                    m_bitWidth, y);
+    }
+    if (hasLRU) {
+      // The actual (software) LRU value of an invalid way may be very large.
+      // Mask to the number of actual LRU bits.
+      const unsigned lruVal =
+          way->lru & vsrtl::generateBitmask(m_cache.getWaysBits());
+      paintCentered(painter, QString::number(lruVal), m_widthBeforeLRU,
+                    m_lruWidth, y);
+    }
+
+    if (!way->valid) {
+      // An invalid way has no tag nor block values
+      continue;
+    }
+
+    // ============================ Tag and block fields ======================
+    paintCentered(painter, encodeRadixValue(way->tag, Radix::Hex, bytes),
+                  m_widthBeforeTag, m_tagWidth, y);
+    for (unsigned blockIdx = 0; blockIdx < waySnapshot->blocks.size();
+         ++blockIdx) {
+      paintCentered(
+          painter,
+          encodeRadixValue(waySnapshot->blocks[blockIdx], Radix::Hex, bytes),
+          m_widthBeforeBlocks + blockIdx * m_blockWidth, m_blockWidth, y);
+    }
   }
+
+  // Line index number
+  const QString indexText = QString::number(lineIdx);
+  painter->drawText(
+      QPointF(-m_fm.horizontalAdvance(indexText) * 1.2,
+              lineIdx * m_lineHeight + m_lineHeight / 2 - m_setHeight / 2 +
+                  m_fm.ascent()),
+      indexText);
 }
 
-QGraphicsSimpleTextItem *
-CacheGraphic::tryCreateGraphicsTextItem(QGraphicsSimpleTextItem **item, qreal x,
-                                        qreal y) {
-  if (*item == nullptr) {
-    *item = new QGraphicsSimpleTextItem(this);
-    (*item)->setFont(m_font);
-    (*item)->setPos(x, y);
+void CacheGraphic::paintGrid(QPainter *painter, unsigned firstLine,
+                             unsigned lastLine) const {
+  const qreal top = firstLine * m_lineHeight;
+  const qreal bottom = lastLine * m_lineHeight;
+
+  QPen pen;
+  painter->setPen(pen);
+  for (const qreal x : m_columnEdges) {
+    painter->drawLine(QLineF(x, top, x, bottom));
   }
-  return *item;
-}
 
-std::unique_ptr<QGraphicsSimpleTextItem>
-CacheGraphic::createGraphicsTextItemSP(qreal x, qreal y) {
-  std::unique_ptr<QGraphicsSimpleTextItem> ptr =
-      std::make_unique<QGraphicsSimpleTextItem>(this);
-  ptr->setFont(m_font);
-  ptr->setPos(x, y);
-  return ptr;
+  QPen setPen = pen;
+  setPen.setStyle(Qt::DashLine);
+  for (unsigned lineIdx = firstLine; lineIdx <= lastLine; ++lineIdx) {
+    qreal verticalAdvance = lineIdx * m_lineHeight;
+    painter->setPen(pen);
+    painter->drawLine(
+        QLineF(0, verticalAdvance, m_cacheWidth, verticalAdvance));
+    if (lineIdx == lastLine) {
+      break;
+    }
+
+    // Cache set rows
+    painter->setPen(setPen);
+    for (int j = 1; j < m_cache.getWays(); j++) {
+      verticalAdvance += m_setHeight;
+      painter->drawLine(
+          QLineF(0, verticalAdvance, m_cacheWidth, verticalAdvance));
+    }
+  }
 }
 
 void CacheGraphic::drawIndexingItems() {
@@ -394,8 +479,9 @@ void CacheGraphic::drawIndexingItems() {
 
 void CacheGraphic::cacheInvalidated() {
   // Remove all items
-  m_highlightingItems.clear();
-  m_cacheTextItems.clear();
+  prepareGeometryChange();
+  m_transaction.reset();
+  m_lines.clear();
   m_addressTextItem = nullptr;
   m_blockIndexingLine = nullptr;
   m_lineIndexingLine = nullptr;
@@ -411,12 +497,15 @@ void CacheGraphic::cacheInvalidated() {
   m_lruWidth = m_fm.horizontalAdvance(QString::number(m_cache.getWays()) + " ");
   m_cacheHeight = m_lineHeight * m_cache.getLines();
   m_tagWidth = m_blockWidth;
+  m_indexWidth =
+      m_fm.horizontalAdvance(QString::number(m_cache.getLines() - 1)) * 1.2;
 
-  // Draw cache:
-  new QGraphicsLineItem(0, 0, 0, m_cacheHeight, this);
+  // Draw cache headers. The grid and the contents of the cache lines are
+  // painted in paint(); only the column edges are recorded here.
+  m_columnEdges = {0};
   qreal width = 0;
   // Draw valid bit column
-  new QGraphicsLineItem(m_bitWidth, 0, m_bitWidth, m_cacheHeight, this);
+  m_columnEdges.push_back(m_bitWidth);
   const QString validBitText = "V";
   auto *validItem = drawText(validBitText, 0, -m_fm.height());
   validItem->setToolTip("Valid bit");
@@ -426,8 +515,7 @@ void CacheGraphic::cacheInvalidated() {
     m_widthBeforeDirty = width;
 
     // Draw dirty bit column
-    new QGraphicsLineItem(width + m_bitWidth, 0, width + m_bitWidth,
-                          m_cacheHeight, this);
+    m_columnEdges.push_back(width + m_bitWidth);
     const QString dirtyBitText = "D";
     auto *dirtyItem =
         drawText(dirtyBitText, m_widthBeforeDirty, -m_fm.height());
@@ -440,8 +528,7 @@ void CacheGraphic::cacheInvalidated() {
   if (m_cache.getReplacementPolicy() == ReplPolicy::LRU &&
       m_cache.getWays() > 1) {
     // Draw LRU bit column
-    new QGraphicsLineItem(width + m_lruWidth, 0, width + m_lruWidth,
-                          m_cacheHeight, this);
+    m_columnEdges.push_back(width + m_lruWidth);
     const QString LRUBitText = "LRU";
     auto *textItem = drawText(LRUBitText,
                               width + m_lruWidth / 2 -
@@ -454,8 +541,7 @@ void CacheGraphic::cacheInvalidated() {
   m_widthBeforeTag = width;
 
   // Draw tag column
-  new QGraphicsLineItem(m_tagWidth + width, 0, m_tagWidth + width,
-                        m_cacheHeight, this);
+  m_columnEdges.push_back(m_tagWidth + width);
   const QString tagText = "Tag";
   drawText(tagText,
            width + m_tagWidth / 2 - m_fm.horizontalAdvance(tagText) / 2,
@@ -464,45 +550,19 @@ void CacheGraphic::cacheInvalidated() {
   width += m_tagWidth;
   m_widthBeforeBlocks = width;
 
-  // Draw horizontal lines between cache blocks
+  // Draw block column headers
   for (int i = 0; i < m_cache.getBlocks(); ++i) {
     const QString blockText = "Word " + QString::number(i);
     drawText(blockText,
              width + m_tagWidth / 2 - m_fm.horizontalAdvance(blockText) / 2,
              -m_fm.height());
     width += m_blockWidth;
-    new QGraphicsLineItem(width, 0, width, m_cacheHeight, this);
+    m_columnEdges.push_back(width);
   }
 
   m_cacheWidth = width;
-
-  // Draw cache line rows
-  for (int i = 0; i <= m_cache.getLines(); ++i) {
-    qreal verticalAdvance = i * m_lineHeight;
-    new QGraphicsLineItem(0, verticalAdvance, m_cacheWidth, verticalAdvance,
-                          this);
-
-    if (i < m_cache.getLines()) {
-      // Draw cache set rows
-      for (int j = 1; j < m_cache.getWays(); j++) {
-        verticalAdvance += m_setHeight;
-        auto *setLine = new QGraphicsLineItem(0, verticalAdvance, m_cacheWidth,
-                                              verticalAdvance, this);
-        auto pen = setLine->pen();
-        pen.setStyle(Qt::DashLine);
-        setLine->setPen(pen);
-      }
-    }
-  }
-
-  // Draw line index numbers
-  for (int i = 0; i < m_cache.getLines(); ++i) {
-    const QString text = QString::number(i);
-
-    const qreal y = i * m_lineHeight + m_lineHeight / 2 - m_setHeight / 2;
-    const qreal x = -m_fm.horizontalAdvance(text) * 1.2;
-    drawText(text, x, y);
-  }
+  m_linesRect =
+      QRectF(-m_indexWidth, 0, m_cacheWidth + m_indexWidth, m_cacheHeight);
 
   // Draw index column text
   const QString indexText = "Index";
@@ -515,17 +575,7 @@ void CacheGraphic::cacheInvalidated() {
     drawIndexingItems();
   }
 
-  initializeControlBits();
-
-  // Update all entries in the cache
-  for (int lineIdx = 0; lineIdx < m_cache.getLines(); lineIdx++) {
-    if (const auto *line = m_cache.getLine(lineIdx)) {
-      for (const auto &way : *line) {
-        updateWay(lineIdx, way.first);
-      }
-      updateLineReplFields(lineIdx);
-    }
-  }
+  update();
 
   if (auto *_scene = scene()) {
     // Invalidate the scene rect to resize it to the current dimensions of the
@@ -538,20 +588,20 @@ void CacheGraphic::updateAddressing(
     bool valid, const CacheSim::CacheTransaction &transaction) {
   if (m_indexingVisible) {
     if (valid) {
-      const auto &it = m_cacheTextItems.find(transaction.index.line);
-      if (it == m_cacheTextItems.end()) {
+      const auto *snapshot = line(transaction.index.line);
+      if (snapshot == nullptr) {
         return;
       }
-      const auto &wayIt = it->second.find(transaction.index.way);
-      if (wayIt == it->second.end()) {
+      const auto &wayIt = snapshot->find(transaction.index.way);
+      if (wayIt == snapshot->end()) {
         return;
       }
 
-      const CacheWay &way = wayIt->second;
+      const CacheSim::CacheWay &way = wayIt->second.way;
       m_addressTextItem->setText(
           QString::number(transaction.address, 2).rightJustified(32, '0'));
 
-      if (way.tag) {
+      if (way.valid) {
         QPolygonF lineIndexingPoly;
         m_lineIndexingLine->setVisible(true);
         lineIndexingPoly << m_lineIndexStartPoint;
@@ -590,9 +640,11 @@ void CacheGraphic::updateAddressing(
   }
 }
 
-void CacheGraphic::wayInvalidated(unsigned lineIdx, unsigned wayIdx) {
-  updateWay(lineIdx, wayIdx);
-  updateLineReplFields(lineIdx);
+void CacheGraphic::wayInvalidated(unsigned lineIdx, unsigned) {
+  // The replacement fields of all ways in the line may have changed, so the
+  // entire line is snapshotted anew and repainted.
+  m_lines.erase(lineIdx);
+  update(lineRect(lineIdx));
 }
 
 void CacheGraphic::dataChanged(CacheSim::CacheTransaction transaction) {
@@ -627,85 +679,18 @@ QGraphicsSimpleTextItem *CacheGraphic::drawText(const QString &text, qreal x,
 
 void CacheGraphic::updateHighlighting(
     bool active, const CacheSim::CacheTransaction &transaction) {
-  m_highlightingItems.clear();
-
-  if (active) {
-    // Redraw highlighting rectangles indicating the current indexing
-
-    // Draw cache line highlighting rectangle
-    QPointF topLeft = QPointF(0, transaction.index.line * m_lineHeight);
-    QPointF bottomRight =
-        QPointF(m_cacheWidth, (transaction.index.line + 1) * m_lineHeight);
-    m_highlightingItems.emplace_back(std::make_unique<QGraphicsRectItem>(
-        QRectF(topLeft, bottomRight), this));
-    auto *lineRectItem = m_highlightingItems.rbegin()->get();
-    lineRectItem->setZValue(-2);
-    lineRectItem->setOpacity(0.25);
-    lineRectItem->setBrush(Qt::yellow);
-
-    // Draw cache block highlighting rectangle
-    topLeft = QPointF(
-        transaction.index.block * m_blockWidth + m_widthBeforeBlocks, 0);
-    bottomRight = QPointF((transaction.index.block + 1) * m_blockWidth +
-                              m_widthBeforeBlocks,
-                          m_cacheHeight);
-    m_highlightingItems.emplace_back(std::make_unique<QGraphicsRectItem>(
-        QRectF(topLeft, bottomRight), this));
-    auto *blockRectItem = m_highlightingItems.rbegin()->get();
-    blockRectItem->setZValue(-2);
-    blockRectItem->setOpacity(0.25);
-    blockRectItem->setBrush(Qt::yellow);
-
-    // Draw highlighting on the currently accessed block
-    topLeft =
-        QPointF(transaction.index.block * m_blockWidth + m_widthBeforeBlocks,
-                transaction.index.line * m_lineHeight +
-                    transaction.index.way * m_setHeight);
-    bottomRight = QPointF((transaction.index.block + 1) * m_blockWidth +
-                              m_widthBeforeBlocks,
-                          transaction.index.line * m_lineHeight +
-                              (transaction.index.way + 1) * m_setHeight);
-    m_highlightingItems.emplace_back(std::make_unique<QGraphicsRectItem>(
-        QRectF(topLeft, bottomRight), this));
-    auto *hitRectItem = m_highlightingItems.rbegin()->get();
-    hitRectItem->setZValue(-1);
-    if (transaction.isHit) {
-      hitRectItem->setOpacity(0.4);
-      hitRectItem->setBrush(Qt::green);
-    } else {
-      hitRectItem->setOpacity(0.8);
-      hitRectItem->setBrush(Qt::red);
-    }
+  // Repaint the areas covered by the previous and the new highlighting.
+  if (m_transaction) {
+    update(lineRect(m_transaction->index.line));
+    update(blockColumnRect(m_transaction->index.block));
   }
-}
 
-void CacheGraphic::initializeControlBits() {
-  for (int lineIdx = 0; lineIdx < m_cache.getLines(); lineIdx++) {
-    auto &line = m_cacheTextItems[lineIdx];
-    for (int setIdx = 0; setIdx < m_cache.getWays(); setIdx++) {
-      const qreal y = lineIdx * m_lineHeight + setIdx * m_setHeight;
-      qreal x;
-
-      // Create valid field
-      x = m_bitWidth / 2 - m_fm.horizontalAdvance("0") / 2;
-      line[setIdx].valid = drawText("0", x, y);
-
-      if (m_cache.getWritePolicy() == WritePolicy::WriteBack) {
-        // Create dirty bit field
-        x = m_widthBeforeDirty + m_bitWidth / 2 -
-            m_fm.horizontalAdvance("0") / 2;
-        line[setIdx].dirty = drawText("0", x, y);
-      }
-
-      if (m_cache.getReplacementPolicy() == ReplPolicy::LRU &&
-          m_cache.getWays() > 1) {
-        // Create LRU field
-        const QString lruText = QString::number(m_cache.getWays() - 1);
-        x = m_widthBeforeLRU + m_lruWidth / 2 -
-            m_fm.horizontalAdvance(lruText) / 2;
-        line[setIdx].lru = drawText(lruText, x, y);
-      }
-    }
+  if (active) {
+    m_transaction = transaction;
+    update(lineRect(transaction.index.line));
+    update(blockColumnRect(transaction.index.block));
+  } else {
+    m_transaction.reset();
   }
 }
 
@@ -6,7 +6,10 @@
 #include <QFontMetrics>
 #include <QGraphicsItem>
 #include <QObject>
+#include <map>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace Ripes {
 class FancyPolyLine;
@@ -15,25 +18,42 @@ class CacheGraphic : public QGraphicsObject {
 public:
   CacheGraphic(CacheSim &cache);
 
-  QRectF boundingRect() const override { return childrenBoundingRect(); };
+  QRectF boundingRect() const override;
 
-  void paint(QPainter *, const QStyleOptionGraphicsItem *,
-             QWidget * = nullptr) override {}
+  /**
+   * @brief paint
+   * The contents of the cache are painted from snapshots of the cache lines
+   * (see line()). Only the cache lines intersecting the exposed area of the
+   * item are painted, such that the cost of a repaint is bounded by the size
+   * of the viewport rather than the size of the cache.
+   */
+  void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
+             QWidget * = nullptr) override;
   bool indexingVisible() const { return m_indexingVisible; }
 
+  /**
+   * @brief addressAt
+   * Returns the address of the cache block at @p pos (in item coordinates), if
+   * @p pos is within a block of a valid cache way.
+   */
+  std::optional<AInt> addressAt(const QPointF &pos) const;
+
+protected:
+  void hoverMoveEvent(QGraphicsSceneHoverEvent *event) override;
+
 public slots:
   /**
    * @brief dataChanged
    * The cache simulator indicates that some entries in the cache has changed.
-   * CacheGraphic will, using @p transaction, lazily initialize and update all
-   * required values to reflect the new state of the cache.
+   * CacheGraphic will, using @p transaction, repaint the affected cache line
+   * and move the access highlighting to the accessed block.
    */
   void dataChanged(CacheSim::CacheTransaction transaction);
 
   /**
    * @brief wayInvalidated
-   * The cache simulator has signalled that all graphics in the given cache way
-   * shall be reinitialized to reflect a changed state in the cache simulator.
+   * The cache simulator has signalled that the given cache way shall be
+   * repainted to reflect a changed state in the cache simulator.
    */
   void wayInvalidated(unsigned lineIdx, unsigned wayIdx);
 
@@ -55,39 +75,50 @@ public slots:
   void setIndexingVisible(bool visible);
 
 private:
-  // Data structure modelling the cache; keeping graphics text items for each
-  // entry All text items which are not always present are stored as
-  // unqiue_ptr's to facilitate easy deletion when undoing changes to the cache
-  struct CacheWay {
-    std::map<unsigned, std::unique_ptr<QGraphicsSimpleTextItem>> blocks;
-    std::unique_ptr<QGraphicsSimpleTextItem> tag = nullptr;
-    QGraphicsSimpleTextItem *lru = nullptr;
-    QGraphicsSimpleTextItem *valid = nullptr;
-    QGraphicsSimpleTextItem *dirty = nullptr;
-    std::map<unsigned, std::unique_ptr<QGraphicsRectItem>> dirtyBlocks;
+  /// Snapshot of a cache way, alongside the memory contents of its blocks.
+  struct WaySnapshot {
+    CacheSim::CacheWay way;
+    std::vector<VInt> blocks;
   };
+  using LineSnapshot = std::map<unsigned, WaySnapshot>;
 
-  using CacheLine = std::map<unsigned, CacheWay>;
+  /**
+   * @brief line
+   * Returns a snapshot of the cache line @p lineIdx. The cache simulator and
+   * memory are modified by the simulator thread, so snapshots are only taken
+   * while the processor is not running; a line which has not been snapshotted
+   * before running started is unavailable (nullptr) until running finishes.
+   */
+  const LineSnapshot *line(unsigned lineIdx) const;
 
   /**
-   * @brief initializeControlBits
-   * Constructs all of the "Valid" and "LRU" text items within the cache
+   * @brief indexAt
+   * Returns the index of the cache block at @p pos, if @p pos is within a
+   * block of a valid cache way.
    */
-  void initializeControlBits();
-  void updateHighlighting(bool active,
-                          const CacheSim::CacheTransaction &transaction);
+  std::optional<CacheSim::CacheIndex> indexAt(const QPointF &pos) const;
+
+  // Painting functions. Each of these paints the lines [firstLine, lastLine).
+  void paintHighlighting(QPainter *painter, unsigned firstLine,
+                         unsigned lastLine) const;
+  void paintLine(QPainter *painter, unsigned lineIdx) const;
+  void paintGrid(QPainter *painter, unsigned firstLine,
+                 unsigned lastLine) const;
+  void paintCentered(QPainter *painter, const QString &text, qreal x,
+                     qreal width, qreal y) const;
+
+  QRectF lineRect(unsigned lineIdx) const;
+  QRectF blockColumnRect(unsigned blockIdx) const;
+  QRectF blockRect(unsigned lineIdx, unsigned wayIdx, unsigned blockIdx) const;
+
   QGraphicsSimpleTextItem *drawText(const QString &text, const QPointF &pos,
                                     const QFont *otherFont = nullptr);
   QGraphicsSimpleTextItem *drawText(const QString &text, qreal x, qreal y,
                                     const QFont *otherFont = nullptr);
-  QGraphicsSimpleTextItem *
-  tryCreateGraphicsTextItem(QGraphicsSimpleTextItem **item, qreal x, qreal y);
-  std::unique_ptr<QGraphicsSimpleTextItem> createGraphicsTextItemSP(qreal x,
-                                                                    qreal y);
 
   // Graphical update functions
-  void updateLineReplFields(unsigned lineIdx);
-  void updateWay(unsigned lineIdx, unsigned wayIdx);
+  void updateHighlighting(bool active,
+                          const CacheSim::CacheTransaction &transaction);
   void updateAddressing(bool valid,
                         const CacheSim::CacheTransaction &transaction);
   void drawIndexingItems();
@@ -96,8 +127,6 @@ private:
   QFont m_font = QFont(Fonts::monospace, 12);
   CacheSim &m_cache;
 
-  std::vector<std::unique_ptr<QGraphicsRectItem>> m_highlightingItems;
-
   QFontMetricsF m_fm;
 
   bool m_indexingVisible = true;
@@ -115,21 +144,31 @@ private:
   qreal m_widthBeforeLRU = 0;
   qreal m_widthBeforeDirty = 0;
   qreal m_lruWidth = 0;
+  qreal m_indexWidth = 0;
+
+  // Area covered by the cache lines, including the line index column.
+  QRectF m_linesRect;
+
+  // x-coordinates of the vertical grid lines of the cache.
+  std::vector<qreal> m_columnEdges;
 
   static constexpr qreal z_grid = 0;
   static constexpr qreal z_wires = -1;
 
   /**
-   * @brief m_cacheTextItems
-   * All text items in the cache are managed in @var m_cacheTextItems.
-   * This object models the hierarchy of the cache, and stores all currently
-   * initialized text items for the cache. The object is indexed similarly to
-   * how the cache simulator is indexed. As such, a cache transaction is used to
-   * traverse the object.
-   * All items are lazily initialized in calls to dataChanged(). This prevents
-   * initializing a ton of items if a user has created a very large cache.
+   * @brief m_transaction
+   * The most recent cache transaction, which is highlighted in the graphic.
+   */
+  std::optional<CacheSim::CacheTransaction> m_transaction;
+
+  /**
+   * @brief m_lines
+   * Snapshots of the cache lines which have been painted. Snapshots are taken
+   * on demand and dropped whenever the cache simulator signals that a line
+   * changed, or that the entire cache should be reloaded (ie. when running
+   * finishes).
    */
-  std::map<unsigned, CacheLine> m_cacheTextItems;
+  mutable std::map<unsigned, LineSnapshot> m_lines;
 
   // Addressing related items which are moved around when addressing changes
   QGraphicsSimpleTextItem *m_addressTextItem = nullptr;
@@ -1,9 +1,11 @@
 #include "cacheplotwidget.h"
 #include "ui_cacheplotwidget.h"
 
+#include <QApplication>
 #include <QCheckBox>
 #include <QClipboard>
 #include <QFileDialog>
+#include <QMessageBox>
 #include <QPushButton>
 #include <QToolBar>
 #include <QtCharts/QAreaSeries>
@@ -12,6 +14,8 @@
 #include <QtCharts/QValueAxis>
 
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 
 #include "colors.h"
 #include "enumcombobox.h"
@@ -110,6 +114,7 @@ void CachePlotWidget::setCache(const std::shared_ptr<CacheSim> &cache) {
     updateRatioPlot();
     updateAllowedRange(RangeChangeSource::Cycles);
     updatePlotAxes();
+    renderVisibleRange();
   };
   connect(ProcessorHandler::get(), &ProcessorHandler::processorClockedNonRun,
           this, plotUpdateFunc);
@@ -130,6 +135,12 @@ void CachePlotWidget::setCache(const std::shared_ptr<CacheSim> &cache) {
   m_plot->addSeries(m_mavgSeries);
   m_plot->createDefaultAxes();
   m_plot->legend()->show();
+  // The series are decimated to the width of the plot area; re-render once
+  // the width changes, e.g. when the widget is resized.
+  connect(m_plot, &QChart::plotAreaChanged, this, [=](const QRectF &area) {
+    if (static_cast<int>(area.width()) != m_renderedWidth)
+      renderVisibleRange();
+  });
   m_ui->plotView->setPlot(m_plot);
   setupPlotActions();
   updatePlotAxes();
@@ -293,6 +304,7 @@ void CachePlotWidget::rangeChanged(const RangeChangeSource src) {
     m_plot->axes(Qt::Horizontal)
         .constFirst()
         ->setRange(m_ui->rangeMin->value(), m_ui->rangeMax->value());
+    renderVisibleRange();
   }
 }
 
@@ -304,6 +316,7 @@ void CachePlotWidget::variablesChanged() {
   updateRatioPlot();
   updateAllowedRange(RangeChangeSource::Cycles);
   updatePlotAxes();
+  renderVisibleRange();
 }
 
 std::map<CachePlotWidget::Variable, QList<QPoint>>
@@ -316,8 +329,7 @@ CachePlotWidget::gatherData(unsigned fromCycle) const {
   }
 
   // Gather data up until the end of the trace or the maximum plotted cycles
-  const unsigned maxCycles =
-      RipesSettings::value(RIPES_SETTING_CACHE_MAXCYCLES).toInt();
+  const unsigned maxCycles = m_maxCycles.value();
   if (fromCycle > maxCycles) {
     return {};
   }
@@ -342,30 +354,59 @@ CachePlotWidget::gatherData(unsigned fromCycle) const {
   return cacheData;
 }
 
-void resample(QLineSeries *series, unsigned target, double &step) {
-  QVector<QPointF> newPoints;
-  const auto &oldPoints = series->pointsVector();
-  step = (oldPoints.last().x() / static_cast<double>(target)) *
-         2; // *2 to account for steps
-  newPoints.reserve(target);
-  for (int i = 0; i < oldPoints.size(); i += step) {
-    newPoints << oldPoints.at(i);
+/// Decimates the points of @p data (sorted by x) within the range
+/// [@p from, @p to] into @p buckets equally sized buckets. For each bucket,
+/// only the minimum and maximum points are retained, such that peaks remain
+/// visible regardless of the number of points. If the range contains few
+/// enough points, all points are retained, and if @p steps is set, step points
+/// are inserted between consecutive points.
+static QVector<QPointF> decimate(const std::vector<QPointF> &data, double from,
+                                 double to, int buckets, bool steps) {
+  const auto xLess = [](const QPointF &p, double x) { return p.x() < x; };
+  const auto lessX = [](double x, const QPointF &p) { return x < p.x(); };
+  // Include the points just outside of the range, to draw the lines leading
+  // into and out of the range.
+  auto first = std::lower_bound(data.begin(), data.end(), from, xLess);
+  if (first != data.begin())
+    --first;
+  auto last = std::upper_bound(first, data.end(), to, lessX);
+  if (last != data.end())
+    ++last;
+
+  QVector<QPointF> points;
+  const auto n = std::distance(first, last);
+  if (n <= 2 * buckets) {
+    points.reserve(steps ? 2 * n : n);
+    for (auto it = first; it != last; ++it) {
+      if (steps && it != first)
+        points << stepPoint(*std::prev(it), *it);
+      points << *it;
+    }
+    return points;
   }
 
-#if !defined(QT_NO_DEBUG)
-  // sanity check
-  QPointF plast = QPointF(0, 0);
-  bool first = true;
-  for (const auto &p : qAsConst(newPoints)) {
-    if (!first) {
-      Q_ASSERT(p.x() - plast.x() < step * 1.1);
-      first = false;
+  const double bucketWidth = (to - from) / buckets;
+  points.reserve(2 * buckets + 4);
+  for (auto it = first; it != last;) {
+    const double bucketEnd =
+        from + (std::floor((it->x() - from) / bucketWidth) + 1) * bucketWidth;
+    auto minIt = it;
+    auto maxIt = it;
+    for (++it; it != last && it->x() < bucketEnd; ++it) {
+      if (it->y() < minIt->y())
+        minIt = it;
+      if (it->y() > maxIt->y())
+        maxIt = it;
+    }
+    if (minIt == maxIt) {
+      points << *minIt;
+    } else if (minIt->x() < maxIt->x()) {
+      points << *minIt << *maxIt;
+    } else {
+      points << *maxIt << *minIt;
     }
-    plast = p;
   }
-#endif
-
-  series->replace(newPoints);
+  return points;
 }
 
 void CachePlotWidget::updatePlotAxes() {
@@ -400,111 +441,88 @@ void CachePlotWidget::updatePlotAxes() {
                   m_ui->rangeSlider->maximumPosition());
 }
 
-void CachePlotWidget::updateRatioPlot() {
-  const auto newCacheData = gatherData(m_lastCyclePlotted);
-  const int nNewPoints = newCacheData.at(Accesses).size();
-  if (nNewPoints == 0) {
-    return;
+static unsigned traceValue(const CacheAccessTrace &entry,
+                           CachePlotWidget::Variable variable) {
+  switch (variable) {
+  case CachePlotWidget::Writes:
+    return entry.writes;
+  case CachePlotWidget::Reads:
+    return entry.reads;
+  case CachePlotWidget::Hits:
+    return entry.hits;
+  case CachePlotWidget::Misses:
+    return entry.misses;
+  case CachePlotWidget::WasHit:
+    return entry.lastTransaction.isHit;
+  case CachePlotWidget::WasMiss:
+    return !entry.lastTransaction.isHit;
+  case CachePlotWidget::Writebacks:
+    return entry.writebacks;
+  case CachePlotWidget::Accesses:
+    return entry.hits + entry.misses;
+  case CachePlotWidget::Unary:
+  case CachePlotWidget::N_TraceVars:
+    break;
   }
+  return 1;
+}
 
-  // convenience function to move a series on/off the chart based on the number
-  // of points to be added. We have to remove series due to append(QList(...))
-  // calling redraw _for each_ point in the list. Not removing the series for
-  // low nNewPoints avoids a flicker in plot labels. Everything is a balance...
-  const auto plotMover = [=](QLineSeries *series, bool visible) {
-    if (nNewPoints > 2) {
-      if (visible) {
-        this->m_plot->addSeries(series);
-      } else {
-        this->m_plot->removeSeries(series);
-      }
-    }
-  };
-
-  m_lastCyclePlotted = newCacheData.at(Accesses).last().x();
-
-  QList<QPointF> newPoints;
-  QList<QPointF> newWindowPoints;
-  QPointF lastPoint;
-  if (m_series->pointsVector().size() > 0) {
-    lastPoint = m_series->pointsVector().constLast();
-  } else {
-    lastPoint = QPointF(-1, 0);
-  }
-  for (int i = 0; i < nNewPoints; ++i) {
-    // Cummulative plot. For the unary variable, "Accesses" is just used to
-    // index into the cache data for accessing the x variable.
-    const auto &p1 = m_numerator == Unary
-                         ? QPoint(newCacheData.at(Accesses).at(i).x(), 1)
-                         : newCacheData.at(m_numerator).at(i);
-    const auto &p2 = m_denominator == Unary
-                         ? QPoint(newCacheData.at(Accesses).at(i).x(), 1)
-                         : newCacheData.at(m_denominator).at(i);
-    Q_ASSERT(p1.x() == p2.x() && "Data inconsistency");
+void CachePlotWidget::updateRatioPlot() {
+  const auto &trace = m_cache->getAccessTrace();
+  const unsigned maxCycles = m_maxCycles.value();
+  const bool showMAvg = m_ui->showMAvg->isChecked();
+
+  // Only the cycles traced since the last update are appended to the plot.
+  bool newPoints = false;
+  for (auto it = trace.upper_bound(static_cast<unsigned>(m_lastCyclePlotted));
+       it != trace.end() && it->first < maxCycles; ++it) {
+    const unsigned numerator = traceValue(it->second, m_numerator);
+    const unsigned denominator = traceValue(it->second, m_denominator);
     double ratio = 0;
-    if (p2.y() != 0) {
-      ratio = static_cast<double>(p1.y()) / p2.y();
+    if (denominator != 0) {
+      ratio = static_cast<double>(numerator) / denominator;
       ratio *= 100.0;
     }
-    bool skipPoint = false;
-    const QPointF newPoint = QPointF(p1.x(), ratio);
-    if (lastPoint.x() >= 0) {
-      if (newPoint.x() - lastPoint.x() < m_xStep) {
-        // Skip point; irrelevant at the current sampling level
-        skipPoint = true;
-      }
-    }
-    if (!skipPoint) {
-      newPoints << stepPoint(lastPoint, newPoint);
-      newPoints << newPoint;
-      m_maxY = ratio > m_maxY ? ratio : m_maxY;
-      m_minY = ratio < m_minY ? ratio : m_minY;
-      lastPoint = newPoint;
-    }
-
-    // Moving average plot
-    if (m_ui->showMAvg->isChecked()) {
-      m_mavgData.push(newPoint.y());
-      const double wAvg =
-          std::accumulate(m_mavgData.begin(), m_mavgData.end(), 0.0) /
-          m_mavgData.size();
-      newWindowPoints << QPointF(p1.x(), wAvg);
+    m_ratioData.push_back(QPointF(it->first, ratio));
+    m_maxY = ratio > m_maxY ? ratio : m_maxY;
+    m_minY = ratio < m_minY ? ratio : m_minY;
+
+    // Moving average plot. The sum of the window is maintained as values
+    // enter and leave the window.
+    if (showMAvg) {
+      if (m_mavgData.size() == m_mavgData.capacity())
+        m_mavgSum -= m_mavgData.front();
+      m_mavgData.push(ratio);
+      m_mavgSum += ratio;
+      m_mavgPoints.push_back(
+          QPointF(it->first, m_mavgSum / m_mavgData.size()));
     }
+    m_lastCyclePlotted = it->first;
+    newPoints = true;
   }
 
-  if (newPoints.size() == 0 && newWindowPoints.size() == 0) {
-    return;
-  }
-
-  plotMover(m_series, false);
-  m_series->append(newPoints);
-  if (m_ui->showMAvg->isChecked()) {
-    plotMover(m_mavgSeries, false);
-    m_mavgSeries->append(newWindowPoints);
-  }
-
-  // Determine whether to resample;
-  // *2 the allowed points to account for the addition of step points.
-  // *2 to account for the fact that the setting specifies the minimum # of
-  // points, and we resample at a 2x ratio
-  const int maxPoints =
-      RipesSettings::value(RIPES_SETTING_CACHE_MAXPOINTS).toInt() * 2 * 2;
-  if (m_series->pointsVector().size() >= maxPoints) {
-    resample(m_series, maxPoints / 2, m_xStep);
-  }
-
-  plotMover(m_series, true);
-  if (m_ui->showMAvg->isChecked()) {
-    plotMover(m_mavgSeries, true);
-  }
+  if (newPoints)
+    updatePlotWarningButton();
+}
 
-  updatePlotWarningButton();
+void CachePlotWidget::renderVisibleRange() {
+  if (!m_plot)
+    return;
+  const double from = m_ui->rangeSlider->minimumPosition();
+  const double to = m_ui->rangeSlider->maximumPosition();
+
+  // Bucket the visible range per pixel of the plot area, but with no less
+  // buckets than the configured minimum number of plot points.
+  m_renderedWidth = static_cast<int>(m_plot->plotArea().width());
+  const int buckets = std::max(m_renderedWidth, m_maxPoints.value());
+  m_series->replace(decimate(m_ratioData, from, to, buckets, true));
+  if (m_ui->showMAvg->isChecked())
+    m_mavgSeries->replace(decimate(m_mavgPoints, from, to, buckets, false));
 }
 
 void CachePlotWidget::updatePlotWarningButton() {
   m_ui->maxCyclesButton->setVisible(
-      m_lastCyclePlotted >=
-      RipesSettings::value(RIPES_SETTING_CACHE_MAXCYCLES).toInt());
+      m_lastCyclePlotted >= m_maxCycles.value());
 }
 
 void CachePlotWidget::resetRatioPlot() {
@@ -512,11 +530,13 @@ void CachePlotWidget::resetRatioPlot() {
   m_minY = DBL_MAX;
   m_series->clear();
   m_mavgSeries->clear();
+  m_ratioData.clear();
+  m_mavgPoints.clear();
   m_lastCyclePlotted = 0;
-  m_xStep = 1;
 
   if (m_ui->showMAvg->isChecked()) {
     m_mavgData = FixedQueue<double>(m_ui->windowCycles->value());
+    m_mavgSum = 0;
     m_mavgSeries->setVisible(true);
   } else {
     m_mavgSeries->setVisible(false);
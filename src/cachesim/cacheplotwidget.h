@@ -1,12 +1,15 @@
 #pragma once
 
 #include <QMetaType>
+#include <QPointF>
 #include <QWidget>
 #include <QtCharts/QChartGlobal>
 
 #include "cachesim.h"
 #include "float.h"
+#include "ripessettings.h"
 #include <queue>
+#include <vector>
 
 QT_FORWARD_DECLARE_CLASS(QToolBar);
 QT_FORWARD_DECLARE_CLASS(QAction);
@@ -19,6 +22,7 @@ template <typename T>
 class FixedQueue : public std::deque<T> {
 public:
   FixedQueue(const unsigned N = 1) : m_n(N) {}
+  unsigned capacity() const { return m_n; }
   void push(const T &value) {
     if (this->size() == m_n) {
       this->pop_front();
@@ -76,30 +80,32 @@ private:
   void showSizeBreakdown();
   void copyPlotDataToClipboard() const;
   void savePlot();
+  /// Appends the cycles traced since the last update to the plotted data.
   void updateRatioPlot();
+  /// Renders the plotted data within the visible cycle range to the plot
+  /// series, decimated to the resolution of the plot.
+  void renderVisibleRange();
   void updatePlotAxes();
   void updateAllowedRange(const RangeChangeSource src);
   void updatePlotWarningButton();
 
-  /**
-   * @brief resampleToScreen
-   * Resamples @param series to only contain as many points as would be visible
-   * on the associated plot view
-   */
-  void resampleToScreen(QLineSeries *series);
-
   void resetRatioPlot();
   QChart *m_plot = nullptr;
   QLineSeries *m_series = nullptr;
   double m_maxY = -DBL_MAX;
   double m_minY = DBL_MAX;
   int64_t m_lastCyclePlotted = 0;
-  double m_xStep = 1.0;
-  static constexpr int s_resamplingRatio = 2;
+  // Full resolution ratio data; a point for each plotted cycle.
+  std::vector<QPointF> m_ratioData;
+  // Width of the plot area, in pixels, as of the last render.
+  int m_renderedWidth = 0;
 
   QLineSeries *m_mavgSeries = nullptr;
-  // N last computations of the change in ratio value
+  // N last computations of the change in ratio value, and their sum.
   FixedQueue<double> m_mavgData;
+  double m_mavgSum = 0;
+  // Full resolution moving average data.
+  std::vector<QPointF> m_mavgPoints;
 
   Ui::CachePlotWidget *m_ui;
   std::shared_ptr<CacheSim> m_cache;
@@ -113,6 +119,9 @@ private:
   QAction *m_mavgMarkerAction = nullptr;
 
   std::vector<QWidget *> m_rangeWidgets;
+
+  CachedSetting<int> m_maxCycles{RIPES_SETTING_CACHE_MAXCYCLES};
+  CachedSetting<int> m_maxPoints{RIPES_SETTING_CACHE_MAXPOINTS};
 };
 
 const static std::map<CachePlotWidget::Variable, QString>
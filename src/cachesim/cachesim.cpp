@@ -3,7 +3,6 @@
 
 #include "processorhandler.h"
 
-#include <QApplication>
 #include <QThread>
 #include <random>
 #include <utility>
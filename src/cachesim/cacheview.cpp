@@ -1,9 +1,10 @@
 #include "cacheview.h"
 
-#include <QGraphicsSimpleTextItem>
 #include <QWheelEvent>
 #include <qmath.h>
 
+#include "cachegraphic.h"
+
 namespace Ripes {
 
 CacheView::CacheView(QWidget *parent) : QGraphicsView(parent) {
@@ -17,15 +18,15 @@ CacheView::CacheView(QWidget *parent) : QGraphicsView(parent) {
 }
 
 void CacheView::mousePressEvent(QMouseEvent *event) {
-  // If we press on a cache data block, get the address stored for that block
-  // and emit a signal indicating that the address was selected through the
-  // cache
+  // If we press on a cache data block, get the address of that block and emit
+  // a signal indicating that the address was selected through the cache
+  const QPointF scenePos = mapToScene(event->pos());
   const auto viewItems = items(event->pos());
   for (const auto &item : qAsConst(viewItems)) {
-    if (auto *textItem = dynamic_cast<QGraphicsSimpleTextItem *>(item)) {
-      const QVariant userData = textItem->data(Qt::UserRole);
-      if (userData.isValid()) {
-        emit cacheAddressSelected(userData.toULongLong());
+    if (auto *cacheGraphic = dynamic_cast<CacheGraphic *>(item)) {
+      if (auto address =
+              cacheGraphic->addressAt(cacheGraphic->mapFromScene(scenePos))) {
+        emit cacheAddressSelected(address.value());
         break;
       }
     }
@@ -1,6 +1,7 @@
 #include "l1cacheshim.h"
 
 #include "processorhandler.h"
+#include "utilities/cycleprofiler.h"
 
 namespace Ripes {
 
@@ -45,6 +46,7 @@ void L1CacheShim::processorReversed() {
 }
 
 void L1CacheShim::processorWasClocked() {
+  CycleProfiler::Scope scope(CycleProfiler::CacheShim);
   if (m_type == CacheType::DataCache) {
     const auto dataAccess = ProcessorHandler::getProcessor()->dataMemAccess();
 
@@ -5,6 +5,7 @@
 #include "memoryviewerwidget.h"
 #include "ripessettings.h"
 
+#include <QLabel>
 #include <QTabBar>
 #include <QWheelEvent>
 
@@ -81,8 +81,7 @@ bool CCManager::trySetCC(const QString &CC) {
   return res.success;
 }
 
-CCManager::CCRes CCManager::compileRaw(const QString &rawsource,
-                                       QString outname, bool showProgressdiag) {
+QStringList CCManager::prepareSourceFiles(const QString &rawsource) {
   // Write program to temporary file with a .c extension
   if (!(m_tmpSrcFile && (QFile::exists(m_tmpSrcFile->fileName())))) {
     const auto tempFileTemplate =
@@ -109,8 +108,76 @@ CCManager::CCRes CCManager::compileRaw(const QString &rawsource,
   if (!peripheralSymbolsHeader.isEmpty()) {
     sourceFiles << peripheralSymbolsHeader;
   }
+  return sourceFiles;
+}
+
+CCManager::CCRes CCManager::compileRaw(const QString &rawsource,
+                                       QString outname, bool showProgressdiag) {
+  return compile(prepareSourceFiles(rawsource), outname, showProgressdiag);
+}
+
+void CCManager::compileAsync(const QString &rawsource, QString outname) {
+#ifdef RIPES_WITH_QPROCESS
+  // Supersede any compilation in progress before touching the temporary source
+  // and output files which it may be using.
+  abortAsync();
+
+  CCRes res;
+  res.inFiles = prepareSourceFiles(rawsource);
+  if (outname.isEmpty()) {
+    outname = QDir::tempPath() + QDir::separator() +
+              QCoreApplication::applicationName() + ".temp.out";
+    QFile::remove(outname); // Remove any previously compiled file
+  }
+  res.outFile = outname;
+  res.cc = createCompileCommand(res.inFiles, outname);
+
+  auto *process = new QProcess(this);
+  m_asyncProcess = process;
+  process->setWorkingDirectory(res.cc.bin.absolutePath());
+  process->setProgram(res.cc.bin.absoluteFilePath());
+  process->setArguments(res.cc.args);
+
+  auto onFinished = [=] {
+    if (m_asyncProcess != process)
+      return; // Superseded
+    m_asyncProcess = nullptr;
+    CCRes finishedRes = res;
+    auto elfInfo = LoadDialog::validateELFFile(QFile(finishedRes.outFile));
+    finishedRes.success = elfInfo.valid;
+    finishedRes.errorOutput.errMsg = elfInfo.errorMessage;
+    finishedRes.errorOutput._stdout = process->readAllStandardOutput();
+    finishedRes.errorOutput._stderr = process->readAllStandardError();
+    process->deleteLater();
+    emit compileFinished(finishedRes);
+  };
+  connect(process,
+          QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+          onFinished);
+  // A process which failed to start will not emit finished.
+  connect(process, &QProcess::errorOccurred, this,
+          [=](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart)
+              onFinished();
+          });
+  process->start();
+#else
+  Q_UNUSED(rawsource);
+  Q_UNUSED(outname);
+  CCRes res;
+  res.success = false;
+  emit compileFinished(res);
+#endif
+}
 
-  return compile(sourceFiles, outname, showProgressdiag);
+void CCManager::abortAsync() {
+  if (!m_asyncProcess)
+    return;
+  auto *process = m_asyncProcess;
+  m_asyncProcess = nullptr;
+  process->disconnect(this);
+  process->kill();
+  process->deleteLater();
 }
 
 CCManager::CCRes CCManager::compile(const QTextDocument *source,
@@ -42,7 +42,7 @@ public:
     bool success = false;
     bool aborted = false;
 
-    void clean() { QFile::remove(outFile); }
+    void clean() const { QFile::remove(outFile); }
   };
 
   static CCManager &get() {
@@ -69,6 +69,23 @@ public:
   CCRes compileRaw(const QString &rawsource, QString outname = QString(),
                    bool showProgressdiag = true);
 
+  /**
+   * @brief compileAsync
+   * Non-blocking variant of compileRaw. Starts the compiler on @p rawsource and
+   * returns immediately; compileFinished is emitted once the compiler has
+   * terminated. Any compilation which is still in progress is superseded by the
+   * new one; its compiler process is killed and no result is emitted for it.
+   */
+  void compileAsync(const QString &rawsource, QString outname = QString());
+
+  /**
+   * @brief abortAsync
+   * Aborts the compilation currently in progress through compileAsync, if any.
+   */
+  void abortAsync();
+
+  bool isCompiling() const { return m_asyncProcess != nullptr; }
+
   CompileCommand createCompileCommand(const QStringList &files,
                                       const QString &outname) const;
 
@@ -80,6 +97,13 @@ signals:
    */
   void ccChanged(CCManager::CCRes res);
 
+  /**
+   * @brief compileFinished
+   * Emitted whenever a compilation started through compileAsync has finished.
+   * Compiler output is provided through the errorOutput member of @p res.
+   */
+  void compileFinished(CCManager::CCRes res);
+
 public slots:
   /**
    * @brief trySetCC
@@ -103,6 +127,13 @@ private:
    */
   CCRes verifyCC(const QString &CC);
 
+  /**
+   * @brief prepareSourceFiles
+   * Writes @p rawsource to the temporary source file. @returns the set of
+   * files which are to be passed to the compiler.
+   */
+  QStringList prepareSourceFiles(const QString &rawsource);
+
   CCManager();
   QString m_currentCC;
 #ifdef RIPES_WITH_QPROCESS
@@ -111,6 +142,7 @@ private:
   bool m_errored = false;
   bool m_aborted = false;
   std::unique_ptr<QFile> m_tmpSrcFile;
+  QProcess *m_asyncProcess = nullptr;
 };
 
 } // namespace Ripes
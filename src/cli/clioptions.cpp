@@ -35,6 +35,25 @@ void addCLIOptions(QCommandLineParser &parser, Ripes::CLIModeOptions &options) {
       "Simulation timeout in milliseconds. If simulation does not finish "
       "within the specified time, it will be aborted.",
       "ms", "0"));
+  parser.addOption(QCommandLineOption(
+      "io",
+      "IO configuration file (JSON). Instantiates peripherals, scripts "
+      "peripheral inputs and records LED matrix frames. See "
+      "src/cli/ioscript.h for the file format.",
+      "path"));
+  parser.addOption(QCommandLineOption(
+      "cosim",
+      "Co-simulate the processor model in lockstep with the single-cycle "
+      "reference model, stopping at the first divergence in retired "
+      "instructions."));
+  parser.addOption(QCommandLineOption(
+      "commitlog",
+      "Commit log output file. Logs the PC, instruction word, register write "
+      "and memory access of every retired instruction.",
+      "path"));
+  parser.addOption(QCommandLineOption(
+      "commitlogformat", "Commit log format. Options: [text, bin]", "format",
+      "text"));
   parser.addOption(QCommandLineOption("v", "Verbose output"));
   parser.addOption(QCommandLineOption(
       "output", "Report output file. If not set, report is printed to stdout.",
@@ -50,7 +69,9 @@ void addCLIOptions(QCommandLineParser &parser, Ripes::CLIModeOptions &options) {
   options.telemetry.push_back(std::make_shared<IPCTelemetry>());
   options.telemetry.push_back(std::make_shared<PipelineTelemetry>());
   options.telemetry.push_back(std::make_shared<RegisterTelemetry>());
+  options.telemetry.push_back(std::make_shared<RegisterWritesTelemetry>());
   options.telemetry.push_back(std::make_shared<RunInfoTelemetry>(&parser));
+  options.telemetry.push_back(std::make_shared<ProfileTelemetry>());
 
   for (auto &telemetry : options.telemetry) {
     QString desc = "Report " + telemetry->description();
@@ -133,6 +154,18 @@ bool parseCLIOptions(QCommandLineParser &parser, QString &errorMessage,
   }
 
   options.outputFile = parser.value("output");
+  options.ioConfig = parser.value("io");
+  options.cosim = parser.isSet("cosim");
+
+  options.commitLog = parser.value("commitlog");
+  if (parser.value("commitlogformat") == "text") {
+    options.commitLogFormat = CommitLog::Format::Text;
+  } else if (parser.value("commitlogformat") == "bin") {
+    options.commitLogFormat = CommitLog::Format::Binary;
+  } else {
+    errorMessage = "Invalid commit log format (--commitlogformat)";
+    return false;
+  }
 
   // Validate register initializations
   if (parser.isSet("reginit")) {
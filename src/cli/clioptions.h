@@ -1,6 +1,7 @@
 #pragma once
 
 #include "assembler/program.h"
+#include "commitlog.h"
 #include "processorregistry.h"
 #include "telemetry.h"
 #include <QCommandLineParser>
@@ -18,6 +19,10 @@ struct CLIModeOptions {
   bool jsonOutput = false;
   int timeout = 0;
   RegisterInitialization regInit;
+  QString ioConfig = "";
+  bool cosim = false;
+  QString commitLog = "";
+  CommitLog::Format commitLogFormat = CommitLog::Format::Text;
 
   // A list of enabled telemetry options.
   std::vector<std::shared_ptr<Telemetry>> telemetry;
@@ -1,4 +1,5 @@
 #include "clirunner.h"
+#include "cosimulator.h"
 #include "io/iomanager.h"
 #include "processorhandler.h"
 #include "programutilities.h"
@@ -44,10 +45,17 @@ CLIRunner::CLIRunner(const CLIModeOptions &options)
     std::flush(std::cout);
   });
 
+  // Report simulation errors which the GUI would otherwise show in a dialog.
+  connect(ProcessorHandler::get(), &ProcessorHandler::simulationError, this,
+          [&](const QString &message) { error(message); });
+
   // TODO: how to handle system input?
 }
 
 int CLIRunner::run() {
+  if (setupIO())
+    return 1;
+
   if (processInput())
     return 1;
 
@@ -60,6 +68,20 @@ int CLIRunner::run() {
   return 0;
 }
 
+int CLIRunner::setupIO() {
+  if (m_options.ioConfig.isEmpty())
+    return 0;
+
+  info("Loading IO configuration '" + m_options.ioConfig + "'");
+  m_ioScript = std::make_unique<IOScript>();
+  QString err = m_ioScript->load(m_options.ioConfig);
+  if (!err.isEmpty()) {
+    error(err);
+    return 1;
+  }
+  return 0;
+}
+
 int CLIRunner::processInput() {
   info("Processing input file", false, true);
 
@@ -136,6 +158,35 @@ int CLIRunner::runModel() {
   if (m_options.verbose)
     infoTimer.start(1000);
 
+  if (m_ioScript) {
+    QString err = m_ioScript->attach();
+    if (!err.isEmpty()) {
+      error(err);
+      return 1;
+    }
+  }
+
+  if (!m_options.commitLog.isEmpty()) {
+    info("Writing commit log to '" + m_options.commitLog + "'");
+    m_commitLog = std::make_unique<CommitLog>();
+    QString err =
+        m_commitLog->attach(m_options.commitLog, m_options.commitLogFormat);
+    if (!err.isEmpty()) {
+      error(err);
+      return 1;
+    }
+  }
+
+  if (m_options.cosim) {
+    const int res = runCosimulation();
+    infoTimer.stop();
+    if (m_ioScript)
+      m_ioScript->finish();
+    if (m_commitLog)
+      m_commitLog->finish();
+    return res;
+  }
+
   // Start simulation
   ProcessorHandler::run();
   if (m_options.timeout != 0)
@@ -147,8 +198,15 @@ int CLIRunner::runModel() {
 
   timeoutTimer.stop();
   infoTimer.stop();
-  if (hadTimeout) {
+  if (hadTimeout)
     ProcessorHandler::stopRun();
+
+  if (m_ioScript)
+    m_ioScript->finish();
+  if (m_commitLog)
+    m_commitLog->finish();
+
+  if (hadTimeout) {
     error("Simulation did not finish within the specified timeout (" +
           QString::number(m_options.timeout) + " ms)");
     return 1;
@@ -157,6 +215,48 @@ int CLIRunner::runModel() {
   return 0;
 }
 
+int CLIRunner::runCosimulation() {
+  const auto program = ProcessorHandler::getProgram();
+  if (!program) {
+    error("No program loaded");
+    return 1;
+  }
+
+  const ProcessorID reference = ProcessorHandler::currentISA()->bits() == 64
+                                    ? ProcessorID::RV64_SS
+                                    : ProcessorID::RV32_SS;
+  info("Co-simulating against reference model '" +
+       enumToString<ProcessorID>(reference) + "'");
+  Cosimulator cosim(ProcessorHandler::getProcessorNonConst(), reference,
+                    m_options.isaExtensions);
+  cosim.load(program);
+
+  // The models are stepped on the simulation thread, in chunks of cycles.
+  // Between chunks, check for timeouts and process events, to keep status
+  // reporting alive.
+  constexpr unsigned checkInterval = 1 << 14;
+  QElapsedTimer elapsed;
+  elapsed.start();
+  for (;;) {
+    ProcessorHandler::invoke([&] { cosim.run(checkInterval); });
+    if (cosim.status() != Cosimulator::Status::Running)
+      break;
+    QCoreApplication::processEvents();
+    if (m_options.timeout != 0 && elapsed.elapsed() > m_options.timeout) {
+      error("Simulation did not finish within the specified timeout (" +
+            QString::number(m_options.timeout) + " ms)");
+      return 1;
+    }
+  }
+
+  if (cosim.status() == Cosimulator::Status::Diverged) {
+    error(cosim.divergence());
+    return 1;
+  }
+  info("Co-simulation finished without divergence");
+  return 0;
+}
+
 int CLIRunner::postRun() {
   info("Post-run", false, true);
 
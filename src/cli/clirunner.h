@@ -1,6 +1,8 @@
 #pragma once
 
 #include "clioptions.h"
+#include "commitlog.h"
+#include "ioscript.h"
 #include <QObject>
 
 namespace Ripes {
@@ -18,12 +20,19 @@ public:
   int run();
 
 private:
+  /// Instantiates IO peripherals from the IO configuration file, if provided.
+  int setupIO();
+
   /// Process the provided source file (assembling, compiling, loading, ...)
   int processInput();
 
   /// Runs the processor model until the program is finished.
   int runModel();
 
+  /// Runs the processor model in lockstep with a reference model until the
+  /// program is finished or the models diverge.
+  int runCosimulation();
+
   /// Prints requested telemetry to the console/output file.
   int postRun();
   void info(QString msg, bool alwaysPrint = false, bool header = false,
@@ -31,6 +40,8 @@ private:
   void error(const QString &msg);
 
   CLIModeOptions m_options;
+  std::unique_ptr<IOScript> m_ioScript;
+  std::unique_ptr<CommitLog> m_commitLog;
 };
 
 } // namespace Ripes
@@ -0,0 +1,116 @@
+#include "commitlog.h"
+
+#include "processorhandler.h"
+
+#include <QtEndian>
+
+namespace Ripes {
+
+// Buffered records are written to the file once the buffer exceeds this size.
+static constexpr int s_flushThreshold = 1 << 16;
+
+CommitLog::~CommitLog() { finish(); }
+
+QString CommitLog::attach(const QString &path, Format format) {
+  m_file = std::make_unique<QFile>(path);
+  if (!m_file->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    m_file.reset();
+    return "Failed to open commit log file '" + path + "'";
+  }
+  m_format = format;
+  m_xlen = ProcessorHandler::currentISA()->bits();
+  m_records = 0;
+  m_buffer.clear();
+  m_buffer.reserve(s_flushThreshold + 256);
+
+  if (m_format == Format::Binary) {
+    uchar header[8] = {'R', 'C', 'L', 'G', 1, static_cast<uchar>(m_xlen), 0,
+                       0};
+    m_buffer.append(reinterpret_cast<const char *>(header), sizeof(header));
+  }
+
+  // Retirement is reported on the simulator thread; the log is only accessed
+  // from there until finish() is called after the simulation has stopped.
+  ProcessorHandler::getProcessorNonConst()->retireHandler =
+      [=](const RetiredInstruction &retired) { this->retired(retired); };
+  return QString();
+}
+
+void CommitLog::finish() {
+  if (!m_file)
+    return;
+  ProcessorHandler::getProcessorNonConst()->retireHandler = nullptr;
+  flush();
+  m_file->close();
+  m_file.reset();
+}
+
+void CommitLog::retired(const RetiredInstruction &retired) {
+  if (m_format == Format::Text) {
+    writeText(retired);
+  } else {
+    writeBinary(retired);
+  }
+  ++m_records;
+  if (m_buffer.size() > s_flushThreshold)
+    flush();
+}
+
+void CommitLog::flush() {
+  m_file->write(m_buffer);
+  m_buffer.clear();
+}
+
+void CommitLog::writeText(const RetiredInstruction &retired) {
+  const int width = m_xlen / 4;
+  auto hex = [&](VInt value, int digits) {
+    return QByteArray::number(static_cast<qulonglong>(value), 16)
+        .rightJustified(digits, '0');
+  };
+
+  m_buffer.append("core   0: 3 0x");
+  m_buffer.append(hex(retired.pc, width));
+  m_buffer.append(" (0x");
+  m_buffer.append(hex(retired.instr, retired.instrBytes * 2));
+  m_buffer.append(')');
+  if (retired.regWrite) {
+    m_buffer.append(" x");
+    m_buffer.append(QByteArray::number(retired.rd).leftJustified(2, ' '));
+    m_buffer.append(" 0x");
+    m_buffer.append(hex(retired.rdValue, width));
+  }
+  if (retired.memAccess.type != MemoryAccess::None) {
+    m_buffer.append(" mem 0x");
+    m_buffer.append(hex(retired.memAccess.address, width));
+    if (retired.memAccess.type == MemoryAccess::Write) {
+      m_buffer.append(" 0x");
+      m_buffer.append(hex(retired.memValue, retired.memAccess.bytes * 2));
+    }
+  }
+  m_buffer.append('\n');
+}
+
+void CommitLog::writeBinary(const RetiredInstruction &retired) {
+  uchar record[48];
+  uchar flags = 0;
+  flags |= retired.regWrite ? 0b0001 : 0;
+  flags |= retired.memAccess.type == MemoryAccess::Read ? 0b0010 : 0;
+  flags |= retired.memAccess.type == MemoryAccess::Write ? 0b0100 : 0;
+  flags |= retired.instrBytes == 2 ? 0b1000 : 0;
+  const bool hasMemAccess = retired.memAccess.type != MemoryAccess::None;
+
+  qToLittleEndian<quint64>(retired.cycle, record);
+  qToLittleEndian<quint64>(retired.pc, record + 8);
+  qToLittleEndian<quint32>(retired.instr, record + 16);
+  record[20] = flags;
+  record[21] = retired.rd;
+  record[22] = hasMemAccess ? retired.memAccess.bytes : 0;
+  record[23] = 0;
+  qToLittleEndian<quint64>(retired.rdValue, record + 24);
+  qToLittleEndian<quint64>(hasMemAccess ? retired.memAccess.address : 0,
+                           record + 32);
+  qToLittleEndian<quint64>(retired.memValue, record + 40);
+  m_buffer.append(reinterpret_cast<const char *>(record), sizeof(record));
+}
+
+} // namespace Ripes
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+
+#include <memory>
+
+#include "processors/interface/ripesprocessor.h"
+
+namespace Ripes {
+
+/// The CommitLog class streams a log of every instruction retired by the
+/// current processor to a file, similar to the commit log of the Spike ISA
+/// simulator. Records are buffered in memory and written to the file in large
+/// blocks. Two formats are supported:
+///
+/// Text, one line per retired instruction:
+///   core   0: 3 <pc> (<instr>) [x<rd> <value>] [mem <address> [<value>]]
+/// where the memory value is given for stores only.
+///
+/// Binary, little-endian:
+///   header: "RCLG" | u8 version (1) | u8 XLEN | u16 reserved
+///   record: u64 cycle | u64 pc | u32 instr | u8 flags | u8 rd |
+///           u8 memory access bytes | u8 reserved | u64 rd value |
+///           u64 memory address | u64 memory value
+/// with flags: bit 0 = register write, bit 1 = memory read,
+///             bit 2 = memory write, bit 3 = compressed instruction.
+class CommitLog {
+public:
+  enum class Format { Text, Binary };
+
+  ~CommitLog();
+
+  /// Opens the log file at @p path and starts logging retired instructions of
+  /// the current processor. Returns an error message, or an empty string on
+  /// success.
+  QString attach(const QString &path, Format format);
+
+  /// Stops logging, flushes all buffered records and closes the log file.
+  void finish();
+
+  long long records() const { return m_records; }
+
+private:
+  void retired(const RetiredInstruction &retired);
+  void writeText(const RetiredInstruction &retired);
+  void writeBinary(const RetiredInstruction &retired);
+  void flush();
+
+  Format m_format = Format::Text;
+  std::unique_ptr<QFile> m_file;
+  QByteArray m_buffer;
+  unsigned m_xlen = 32;
+  long long m_records = 0;
+};
+
+} // namespace Ripes
@@ -0,0 +1,182 @@
+#include "ioscript.h"
+
+#include "io/iomanager.h"
+#include "processorhandler.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtEndian>
+
+#include <algorithm>
+
+namespace Ripes {
+
+IOScript::~IOScript() {
+  finish();
+  for (auto *peripheral : m_peripherals) {
+    delete peripheral;
+  }
+}
+
+IOBase *IOScript::findPeripheral(const QString &name) const {
+  for (auto *peripheral : m_peripherals) {
+    if (peripheral->name() == name) {
+      return peripheral;
+    }
+  }
+  return nullptr;
+}
+
+QString IOScript::load(const QString &path) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return "Failed to open IO configuration file '" + path + "'";
+  }
+  QJsonParseError parseError;
+  const auto doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+  if (doc.isNull()) {
+    return "Invalid IO configuration file: " + parseError.errorString();
+  }
+  const QJsonObject config = doc.object();
+
+  // Peripherals
+  for (const auto &periphValue : config["peripherals"].toArray()) {
+    const QJsonObject periphObj = periphValue.toObject();
+    const QString typeName = periphObj["type"].toString();
+    auto typeIt = std::find_if(
+        IOTypeTitles.begin(), IOTypeTitles.end(),
+        [&](const auto &title) { return title.second == typeName; });
+    if (typeIt == IOTypeTitles.end()) {
+      return "Unknown peripheral type '" + typeName + "'";
+    }
+
+    const unsigned id =
+        periphObj.contains("id") ? periphObj["id"].toInt() : UINT_MAX;
+    auto *peripheral = IOManager::get().createPeripheral(typeIt->first, id);
+    m_peripherals.push_back(peripheral);
+
+    const QJsonObject params = periphObj["params"].toObject();
+    for (auto it = params.begin(); it != params.end(); ++it) {
+      auto paramIt = std::find_if(
+          peripheral->parameters().begin(), peripheral->parameters().end(),
+          [&](const auto &param) { return param.second.name == it.key(); });
+      if (paramIt == peripheral->parameters().end()) {
+        return "Unknown parameter '" + it.key() + "' for peripheral '" +
+               peripheral->name() + "'";
+      }
+      peripheral->setParameter(paramIt->first, it.value().toVariant());
+    }
+  }
+
+  // Scripted inputs
+  for (const auto &inputValue : config["inputs"].toArray()) {
+    const QJsonObject inputObj = inputValue.toObject();
+    const QString periphName = inputObj["peripheral"].toString();
+    auto *peripheral = findPeripheral(periphName);
+    if (!peripheral) {
+      return "Unknown peripheral '" + periphName + "' in scripted input";
+    }
+    const QString regName = inputObj["register"].toString();
+    const auto &regs = peripheral->registers();
+    auto regIt = std::find_if(regs.begin(), regs.end(), [&](const auto &reg) {
+      return reg.name == regName;
+    });
+    if (regIt == regs.end()) {
+      return "Unknown register '" + regName + "' for peripheral '" +
+             periphName + "'";
+    }
+    m_inputs.push_back(
+        {static_cast<long long>(inputObj["cycle"].toDouble()), peripheral,
+         regIt->address, static_cast<VInt>(inputObj["value"].toDouble())});
+  }
+  std::stable_sort(
+      m_inputs.begin(), m_inputs.end(),
+      [](const Input &a, const Input &b) { return a.cycle < b.cycle; });
+
+  // Frame recording
+  if (config.contains("frames")) {
+    const QJsonObject framesObj = config["frames"].toObject();
+    const QString periphName = framesObj["peripheral"].toString();
+    m_frameSource = dynamic_cast<IOLedMatrix *>(findPeripheral(periphName));
+    if (!m_frameSource) {
+      return "Frames can only be recorded from an LED matrix; '" + periphName +
+             "' is not an LED matrix";
+    }
+    m_framePath = framesObj["file"].toString();
+  }
+
+  return QString();
+}
+
+QString IOScript::attach() {
+  if (m_frameSource) {
+    m_frameFile = std::make_unique<QFile>(m_framePath);
+    if (!m_frameFile->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      return "Failed to open frame file '" + m_framePath + "'";
+    }
+    QByteArray header("RLED");
+    uchar dims[4];
+    qToLittleEndian<quint16>(m_frameSource->matrixWidth(), dims);
+    qToLittleEndian<quint16>(m_frameSource->matrixHeight(), dims + 2);
+    header.append(reinterpret_cast<const char *>(dims), sizeof(dims));
+    m_frameFile->write(header);
+  }
+
+  const auto cycle = ProcessorHandler::getProcessor()->getCycleCount();
+  applyInputs(cycle);
+  if (m_frameSource) {
+    recordFrame(cycle);
+  }
+
+  // Processor clock signals are emitted on the simulator thread; handle them
+  // directly to apply inputs and record frames in cycle order.
+  connect(ProcessorHandler::get(), &ProcessorHandler::processorClocked, this,
+          &IOScript::processorClocked, Qt::DirectConnection);
+  return QString();
+}
+
+void IOScript::finish() {
+  disconnect(ProcessorHandler::get(), &ProcessorHandler::processorClocked,
+             this, &IOScript::processorClocked);
+  if (m_frameFile) {
+    m_frameFile->close();
+    m_frameFile.reset();
+  }
+}
+
+void IOScript::processorClocked() {
+  const auto cycle = ProcessorHandler::getProcessor()->getCycleCount();
+  applyInputs(cycle);
+  if (m_frameSource &&
+      m_frameSource->registerBlock().version() != m_lastFrameVersion) {
+    recordFrame(cycle);
+  }
+}
+
+void IOScript::applyInputs(long long cycle) {
+  while (m_nextInput < m_inputs.size() &&
+         m_inputs[m_nextInput].cycle <= cycle) {
+    const auto &input = m_inputs[m_nextInput++];
+    input.peripheral->setInput(input.offset, input.value);
+  }
+}
+
+void IOScript::recordFrame(long long cycle) {
+  const auto &regs = m_frameSource->registerBlock();
+  m_lastFrameVersion = regs.version();
+  regs.snapshot(m_frame);
+
+  m_frameBytes.resize(sizeof(quint64) + m_frame.size() * 3);
+  auto *data = reinterpret_cast<uchar *>(m_frameBytes.data());
+  qToLittleEndian<quint64>(cycle, data);
+  data += sizeof(quint64);
+  for (uint32_t led : m_frame) {
+    *data++ = (led >> 16) & 0xFF;
+    *data++ = (led >> 8) & 0xFF;
+    *data++ = led & 0xFF;
+  }
+  m_frameFile->write(m_frameBytes);
+}
+
+} // namespace Ripes
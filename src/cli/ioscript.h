@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QFile>
+#include <QObject>
+
+#include <memory>
+
+#include "io/iobase.h"
+
+namespace Ripes {
+
+class IOLedMatrix;
+
+/// The IOScript class provides IO peripherals to CLI runs. Peripherals are
+/// instantiated from a JSON configuration file, which may also script
+/// peripheral inputs over time and request LED matrix frames to be recorded to
+/// a file. The configuration file has the following format:
+///
+/// {
+///   "peripherals": [
+///     {"type": "LED Matrix", "params": {"Width": 8, "Height": 8}},
+///     {"type": "Switches", "id": 0}
+///   ],
+///   "inputs": [
+///     {"cycle": 100, "peripheral": "Switches 0", "register": "Switches",
+///      "value": 5}
+///   ],
+///   "frames": {"peripheral": "LED Matrix 0", "file": "frames.bin"}
+/// }
+///
+/// Peripherals are referenced by their unique name (IOBase::name()), and
+/// registers by the names given in their register map.
+///
+/// Frames are recorded whenever the LED matrix registers change, in the
+/// following compact little-endian binary format:
+///   header: "RLED" | u16 width | u16 height
+///   frame:  u64 cycle | width * height * {u8 R, u8 G, u8 B}
+class IOScript : public QObject {
+  Q_OBJECT
+public:
+  ~IOScript();
+
+  /// Loads the configuration at @p path and instantiates its peripherals.
+  /// Returns an error message, or an empty string on success.
+  QString load(const QString &path);
+
+  /// Starts applying scripted inputs and recording frames as the processor is
+  /// clocked. Returns an error message, or an empty string on success.
+  QString attach();
+
+  /// Stops recording frames and closes the frame file.
+  void finish();
+
+private:
+  struct Input {
+    long long cycle;
+    IOBase *peripheral;
+    AInt offset;
+    VInt value;
+  };
+
+  IOBase *findPeripheral(const QString &name) const;
+  void processorClocked();
+  void applyInputs(long long cycle);
+  void recordFrame(long long cycle);
+
+  std::vector<IOBase *> m_peripherals;
+
+  /// Scripted inputs, sorted by cycle.
+  std::vector<Input> m_inputs;
+  size_t m_nextInput = 0;
+
+  IOLedMatrix *m_frameSource = nullptr;
+  QString m_framePath;
+  std::unique_ptr<QFile> m_frameFile;
+  unsigned m_lastFrameVersion = 0;
+  std::vector<uint32_t> m_frame;
+  QByteArray m_frameBytes;
+};
+
+} // namespace Ripes
@@ -8,4 +8,11 @@ namespace Ripes {
 QString loadFlatBinaryFile(Program &program, const QString &filepath,
                            unsigned long entryPoint, unsigned long loadAt);
 
+/// Loads the sections, function symbols and entry point of the ELF file @p
+/// file into @p program. If the ELF file contains debug information for a
+/// source file originating from the Ripes editor, the source mapping of the
+/// program is loaded as well. Returns an error message if the file could not
+/// be loaded.
+QString loadElfFile(Program &program, QFile &file);
+
 } // namespace Ripes
@@ -5,7 +5,9 @@
 #include "pipelinediagrammodel.h"
 #include "processorhandler.h"
 #include "radix.h"
+#include "utilities/cycleprofiler.h"
 
+#include <algorithm>
 #include <memory>
 
 namespace Ripes {
@@ -137,6 +139,61 @@ public:
   }
 };
 
+class RegisterWritesTelemetry : public Telemetry {
+public:
+  QString key() const override { return "regwrites"; }
+  QString prettyKey() const override { return "# register writes"; }
+  QString description() const override { return "register writes"; }
+  QVariant report(bool /*json*/) override {
+    return QVariant::fromValue(ProcessorHandler::getProcessor()
+                                   ->registerJournal()
+                                   .writesRecorded());
+  }
+};
+
+class ProfileTelemetry : public Telemetry {
+public:
+  void enable() override {
+    CycleProfiler::reset();
+    CycleProfiler::setEnabled(true);
+    Telemetry::enable();
+  }
+  void disable() override {
+    CycleProfiler::setEnabled(false);
+    Telemetry::disable();
+  }
+
+  QString key() const override { return "profile"; }
+  QString prettyKey() const override { return "cycle profile"; }
+  QString description() const override {
+    return "per-cycle simulation cost breakdown (ns/cycle)";
+  }
+  QVariant report(bool /*json*/) override {
+    const uint64_t cycles = CycleProfiler::calls(CycleProfiler::Cycle);
+    auto nsPerCycle = [&](double ns) {
+      return cycles == 0 ? 0.0 : std::max(0.0, ns / cycles);
+    };
+    auto regionNs = [](CycleProfiler::Region region) {
+      return static_cast<double>(CycleProfiler::nanoseconds(region));
+    };
+
+    QVariantMap m;
+    for (int i = 0; i < CycleProfiler::NumRegions; ++i) {
+      const auto region = static_cast<CycleProfiler::Region>(i);
+      m[CycleProfiler::name(region)] = nsPerCycle(regionNs(region));
+    }
+    // Regions are nested; derive the exclusive cost of component propagation
+    // and of the work performed by Ripes outside of the design.
+    m["propagation"] = nsPerCycle(regionNs(CycleProfiler::DesignClock) -
+                                  regionNs(CycleProfiler::ClockedSignal) -
+                                  regionNs(CycleProfiler::Syscall));
+    m["outside design"] = nsPerCycle(regionNs(CycleProfiler::Cycle) -
+                                     regionNs(CycleProfiler::DesignClock));
+    m["cycles profiled"] = QVariant::fromValue(cycles);
+    return m;
+  }
+};
+
 class RunInfoTelemetry : public Telemetry {
 public:
   RunInfoTelemetry(QCommandLineParser *parser) {
@@ -1,5 +1,6 @@
 #include "console.h"
 
+#include "consoleoutputbuffer.h"
 #include "fonts.h"
 #include "ripessettings.h"
 
@@ -15,7 +16,13 @@ Console::Console(QWidget *parent) : QPlainTextEdit(parent) {
   }
   setFont(m_font);
 
-  document()->setMaximumBlockCount(100);
+  // Limit the scrollback of the console.
+  connect(RipesSettings::getObserver(RIPES_SETTING_CONSOLE_SCROLLBACK),
+          &SettingObserver::modified, this, [=](const QVariant &value) {
+            document()->setMaximumBlockCount(value.toInt());
+          });
+  document()->setMaximumBlockCount(
+      RipesSettings::value(RIPES_SETTING_CONSOLE_SCROLLBACK).toInt());
 
   auto paletteChangeFunctor = [=] {
     QPalette p = palette();
@@ -46,17 +53,37 @@ Console::Console(QWidget *parent) : QPlainTextEdit(parent) {
 }
 
 void Console::putData(const QByteArray &bytes) {
+  putText(QString::fromUtf8(bytes));
+}
+
+void Console::putText(const QString &text) {
+  // Lines exceeding the scrollback of the console would be removed right after
+  // being inserted; only insert the lines which are retained.
+  QStringView toInsert = text;
+  const int maxLines = document()->maximumBlockCount();
+  if (maxLines > 0) {
+    int newlines = 0;
+    for (int i = text.size() - 1; i >= 0; --i) {
+      if (text.at(i) == '\n' && ++newlines == maxLines) {
+        toInsert = toInsert.mid(i + 1);
+        break;
+      }
+    }
+  }
+
   // Text can always only be inserted at the end of the console
   auto cursorAtEnd = QTextCursor(document());
   cursorAtEnd.movePosition(QTextCursor::End);
   setTextCursor(cursorAtEnd);
-  insertPlainText(bytes);
+  insertPlainText(toInsert.toString());
 
   QScrollBar *bar = verticalScrollBar();
   bar->setValue(bar->maximum());
 }
 
 void Console::clearConsole() {
+  // Output which is not yet flushed to the console would otherwise reappear.
+  ConsoleOutputBuffer::get().discard();
   clear();
   m_buffer.clear();
 }
@@ -16,6 +16,7 @@ signals:
 public:
   Console(QWidget *parent = nullptr);
   void putData(const QByteArray &data);
+  void putText(const QString &text);
   void clearConsole();
 
 protected:
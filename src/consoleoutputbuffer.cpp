@@ -0,0 +1,95 @@
+#include "consoleoutputbuffer.h"
+
+#include "ripessettings.h"
+#include "syscall/systemio.h"
+
+#include <QMutexLocker>
+
+namespace Ripes {
+
+ConsoleOutputBuffer::ConsoleOutputBuffer() {
+  m_flushTimer.setSingleShot(true);
+  m_flushTimer.setInterval(
+      1000.0 / RipesSettings::value(RIPES_SETTING_UIUPDATEPS).toInt());
+  connect(RipesSettings::getObserver(RIPES_SETTING_UIUPDATEPS),
+          &SettingObserver::modified, this, [=] {
+            m_flushTimer.setInterval(
+                1000.0 /
+                RipesSettings::value(RIPES_SETTING_UIUPDATEPS).toInt());
+          });
+  connect(&m_flushTimer, &QTimer::timeout, this, &ConsoleOutputBuffer::flush);
+
+  // The output file is (re)created once output is first written to it. The
+  // setting is only modified once editing of the path has finished.
+  connect(RipesSettings::getObserver(RIPES_SETTING_CONSOLE_OUTPUTFILE),
+          &SettingObserver::modified, this, [=](const QVariant &value) {
+            flush();
+            m_outputFile.reset();
+            m_outputPath = value.toString();
+          });
+  m_outputPath =
+      RipesSettings::value(RIPES_SETTING_CONSOLE_OUTPUTFILE).toString();
+
+  // Printing is performed on the thread executing the syscall; buffer the
+  // output directly rather than queueing an event for each print.
+  connect(&SystemIO::get(), &SystemIO::doPrint, this,
+          &ConsoleOutputBuffer::append, Qt::DirectConnection);
+}
+
+void ConsoleOutputBuffer::append(const QString &text) {
+  QMutexLocker lock(&m_lock);
+  const bool wasEmpty = m_pending.isEmpty();
+  m_pending += text;
+  if (wasEmpty && !text.isEmpty()) {
+    // Schedule a flush of the buffer. The timer is owned by the GUI thread.
+    QMetaObject::invokeMethod(
+        this,
+        [=] {
+          if (!m_flushTimer.isActive())
+            m_flushTimer.start();
+        },
+        Qt::QueuedConnection);
+  }
+}
+
+void ConsoleOutputBuffer::flush() {
+  QString text;
+  {
+    QMutexLocker lock(&m_lock);
+    text.swap(m_pending);
+  }
+  if (text.isEmpty())
+    return;
+
+  writeToOutputFile(text);
+  emit flushed(text);
+}
+
+void ConsoleOutputBuffer::discard() {
+  QString text;
+  {
+    QMutexLocker lock(&m_lock);
+    text.swap(m_pending);
+  }
+  m_flushTimer.stop();
+  if (!text.isEmpty())
+    writeToOutputFile(text);
+}
+
+void ConsoleOutputBuffer::writeToOutputFile(const QString &text) {
+  if (!m_outputFile && !m_outputPath.isEmpty()) {
+    m_outputFile = std::make_unique<QFile>(m_outputPath);
+    if (!m_outputFile->open(QIODevice::WriteOnly | QIODevice::Truncate |
+                            QIODevice::Text)) {
+      m_outputFile.reset();
+      // Don't retry until the path is changed.
+      m_outputPath.clear();
+    }
+  }
+  if (m_outputFile) {
+    m_outputFile->write(text.toUtf8());
+    m_outputFile->flush();
+  }
+}
+
+} // namespace Ripes
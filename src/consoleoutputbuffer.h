@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QFile>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include <memory>
+
+namespace Ripes {
+
+/**
+ * @brief The ConsoleOutputBuffer class
+ * Buffers the output printed by the simulated program (through
+ * SystemIO::doPrint) before it is rendered in the consoles. Output may be
+ * printed from the simulator thread at any rate; it is coalesced and flushed
+ * to the consoles at most at the UI update rate.
+ *
+ * If an output file is configured (RIPES_SETTING_CONSOLE_OUTPUTFILE), all
+ * output is additionally written to that file, regardless of the scrollback
+ * limit of the consoles.
+ */
+class ConsoleOutputBuffer : public QObject {
+  Q_OBJECT
+
+public:
+  static ConsoleOutputBuffer &get() {
+    static ConsoleOutputBuffer buffer;
+    return buffer;
+  }
+
+  /// Appends @p text to the buffer. May be called from any thread.
+  void append(const QString &text);
+
+  /// Flushes any buffered output.
+  void flush();
+
+  /// Drops any buffered output which has not yet been flushed to the consoles.
+  /// The output is still written to the output file, if configured.
+  void discard();
+
+signals:
+  /// Emitted in the GUI thread with the output buffered since the last flush.
+  void flushed(const QString &text);
+
+private:
+  ConsoleOutputBuffer();
+  void writeToOutputFile(const QString &text);
+
+  QMutex m_lock;
+  QString m_pending;
+  QTimer m_flushTimer;
+  QString m_outputPath;
+  std::unique_ptr<QFile> m_outputFile;
+};
+
+} // namespace Ripes
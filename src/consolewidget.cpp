@@ -2,6 +2,7 @@
 #include "ui_consolewidget.h"
 
 #include "console.h"
+#include "consoleoutputbuffer.h"
 #include "fonts.h"
 #include "ripessettings.h"
 #include "syscall/systemio.h"
@@ -24,9 +25,10 @@ ConsoleWidget::ConsoleWidget(QWidget *parent)
   connect(m_ui->console, &Console::sendData, &SystemIO::get(),
           &SystemIO::putStdInData);
 
-  // Print output data from SystemIO in the console.
-  connect(&SystemIO::get(), &SystemIO::doPrint, m_ui->console,
-          [&](auto text) { m_ui->console->putData(text.toUtf8()); });
+  // Print output data from SystemIO in the console. Output is buffered and
+  // flushed to the console at the UI update rate.
+  connect(&ConsoleOutputBuffer::get(), &ConsoleOutputBuffer::flushed,
+          m_ui->console, &Console::putText);
 }
 
 ConsoleWidget::~ConsoleWidget() { delete m_ui; }
@@ -0,0 +1,262 @@
+#include "cosimulator.h"
+
+#include "isa/rvisainfo_common.h"
+#include "processors/ripesvsrtlprocessor.h"
+
+namespace Ripes {
+
+// Maximum number of cycles which the reference may be advanced while searching
+// for its next retired instruction. Guards against waiting indefinitely on a
+// reference which has stopped retiring instructions.
+static constexpr unsigned s_maxReferenceLag = 1 << 16;
+
+static QString hexStr(VInt value) { return "0x" + QString::number(value, 16); }
+
+static QString retiredStr(const RetiredInstruction &retired) {
+  QString str = "PC " + hexStr(retired.pc) + " (" + hexStr(retired.instr) + ")";
+  if (retired.regWrite)
+    str += ", x" + QString::number(retired.rd) + " = " +
+           hexStr(retired.rdValue);
+  switch (retired.memAccess.type) {
+  case MemoryAccess::Read:
+    str += ", read " + QString::number(retired.memAccess.bytes) +
+           " bytes at " + hexStr(retired.memAccess.address);
+    break;
+  case MemoryAccess::Write:
+    str += ", wrote " + hexStr(retired.memValue) + " to " +
+           hexStr(retired.memAccess.address);
+    break;
+  case MemoryAccess::None:
+    break;
+  }
+  return str;
+}
+
+/// Returns true if two retired instructions have the same architectural
+/// effects. The cycle of retirement is model specific, and not compared.
+static bool sameEffects(const RetiredInstruction &lhs,
+                        const RetiredInstruction &rhs) {
+  if (lhs.pc != rhs.pc || lhs.instr != rhs.instr ||
+      lhs.regWrite != rhs.regWrite ||
+      lhs.memAccess.type != rhs.memAccess.type)
+    return false;
+  if (lhs.regWrite && (lhs.rd != rhs.rd || lhs.rdValue != rhs.rdValue))
+    return false;
+  if (lhs.memAccess.type != MemoryAccess::None &&
+      (lhs.memAccess.address != rhs.memAccess.address ||
+       lhs.memAccess.bytes != rhs.memAccess.bytes))
+    return false;
+  if (lhs.memAccess.type == MemoryAccess::Write &&
+      lhs.memValue != rhs.memValue)
+    return false;
+  return true;
+}
+
+Cosimulator::Cosimulator(RipesProcessor *target, ProcessorID reference,
+                         const QStringList &extensions)
+    : m_target(target) {
+  m_reference = ProcessorRegistry::constructProcessor(reference, extensions);
+  m_reference->trapHandler = [=] { m_referenceTrapped = true; };
+  m_reference->retireHandler = [=](const RetiredInstruction &retired) {
+    m_referenceRetired.push_back(retired);
+  };
+  m_reference->postConstruct();
+  // The reference is never visualized; avoid the cost of signal emission.
+  if (auto *design = dynamic_cast<vsrtl::SimDesign *>(m_reference.get()))
+    design->setEnableSignals(false);
+
+  m_regCnt = m_target->implementsISA()->regCnt();
+
+  // Processor models refer to their trap handler by address, so the handlers
+  // are wrapped in place.
+  m_targetTrapHandler = m_target->trapHandler;
+  m_target->trapHandler = [=] { targetTrap(); };
+  m_targetRetireHandler = m_target->retireHandler;
+  m_target->retireHandler = [=](const RetiredInstruction &retired) {
+    if (m_targetRetireHandler)
+      m_targetRetireHandler(retired);
+    m_targetRetired.push_back(retired);
+  };
+}
+
+Cosimulator::~Cosimulator() {
+  m_target->trapHandler = m_targetTrapHandler;
+  m_target->retireHandler = m_targetRetireHandler;
+}
+
+void Cosimulator::load(const std::shared_ptr<const Program> &program) {
+  m_program = program;
+  auto &mem = m_reference->getMemory();
+  mem.clearInitializationMemories();
+  for (const auto &seg : m_program->sections) {
+    mem.addInitializationMemory(seg.second.address, seg.second.data.data(),
+                                seg.second.data.length());
+  }
+  m_reference->setPCInitialValue(m_program->entryPoint);
+
+  AddressRanges executableRanges;
+  if (const auto *textSection = m_program->getSection(TEXT_SECTION_NAME)) {
+    executableRanges.add(textSection->address,
+                         textSection->address + textSection->data.length());
+  }
+  m_reference->setExecutableRanges(executableRanges);
+  m_reference->resetProcessor();
+
+  // Start both models from the (reset) register state of the target.
+  for (unsigned i = 0; i < m_regCnt; ++i) {
+    m_reference->setRegister(RegisterFileType::GPR, i,
+                             m_target->getRegister(RegisterFileType::GPR, i));
+  }
+
+  m_referenceRetired.clear();
+  m_targetRetired.clear();
+  m_matched = 0;
+  m_referenceTrapped = false;
+  m_exited = false;
+  m_divergence.clear();
+  m_status = Status::Running;
+}
+
+bool Cosimulator::stepReference() {
+  if (m_referenceTrapped || m_reference->finished())
+    return false;
+
+  m_reference->clock();
+  return true;
+}
+
+bool Cosimulator::pullReference() {
+  unsigned lag = 0;
+  while (m_referenceRetired.empty()) {
+    if (++lag > s_maxReferenceLag || !stepReference())
+      return false;
+  }
+  return true;
+}
+
+void Cosimulator::targetTrap() {
+  const unsigned syscallReg = m_target->implementsISA()->syscallReg();
+  const VInt function =
+      m_target->getRegister(RegisterFileType::GPR, syscallReg);
+
+  // Advance the reference to its corresponding system call. Any instructions
+  // retired on the way are enqueued for the target to match.
+  unsigned lag = 0;
+  while (m_status == Status::Running && !m_referenceTrapped) {
+    if (++lag > s_maxReferenceLag || !stepReference()) {
+      diverge("Target executed system call " + QString::number(function) +
+              ", which the reference model did not execute.");
+    }
+  }
+  if (m_status == Status::Running &&
+      m_reference->getRegister(RegisterFileType::GPR, syscallReg) !=
+          function) {
+    diverge("Target executed system call " + QString::number(function) +
+            ", while the reference model executed system call " +
+            QString::number(m_reference->getRegister(RegisterFileType::GPR,
+                                                     syscallReg)) +
+            ".");
+  }
+
+  std::vector<VInt> preTrapRegs(m_regCnt);
+  for (unsigned i = 0; i < m_regCnt; ++i)
+    preTrapRegs[i] = m_target->getRegister(RegisterFileType::GPR, i);
+
+  if (m_targetTrapHandler)
+    m_targetTrapHandler();
+
+  if (m_status != Status::Running)
+    return;
+
+  // Replicate the effects of the system call onto the reference, and resume
+  // it.
+  for (unsigned i = 0; i < m_regCnt; ++i) {
+    const VInt value = m_target->getRegister(RegisterFileType::GPR, i);
+    if (value != preTrapRegs[i])
+      m_reference->setRegister(RegisterFileType::GPR, i, value);
+  }
+  /// @todo: Generalize this by having ISA report exit syscall codes
+  if (function == RVABI::SysCall::Exit || function == RVABI::SysCall::Exit2) {
+    m_reference->finalize(RipesProcessor::FinalizeReason::exitSyscall);
+    m_exited = true;
+  }
+  m_referenceTrapped = false;
+}
+
+Cosimulator::Status Cosimulator::step() {
+  if (m_status != Status::Running)
+    return m_status;
+
+  m_targetRetired.clear();
+  m_target->clock();
+  if (m_status != Status::Running)
+    return m_status;
+
+  // Instructions are retired in program order by both models; each instruction
+  // retired by the target must match the next one retired by the reference.
+  for (const auto &actual : m_targetRetired) {
+    if (!pullReference()) {
+      diverge("Target retired instruction #" + QString::number(m_matched) +
+              " (" + retiredStr(actual) +
+              "), but the reference model retired no further instructions.");
+      return m_status;
+    }
+    const auto &expected = m_referenceRetired.front();
+    if (!sameEffects(expected, actual)) {
+      diverge("Retired instruction #" + QString::number(m_matched) +
+              " differs.\n\tExpected: " + retiredStr(expected) +
+              "\n\tActual:   " + retiredStr(actual));
+      return m_status;
+    }
+    m_referenceRetired.pop_front();
+    ++m_matched;
+  }
+
+  if (m_target->finished()) {
+    // The reference must not retire any instructions beyond those of the
+    // target. Following an exit system call, the reference is not advanced
+    // any further.
+    if (!m_referenceRetired.empty() || (!m_exited && pullReference())) {
+      diverge("Target finished, but the reference model retired " +
+              retiredStr(m_referenceRetired.front()) + ".");
+    } else {
+      m_status = Status::Finished;
+    }
+  }
+
+  return m_status;
+}
+
+Cosimulator::Status Cosimulator::run(unsigned long long maxCycles) {
+  for (unsigned long long cycle = 0; cycle < maxCycles; ++cycle) {
+    if (step() != Status::Running)
+      break;
+  }
+  return m_status;
+}
+
+void Cosimulator::diverge(const QString &reason) {
+  m_status = Status::Diverged;
+  m_divergence = "Co-simulation divergence: " + reason;
+  m_divergence += "\n\tTarget:    cycle " +
+                  QString::number(m_target->getCycleCount()) + ", " +
+                  QString::number(m_target->getInstructionsRetired()) +
+                  " instructions retired";
+  m_divergence += "\n\tReference: cycle " +
+                  QString::number(m_reference->getCycleCount()) + ", " +
+                  QString::number(m_reference->getInstructionsRetired()) +
+                  " instructions retired, PC 0x" +
+                  QString::number(m_reference->getPcForStage({0, 0}), 16);
+  m_divergence += "\n\tRegister differences:";
+  for (unsigned i = 0; i < m_regCnt; ++i) {
+    const VInt lhs = m_target->getRegister(RegisterFileType::GPR, i);
+    const VInt rhs = m_reference->getRegister(RegisterFileType::GPR, i);
+    if (lhs != rhs) {
+      m_divergence += "\n\t\tx" + QString::number(i) + ": expected 0x" +
+                      QString::number(rhs, 16) + ", actual 0x" +
+                      QString::number(lhs, 16);
+    }
+  }
+}
+
+} // namespace Ripes
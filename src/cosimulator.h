@@ -0,0 +1,114 @@
+#pragma once
+
+#include <QString>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "assembler/program.h"
+#include "processorregistry.h"
+#include "processors/interface/ripesprocessor.h"
+
+namespace Ripes {
+
+/**
+ * @brief The Cosimulator class
+ * Executes a target processor model in lockstep with a reference model (ie.
+ * the single-cycle processor), stopping at the first point where the
+ * architectural state of the two diverges.
+ *
+ * The models are matched on the instructions which they retire, as reported
+ * through RipesProcessor::retireHandler: every instruction retired by the
+ * target must have the same PC, instruction word, register write and data
+ * memory access as the next instruction retired by the reference. The
+ * reference is advanced on demand, such that it only runs as far ahead of the
+ * target as the target's pipeline is deep. Thus, memory usage is constant with
+ * respect to the length of the simulation.
+ *
+ * The target is driven by the caller (typically the processor owned by the
+ * ProcessorHandler), and handles system calls as usual. Its trap handler is
+ * wrapped such that the reference is stalled at each system call until the
+ * target executes the same call, after which the register modifications made
+ * by the system call are replicated to the reference. Any retire handler
+ * already set on the target keeps being invoked.
+ */
+class Cosimulator {
+public:
+  enum class Status { Running, Finished, Diverged };
+
+  /**
+   * @param target: processor to verify. Must be loaded with a program and
+   * reset before load() is called, and must outlive the Cosimulator.
+   * @param reference: processor model to verify against.
+   * @param extensions: ISA extensions to instantiate the reference with.
+   */
+  Cosimulator(RipesProcessor *target, ProcessorID reference,
+              const QStringList &extensions);
+  ~Cosimulator();
+
+  /**
+   * @brief load
+   * Loads @p program into the reference model and resets it. The initial
+   * register state of the reference is copied from the target.
+   */
+  void load(const std::shared_ptr<const Program> &program);
+
+  /**
+   * @brief step
+   * Clocks the target a single cycle and verifies the instructions it retired
+   * against the reference.
+   */
+  Status step();
+
+  /**
+   * @brief run
+   * Steps the target until it finishes, diverges or @p maxCycles is reached.
+   */
+  Status run(unsigned long long maxCycles);
+
+  Status status() const { return m_status; }
+
+  /// Returns a report of the divergence, if the models diverged.
+  const QString &divergence() const { return m_divergence; }
+
+  const RipesProcessor *reference() const { return m_reference.get(); }
+
+private:
+  /// Clocks the reference a single cycle. Returns false if the reference
+  /// cannot advance.
+  bool stepReference();
+  /// Ensures that at least one instruction retired by the reference is pending.
+  /// Returns false if the reference cannot retire any further instructions.
+  bool pullReference();
+  void targetTrap();
+  /// Stops co-simulation, reporting @p reason alongside the state of both
+  /// models.
+  void diverge(const QString &reason);
+
+  RipesProcessor *m_target = nullptr;
+  std::unique_ptr<RipesProcessor> m_reference;
+  std::shared_ptr<const Program> m_program;
+  std::function<void(void)> m_targetTrapHandler;
+  std::function<void(const RetiredInstruction &)> m_targetRetireHandler;
+  unsigned m_regCnt = 0;
+
+  Status m_status = Status::Running;
+  QString m_divergence;
+
+  // Instructions retired by the reference which are not yet matched by the
+  // target. Bounded by the number of instructions in flight within the target.
+  std::deque<RetiredInstruction> m_referenceRetired;
+  // Instructions retired by the target in its current cycle.
+  std::vector<RetiredInstruction> m_targetRetired;
+  // Number of instructions matched between the two models.
+  long long m_matched = 0;
+  // Set when the reference has executed a system call which the target has not
+  // yet executed.
+  bool m_referenceTrapped = false;
+  // Set when the target has executed an exit system call.
+  bool m_exited = false;
+};
+
+} // namespace Ripes
@@ -38,6 +38,21 @@ CodeEditor::CodeEditor(QWidget *parent) : HighlightableTextEdit(parent) {
   connect(ProcessorHandler::get(), &ProcessorHandler::procStateChangedNonRun,
           this, &CodeEditor::updateHighlighting);
 
+  // Source/program synchronization is only reevaluated once the document or
+  // the program has changed.
+  connect(ProcessorHandler::get(), &ProcessorHandler::programChanged, this,
+          [=] { m_sourceInSync.reset(); });
+  connect(document(), &QTextDocument::contentsChange, this,
+          [=](int /*pos*/, int charsRemoved, int charsAdded) {
+            if (charsRemoved == 0 && charsAdded == 0)
+              return;
+            m_sourceInSync.reset();
+            // Mirrors HighlightableTextEdit, which drops all block highlights
+            // on edits that change the length of the document.
+            if (charsRemoved != charsAdded)
+              m_stageHighlights.clear();
+          });
+
   // Set font for the entire widget. calls to fontMetrics() will get the
   // dimensions of the currently set font
   m_font = QFont(Fonts::monospace, 11);
@@ -309,7 +324,7 @@ bool CodeEditor::eventFilter(QObject * /*observed*/, QEvent *event) {
 
 void CodeEditor::rehighlight() {
   if (m_highlighter) {
-    m_highlighter->rehighlight();
+    m_highlighter->rehighlightErrors();
   }
 }
 
@@ -321,8 +336,8 @@ bool CodeEditor::event(QEvent *event) {
     QTextCursor textAtCursor = cursorForPosition(helpEvent->pos());
     const int row = textAtCursor.block().firstLineNumber();
 
-    if (m_errors && m_errors->toMap().count(row) != 0) {
-      QToolTip::showText(helpEvent->globalPos(), m_errors->toMap().at(row));
+    if (const QString *error = m_errors ? m_errors->errorAt(row) : nullptr) {
+      QToolTip::showText(helpEvent->globalPos(), *error);
     } else {
       QToolTip::hideText();
       event->ignore();
@@ -421,54 +436,68 @@ void CodeEditor::lineNumberAreaPaintEvent(QPaintEvent *event) {
   }
 }
 
-void CodeEditor::updateHighlighting() {
-  clearBlockHighlights();
-
-  if (!RipesSettings::value(RIPES_SETTING_EDITORSTAGEHIGHLIGHTING).toBool())
-    return;
-
-  auto *proc = ProcessorHandler::getProcessor();
-  auto program = ProcessorHandler::getProgram().get();
+bool CodeEditor::isSourceInSync(const Program &program) {
+  if (!m_sourceInSync.has_value())
+    m_sourceInSync = program.isSameSource(document()->toPlainText().toUtf8());
+  return m_sourceInSync.value();
+}
 
+void CodeEditor::updateHighlighting() {
+  // Determine the stage highlights of each source line.
+  std::map<unsigned, StageHighlight> highlights;
+  auto program = ProcessorHandler::getProgram();
   // Is the current source in sync with the in-memory source?
-  if (!program || !program->isSameSource(document()->toPlainText().toUtf8()))
-    return;
+  if (m_stageHighlightingEnabled.value() && program &&
+      isSourceInSync(*program)) {
+    auto *proc = ProcessorHandler::getProcessor();
+    const auto &sourceLineIndex = program->getSourceLineIndex();
+
+    // Iterate over the processor stages and use the source mappings to
+    // determine the source line which originated the instruction. Do nothing
+    // if no source mappings are available.
+    const unsigned stages = proc->structure().numStages();
+    auto colorGenerator = Colors::incrementalRedGenerator(stages);
+    for (auto sid : proc->structure().stageIt()) {
+      if (sourceLineIndex.empty())
+        break;
+      const auto stageInfo = proc->stageInfo(sid);
+      QColor stageColor = colorGenerator();
+      if (!stageInfo.stage_valid)
+        continue;
 
-  auto sourceMapping = program->sourceMapping;
+      // Record the stage name for the highlighted block for later painting
+      QString stageString = proc->stageName(sid);
+      if (!stageInfo.namedState.isEmpty())
+        stageString += " (" + stageInfo.namedState + ")";
+      for (auto sourceLine : sourceLineIndex.lines(stageInfo.pc)) {
+        auto &highlight = highlights[sourceLine];
+        if (highlight.stages.isEmpty())
+          highlight.color = stageColor;
+        highlight.stages << stageString;
+      }
+    }
+  }
 
-  // Do nothing if no soruce mappings are available.
-  if (sourceMapping.empty())
+  if (highlights == m_stageHighlights)
     return;
 
-  // Iterate over the processor stages and use the source mappings to determine
-  // the source line which originated the instruction.
-  const unsigned stages = proc->structure().numStages();
-  auto colorGenerator = Colors::incrementalRedGenerator(stages);
-
-  for (auto sid : proc->structure().stageIt()) {
-    const auto stageInfo = proc->stageInfo(sid);
-    QColor stageColor = colorGenerator();
-    if (stageInfo.stage_valid) {
-      auto mappingIt = sourceMapping.find(stageInfo.pc);
-      if (mappingIt == sourceMapping.end()) {
-        // No source line registerred for this PC.
+  // Only rehighlight the blocks whose stage assignment changed.
+  changeHighlights([&] {
+    for (const auto &[sourceLine, highlight] : m_stageHighlights) {
+      auto it = highlights.find(sourceLine);
+      if (it == highlights.end() || it->second != highlight)
+        removeBlockHighlight(document()->findBlockByLineNumber(sourceLine));
+    }
+    for (const auto &[sourceLine, highlight] : highlights) {
+      auto it = m_stageHighlights.find(sourceLine);
+      if (it != m_stageHighlights.end() && it->second == highlight)
         continue;
-      }
-
-      for (auto sourceLine : mappingIt->second) {
-        // Find block
-        QTextBlock block = document()->findBlockByLineNumber(sourceLine);
-        if (!block.isValid())
-          continue;
-
-        // Record the stage name for the highlighted block for later painting
-        QString stageString = ProcessorHandler::getProcessor()->stageName(sid);
-        if (!stageInfo.namedState.isEmpty())
-          stageString += " (" + stageInfo.namedState + ")";
-        highlightBlock(block, stageColor, stageString);
-      }
+      QTextBlock block = document()->findBlockByLineNumber(sourceLine);
+      for (const auto &stageString : highlight.stages)
+        highlightBlock(block, highlight.color, stageString);
     }
-  }
+  });
+  m_stageHighlights = std::move(highlights);
 }
 
 } // namespace Ripes
@@ -9,9 +9,12 @@
 #include "assembler/program.h"
 
 #include "highlightabletextedit.h"
+#include "ripessettings.h"
 #include "syntaxhighlighter.h"
 
+#include <map>
 #include <memory>
+#include <optional>
 #include <set>
 
 // Extended version of Qt's CodeEditor example
@@ -68,6 +71,27 @@ private:
   SourceType m_sourceType = SourceType::Assembly;
   std::shared_ptr<Assembler::Errors> m_errors;
 
+  /// Returns whether the document is in sync with the source of @p program.
+  /// The result is cached until the document or the program changes.
+  bool isSourceInSync(const Program &program);
+  std::optional<bool> m_sourceInSync;
+
+  struct StageHighlight {
+    QColor color;
+    QStringList stages;
+    bool operator==(const StageHighlight &other) const {
+      return color == other.color && stages == other.stages;
+    }
+    bool operator!=(const StageHighlight &other) const {
+      return !(*this == other);
+    }
+  };
+  /// The stage highlights currently applied to the document, as
+  /// [source line : highlight].
+  std::map<unsigned, StageHighlight> m_stageHighlights;
+  CachedSetting<bool> m_stageHighlightingEnabled{
+      RIPES_SETTING_EDITORSTAGEHIGHLIGHTING};
+
   QFont m_font;
 
   // A timer is needed for only catching one of the multiple wheel events that
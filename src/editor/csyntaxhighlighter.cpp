@@ -7,104 +7,100 @@ namespace Ripes {
 CSyntaxHighlighter::CSyntaxHighlighter(
     QTextDocument *parent, std::shared_ptr<Assembler::Errors> errors)
     : SyntaxHighlighter(parent, errors) {
-  HighlightingRule rule;
-
   errorFormat.setUnderlineStyle(QTextCharFormat::WaveUnderline);
   errorFormat.setUnderlineColor(Qt::red);
 
   keywordFormat.setForeground(Qt::darkBlue);
   keywordFormat.setFontWeight(QFont::Bold);
-  const QString keywordPatterns[] = {
-      QStringLiteral("\\bconst\\b"),    QStringLiteral("\\benum\\b"),
-      QStringLiteral("\\binline\\b"),   QStringLiteral("\\bshort\\b"),
-      QStringLiteral("\\bstatic\\b"),   QStringLiteral("\\bstruct\\b"),
-      QStringLiteral("\\btypedef\\b"),  QStringLiteral("\\btypename\\b"),
-      QStringLiteral("\\bunion\\b"),    QStringLiteral("\\bvolatile\\b"),
-      QStringLiteral("\\bbreak\\b"),    QStringLiteral("\\bcase\\b"),
-      QStringLiteral("\\bif\\b"),       QStringLiteral("\\belse\\b"),
-      QStringLiteral("\\bdo\\b"),       QStringLiteral("\\bwhile\\b"),
-      QStringLiteral("\\bcontinue\\b"), QStringLiteral("\\bfor\\b"),
-      QStringLiteral("\\bextern\\b"),   QStringLiteral("\\bgoto\\b"),
-      QStringLiteral("\\bswitch\\b"),   QStringLiteral("\\bregister\\b"),
-      QStringLiteral("\\breturn\\b"),   QStringLiteral("\\bsizeof\\b"),
-      QStringLiteral("\\b__asm__\\b"),  QStringLiteral("\\basm\\b")};
-
-  for (const QString &pattern : keywordPatterns) {
-    rule.pattern = QRegularExpression(pattern);
-    rule.format = keywordFormat;
-    highlightingRules.append(rule);
-  }
+  m_keywords = {"const",  "enum",     "inline",   "short",  "static",
+                "struct", "typedef",  "typename", "union",  "volatile",
+                "break",  "case",     "if",       "else",   "do",
+                "while",  "continue", "for",      "extern", "goto",
+                "switch", "register", "return",   "sizeof", "__asm__",
+                "asm"};
 
   typeFormat.setForeground(Qt::darkBlue);
   typeFormat.setFontWeight(QFont::Bold);
-  const QString typePatterns[] = {
-      QStringLiteral("\\bchar\\b"),   QStringLiteral("\\bfloat\\b"),
-      QStringLiteral("\\bdouble\\b"), QStringLiteral("\\bint\\b"),
-      QStringLiteral("\\blong\\b"),   QStringLiteral("\\bshort\\b"),
-      QStringLiteral("\\bsigned\\b"), QStringLiteral("\\bunsigned\\b"),
-      QStringLiteral("\\bvoid\\b"),   QStringLiteral("\\bbool\\b")};
-  for (const QString &pattern : typePatterns) {
-    rule.pattern = QRegularExpression(pattern);
-    rule.format = typeFormat;
-    highlightingRules.append(rule);
-  }
+  m_types = {"char", "float",  "double",   "int",  "long",
+             "short", "signed", "unsigned", "void", "bool"};
 
   singleLineCommentFormat.setForeground(Colors::Medalist);
-  rule.pattern = QRegularExpression(QStringLiteral("//[^\n]*"));
-  rule.format = singleLineCommentFormat;
-  highlightingRules.append(rule);
-
   multiLineCommentFormat.setForeground(Colors::Medalist);
-
   preprocessorFormat.setForeground(QColorConstants::DarkMagenta);
-  rule.pattern = QRegularExpression(QStringLiteral("^\\ *#[^ ]*"));
-  rule.format = preprocessorFormat;
-  highlightingRules.append(rule);
-
   quotationFormat.setForeground(QColor{0x80, 0x00, 0x00});
-  rule.pattern = QRegularExpression(QStringLiteral("\".*\""));
-  rule.format = quotationFormat;
-  highlightingRules.append(rule);
-
   functionFormat.setForeground(Colors::BerkeleyBlue);
-  rule.pattern = QRegularExpression(QStringLiteral("\\b[A-Za-z0-9_]+(?=\\()"));
-  rule.format = functionFormat;
-  highlightingRules.append(rule);
+}
 
-  commentStartExpression = QRegularExpression(QStringLiteral("/\\*"));
-  commentEndExpression = QRegularExpression(QStringLiteral("\\*/"));
-} // namespace Ripes
+int CSyntaxHighlighter::highlightComment(const QString &text, int start) {
+  int end = text.indexOf(QLatin1String("*/"), start);
+  if (end == -1) {
+    setCurrentBlockState(InComment);
+    end = text.length();
+  } else {
+    end += 2;
+  }
+  setFormat(start, end - start, multiLineCommentFormat);
+  return end;
+}
 
 void CSyntaxHighlighter::syntaxHighlightBlock(const QString &text) {
-  for (const HighlightingRule &rule : qAsConst(highlightingRules)) {
-    QRegularExpressionMatchIterator matchIterator =
-        rule.pattern.globalMatch(text);
-    while (matchIterator.hasNext()) {
-      QRegularExpressionMatch match = matchIterator.next();
-      setFormat(match.capturedStart(), match.capturedLength(), rule.format);
+  setCurrentBlockState(Normal);
+
+  const int n = text.length();
+  int i = 0;
+  if (previousBlockState() == InComment)
+    i = highlightComment(text, 0);
+
+  // Preprocessor directives; '#' as the first non-blank character of a line,
+  // up until the next space.
+  if (i == 0) {
+    while (i < n && text.at(i) == ' ')
+      ++i;
+    if (i < n && text.at(i) == '#') {
+      const int start = i;
+      while (i < n && text.at(i) != ' ')
+        ++i;
+      setFormat(start, i - start, preprocessorFormat);
     }
   }
 
-  setCurrentBlockState(0);
-
-  int startIndex = 0;
-  if (previousBlockState() != 1)
-    startIndex = text.indexOf(commentStartExpression);
-
-  while (startIndex >= 0) {
-    QRegularExpressionMatch match =
-        commentEndExpression.match(text, startIndex);
-    int endIndex = match.capturedStart();
-    int commentLength = 0;
-    if (endIndex == -1) {
-      setCurrentBlockState(1);
-      commentLength = text.length() - startIndex;
+  auto isWordChar = [](QChar ch) { return ch.isLetterOrNumber() || ch == '_'; };
+  while (i < n) {
+    const QChar ch = text.at(i);
+    const QChar next = i + 1 < n ? text.at(i + 1) : QChar();
+    const int start = i;
+    if (ch == '/' && next == '/') {
+      setFormat(i, n - i, singleLineCommentFormat);
+      break;
+    } else if (ch == '/' && next == '*') {
+      i = highlightComment(text, i);
+    } else if (ch == '"') {
+      bool escape = false;
+      for (++i; i < n; ++i) {
+        if (escape) {
+          escape = false;
+        } else if (text.at(i) == '\\') {
+          escape = true;
+        } else if (text.at(i) == '"') {
+          ++i;
+          break;
+        }
+      }
+      setFormat(start, i - start, quotationFormat);
+    } else if (isWordChar(ch)) {
+      while (i < n && isWordChar(text.at(i)))
+        ++i;
+      const QString word = text.mid(start, i - start);
+      if (m_keywords.contains(word)) {
+        setFormat(start, i - start, keywordFormat);
+      } else if (m_types.contains(word)) {
+        setFormat(start, i - start, typeFormat);
+      } else if (i < n && text.at(i) == '(') {
+        setFormat(start, i - start, functionFormat);
+      }
     } else {
-      commentLength = endIndex - startIndex + match.capturedLength();
+      ++i;
     }
-    setFormat(startIndex, commentLength, multiLineCommentFormat);
-    startIndex =
-        text.indexOf(commentStartExpression, startIndex + commentLength);
   }
 }
 
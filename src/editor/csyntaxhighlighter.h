@@ -1,10 +1,10 @@
 #pragma once
 
-#include <QRegularExpression>
+#include <QSet>
 
 #include "syntaxhighlighter.h"
 
-/** Heavily based on QT's rich text syntax highlighter example.
+/** Originally based on QT's rich text syntax highlighter example.
  http://doc.qt.io/qt-5/qtwidgets-richtext-syntaxhighlighter-example.html
  */
 
@@ -17,14 +17,16 @@ public:
   void syntaxHighlightBlock(const QString &text) override;
 
 private:
-  struct HighlightingRule {
-    QRegularExpression pattern;
-    QTextCharFormat format;
-  };
-  QVector<HighlightingRule> highlightingRules;
-
-  QRegularExpression commentStartExpression;
-  QRegularExpression commentEndExpression;
+  /// Block states. A block ending within a multi-line comment continues the
+  /// comment in the next block.
+  enum BlockState { Normal = 0, InComment = 1 };
+
+  /// Highlights a multi-line comment starting at @p start. Returns the index
+  /// following the end of the comment.
+  int highlightComment(const QString &text, int start);
+
+  QSet<QString> m_keywords;
+  QSet<QString> m_types;
 
   QTextCharFormat keywordFormat;
   QTextCharFormat typeFormat;
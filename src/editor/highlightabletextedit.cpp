@@ -5,6 +5,8 @@
 #include <QPainter>
 #include <QTextBlock>
 
+#include <algorithm>
+
 #include "colors.h"
 
 namespace Ripes {
@@ -16,7 +18,7 @@ HighlightableTextEdit::HighlightableTextEdit(QWidget *parent)
   connect(this->document(), &QTextDocument::contentsChange, this,
           [&](int /*pos*/, int charsRemoved, int charsAdded) {
             if ((charsRemoved == 0 && charsAdded == 0) ||
-                (charsAdded == charsRemoved))
+                (charsAdded == charsRemoved) || m_preserveHighlights)
               return;
             clearBlockHighlights();
           });
@@ -47,6 +49,9 @@ void HighlightableTextEdit::paintEvent(QPaintEvent *event) {
 }
 
 void HighlightableTextEdit::applyHighlighting() {
+  if (m_deferHighlighting)
+    return;
+
   QList<QTextEdit::ExtraSelection> selections;
   for (auto &bh : m_blockHighlights) {
     if (auto selection = getExtraSelection(bh); selection.has_value())
@@ -73,6 +78,21 @@ void HighlightableTextEdit::clearBlockHighlights() {
   update();
 }
 
+void HighlightableTextEdit::editPreservingHighlights(
+    const std::function<void()> &edit) {
+  m_preserveHighlights = true;
+  edit();
+  m_preserveHighlights = false;
+}
+
+void HighlightableTextEdit::changeHighlights(
+    const std::function<void()> &changes) {
+  m_deferHighlighting = true;
+  changes();
+  m_deferHighlighting = false;
+  applyHighlighting();
+}
+
 void HighlightableTextEdit::resizeEvent(QResizeEvent *e) {
   QPlainTextEdit::resizeEvent(e);
   applyHighlighting();
@@ -88,7 +108,7 @@ void HighlightableTextEdit::highlightBlock(const QTextBlock &block,
 
   // Check if we're already highlighting the block. If this is the case, do not
   // set an additional highlight on it.
-  if (m_highlightedBlocks.count(block))
+  if (!m_highlightedBlocks.insert(block).second)
     return;
   m_blockHighlights.push_back({});
   auto &highlight = m_blockHighlights.back();
@@ -97,6 +117,21 @@ void HighlightableTextEdit::highlightBlock(const QTextBlock &block,
   applyHighlighting();
 }
 
+void HighlightableTextEdit::removeBlockHighlight(const QTextBlock &block) {
+  if (!block.isValid())
+    return;
+  m_highlightedBlocksText.erase(block);
+  m_highlightedBlocks.erase(block);
+  const int blockNumber = block.blockNumber();
+  m_blockHighlights.erase(
+      std::remove_if(m_blockHighlights.begin(), m_blockHighlights.end(),
+                     [&](const BlockHighlight &highlight) {
+                       return highlight.blockNumber == blockNumber;
+                     }),
+      m_blockHighlights.end());
+  applyHighlighting();
+}
+
 std::optional<QTextEdit::ExtraSelection>
 HighlightableTextEdit::getExtraSelection(
     const HighlightableTextEdit::BlockHighlight &highlighting) {
@@ -6,6 +6,7 @@
 #include <QScrollBar>
 #include <QTimer>
 
+#include <functional>
 #include <optional>
 #include <set>
 
@@ -35,12 +36,22 @@ public:
   /// which will be painted at the right-hand side of each block.
   void highlightBlock(const QTextBlock &block, const QColor &color,
                       const QString &text = QString());
+  /// Removes the highlight and any strings of the given block.
+  void removeBlockHighlight(const QTextBlock &block);
   /// Clears any currently active block highlightings.
   void clearBlockHighlights();
 
 protected:
   void resizeEvent(QResizeEvent *event) override;
 
+  /// Applies @p edit to the document without clearing the block highlights.
+  /// The edit must not add or remove blocks.
+  void editPreservingHighlights(const std::function<void()> &edit);
+
+  /// Applies the highlight changes performed by @p changes to the view at once,
+  /// instead of after each individual change.
+  void changeHighlights(const std::function<void()> &changes);
+
 private:
   /// Creates a new ExtraSelection formatting from the information stored in
   /// BlockHighlighting.
@@ -55,6 +66,10 @@ private:
   std::set<QTextBlock> m_highlightedBlocks;
   /// A list containing the current highlightings being applied
   QList<BlockHighlight> m_blockHighlights;
+  /// Set while the document is edited through editPreservingHighlights.
+  bool m_preserveHighlights = false;
+  /// Set while highlights are changed through changeHighlights.
+  bool m_deferHighlighting = false;
 };
 
 } // namespace Ripes
@@ -8,75 +8,86 @@ RVSyntaxHighlighter::RVSyntaxHighlighter(
     QTextDocument *parent, std::shared_ptr<Assembler::Errors> errors,
     const std::set<QString> &supportedOpcodes)
     : SyntaxHighlighter(parent, errors) {
-  HighlightingRule rule;
-
-  // General registers
+  // Registers
   registerFormat.setForeground(QColor{0x80, 0x00, 0x00});
-  rule.pattern = QRegularExpression("\\b[(a|s|t|x)][0-9]{1,2}");
-  rule.format = registerFormat;
-  m_highlightingRules.append(rule);
-
-  // Name-specific registers
-  QStringList registerPatterns;
-  registerPatterns << "\\bzero\\b"
-                   << "\\bra\\b"
-                   << "\\bsp\\b"
-                   << "\\bgp\\b"
-                   << "\\btp\\b"
-                   << "\\bfp\\b";
-  for (const auto &pattern : qAsConst(registerPatterns)) {
-    rule.pattern = QRegularExpression(pattern);
-    rule.format = registerFormat;
-    m_highlightingRules.append(rule);
-  }
 
   // Instructions
   instructionFormat.setForeground(Colors::BerkeleyBlue);
-  for (const auto &pattern : supportedOpcodes) {
-    const QString regexPattern = "\\b" + pattern + "\\b";
-    rule.pattern = QRegularExpression(regexPattern);
-    rule.format = instructionFormat;
-    m_highlightingRules.append(rule);
-  }
+  for (const auto &opcode : supportedOpcodes)
+    m_opcodes.insert(opcode);
 
   // Labels
   labelFormat.setForeground(Colors::Medalist);
-  rule.pattern = QRegularExpression(R"([\S]+:)");
-  rule.format = labelFormat;
-  m_highlightingRules.append(rule);
 
   // Immediates
   immediateFormat.setForeground(QColorConstants::DarkGreen);
-  rule.pattern = QRegularExpression("\\b(?<![A-Za-z])[-+]?\\d+");
-  rule.format = immediateFormat;
-  m_highlightingRules.append(rule);
-
-  // Prefixed immediates (0x, 0b)
-  rule.pattern =
-      QRegularExpression("([-+]?0[xX][0-9a-fA-F]+|[-+]?0[bB][0-1]+)");
-  m_highlightingRules.append(rule);
 
   // Strings
   stringFormat.setForeground(QColor{0x80, 0x00, 0x00});
-  rule.pattern = QRegularExpression(R"("(?:[^"]|\.)*")");
-  rule.format = stringFormat;
-  m_highlightingRules.append(rule);
 
   // Comments
   commentFormat.setForeground(Colors::Medalist);
-  rule.pattern = QRegularExpression("[#]+.*");
-  rule.format = commentFormat;
-  m_highlightingRules.append(rule);
+}
+
+bool RVSyntaxHighlighter::isRegister(QStringView word) {
+  // General registers; a register class followed by 1-2 digits.
+  const QChar regClass = word.isEmpty() ? QChar() : word.front();
+  if (word.size() >= 2 && word.size() <= 3 &&
+      (regClass == 'a' || regClass == 's' || regClass == 't' ||
+       regClass == 'x')) {
+    bool allDigits = true;
+    for (QChar ch : word.mid(1))
+      allDigits &= ch.isDigit();
+    if (allDigits)
+      return true;
+  }
+
+  // Name-specific registers
+  static const QLatin1String s_namedRegisters[] = {
+      QLatin1String("zero"), QLatin1String("ra"), QLatin1String("sp"),
+      QLatin1String("gp"),   QLatin1String("tp"), QLatin1String("fp")};
+  for (const auto &name : s_namedRegisters) {
+    if (word == name)
+      return true;
+  }
+  return false;
+}
+
+const QTextCharFormat *
+RVSyntaxHighlighter::identifierFormat(QStringView word) const {
+  if (isRegister(word))
+    return &registerFormat;
+  if (m_opcodes.contains(word.toString()))
+    return &instructionFormat;
+  return nullptr;
 }
 
 void RVSyntaxHighlighter::syntaxHighlightBlock(const QString &text) {
-  for (const HighlightingRule &rule : qAsConst(m_highlightingRules)) {
-    QRegularExpressionMatchIterator matchIterator =
-        rule.pattern.globalMatch(text);
-    while (matchIterator.hasNext()) {
-      QRegularExpressionMatch match = matchIterator.next();
-      setFormat(match.capturedStart(), match.capturedLength(), rule.format);
+  Assembler::lexLine(text, '#', m_tokens);
+  for (const auto &token : m_tokens) {
+    const QTextCharFormat *format = nullptr;
+    switch (token.tokenClass) {
+    case Assembler::TokenClass::Identifier:
+      format =
+          identifierFormat(QStringView(text).mid(token.start, token.length));
+      break;
+    case Assembler::TokenClass::Label:
+      format = &labelFormat;
+      break;
+    case Assembler::TokenClass::Immediate:
+      format = &immediateFormat;
+      break;
+    case Assembler::TokenClass::String:
+      format = &stringFormat;
+      break;
+    case Assembler::TokenClass::Comment:
+      format = &commentFormat;
+      break;
+    case Assembler::TokenClass::Punctuation:
+      break;
     }
+    if (format)
+      setFormat(token.start, token.length, *format);
   }
 }
 
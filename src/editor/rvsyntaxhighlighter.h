@@ -1,8 +1,10 @@
 #pragma once
 
-#include <QRegularExpression>
+#include <QSet>
 #include <set>
+#include <vector>
 
+#include "assembler/parserutilities.h"
 #include "syntaxhighlighter.h"
 
 namespace Ripes {
@@ -15,11 +17,12 @@ public:
   void syntaxHighlightBlock(const QString &text) override;
 
 private:
-  struct HighlightingRule {
-    QRegularExpression pattern;
-    QTextCharFormat format;
-  };
-  QVector<HighlightingRule> m_highlightingRules;
+  static bool isRegister(QStringView word);
+  const QTextCharFormat *identifierFormat(QStringView word) const;
+
+  QSet<QString> m_opcodes;
+  /// Token storage, reused between blocks.
+  std::vector<Assembler::LexedToken> m_tokens;
 
   QTextCharFormat registerFormat;
   QTextCharFormat labelFormat;
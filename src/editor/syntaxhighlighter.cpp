@@ -1,5 +1,6 @@
 #include "syntaxhighlighter.h"
 
+#include <QTextBlock>
 #include <QTextDocument>
 
 namespace Ripes {
@@ -10,13 +11,33 @@ SyntaxHighlighter::SyntaxHighlighter(QTextDocument *parent,
   errorFormat.setUnderlineColor(Qt::red);
 }
 
+namespace {
+/// Marks a block which is highlighted as erroneous.
+class ErrorMarker : public QTextBlockUserData {};
+} // namespace
+
 void SyntaxHighlighter::highlightBlock(const QString &text) {
   int row = currentBlock().firstLineNumber();
-  if (m_errors && m_errors->toMap().count(row) != 0) {
+  if (m_errors && m_errors->errorAt(row)) {
+    setCurrentBlockUserData(new ErrorMarker());
     setFormat(0, text.length(), errorFormat);
   } else {
+    setCurrentBlockUserData(nullptr);
     syntaxHighlightBlock(text);
   }
 }
 
+void SyntaxHighlighter::rehighlightErrors() {
+  if (!document())
+    return;
+  for (QTextBlock block = document()->begin(); block.isValid();
+       block = block.next()) {
+    const bool marked = block.userData() != nullptr;
+    const bool erroneous =
+        m_errors && m_errors->errorAt(block.firstLineNumber());
+    if (marked != erroneous)
+      rehighlightBlock(block);
+  }
+}
+
 } // namespace Ripes
@@ -26,6 +26,13 @@ public:
    */
   virtual void syntaxHighlightBlock(const QString &text) = 0;
 
+  /**
+   * @brief rehighlightErrors
+   * Rehighlights the blocks whose error state differs from the current set of
+   * errors. Other blocks are left untouched.
+   */
+  void rehighlightErrors();
+
 protected:
   /**
    * @brief m_errors
@@ -1,14 +1,12 @@
 #include "edittab.h"
 #include "ui_edittab.h"
 
-#include "elfio/elfio.hpp"
-#include "libelfin/dwarf/dwarf++.hh"
-
 #include <QCheckBox>
 #include <QLabel>
 #include <QLineEdit>
 #include <QMessageBox>
 #include <QPushButton>
+#include <QtConcurrent/QtConcurrent>
 
 #include "assembler/program.h"
 
@@ -75,6 +73,11 @@ EditTab::EditTab(QToolBar *toolbar, QWidget *parent)
           &EditTab::enableAssemblyInput);
   connect(m_ui->codeEditor, &CodeEditor::timedTextChanged, this,
           &EditTab::sourceCodeChanged);
+  connect(&m_assembleWatcher,
+          &QFutureWatcher<Assembler::AssembleResult>::finished, this,
+          &EditTab::assembleFinished);
+  connect(&CCManager::get(), &CCManager::compileFinished, this,
+          &EditTab::compileFinished);
 
   m_ui->programViewer->setReadOnly(true);
 
@@ -103,8 +106,18 @@ EditTab::EditTab(QToolBar *toolbar, QWidget *parent)
           this, &EditTab::updateProgramViewerHighlighting);
   connect(ProcessorHandler::get(), &ProcessorHandler::programChanged, this,
           &EditTab::updateProgramViewer);
+  connect(ProcessorHandler::get(), &ProcessorHandler::processorAboutToChange,
+          this, &EditTab::abortAssembly);
   connect(ProcessorHandler::get(), &ProcessorHandler::processorChanged, this,
           &EditTab::onProcessorChanged);
+  // The job assembler takes a snapshot of the segment pointers; recreate it
+  // whenever these change.
+  for (const auto &key :
+       {RIPES_SETTING_ASSEMBLER_TEXTSTART, RIPES_SETTING_ASSEMBLER_DATASTART,
+        RIPES_SETTING_ASSEMBLER_BSSSTART}) {
+    connect(RipesSettings::getObserver(key), &SettingObserver::modified, this,
+            [=] { m_jobAssembler = ProcessorHandler::createJobAssembler(); });
+  }
   onProcessorChanged();
   sourceTypeChanged();
   enableEditor();
@@ -262,6 +275,8 @@ void EditTab::sourceTypeChanged() {
   // Validate source type selection
   if (m_ui->setAssemblyInput->isChecked()) {
     m_currentSourceType = SourceType::Assembly;
+    // Any C build in progress is no longer relevant
+    CCManager::get().abortAsync();
   } else if (m_ui->setCInput->isChecked()) {
     // Ensure that we have a validated C compiler available
     if (!CCManager::get().hasValidCC()) {
@@ -281,7 +296,20 @@ void EditTab::sourceTypeChanged() {
       m_currentSourceType, ProcessorHandler::getAssembler()->getOpcodes());
 }
 
+void EditTab::abortAssembly() {
+  if (m_assembleWatcher.isRunning()) {
+    m_assembleAbort->store(true, std::memory_order_relaxed);
+    m_assembleWatcher.waitForFinished();
+  }
+  m_assemblePending = false;
+}
+
 void EditTab::onProcessorChanged() {
+  // The assembler of background assembly jobs must be recreated for the new
+  // ISA. Any running job was aborted before the processor changed, so it is
+  // replaced right away.
+  m_jobAssembler = ProcessorHandler::createJobAssembler();
+
   // Notify a possible assembler change to the code editor - opcodes might have
   // been added or removed which must be reflected in the syntax highlighter
   m_ui->codeEditor->setSourceType(
@@ -304,9 +332,41 @@ void EditTab::sourceCodeChanged() {
 }
 
 void EditTab::assemble() {
-  auto res = ProcessorHandler::getAssembler()->assembleRaw(
-      m_ui->codeEditor->document()->toPlainText(),
-      &IOManager::get().assemblerSymbols());
+  if (m_assembleWatcher.isRunning()) {
+    // Abort the stale job. Assembly is restarted once it has terminated, given
+    // that the job assembler may only run a single job at a time.
+    m_assembleAbort->store(true, std::memory_order_relaxed);
+    m_assemblePending = true;
+    return;
+  }
+
+  m_assemblePending = false;
+  m_assembleAbort = std::make_shared<std::atomic<bool>>(false);
+  // Jobs use an assembler of their own, given that the assembler of
+  // ProcessorHandler is used from the GUI thread. The job shares ownership of
+  // it, and operates on copies of the editor contents and peripheral symbols.
+  auto assembler = m_jobAssembler;
+  auto abort = m_assembleAbort;
+  const QString source = m_ui->codeEditor->document()->toPlainText();
+  const auto symbols = IOManager::get().assemblerSymbols();
+  m_assembleWatcher.setFuture(QtConcurrent::run([=] {
+    return assembler->assembleRaw(source, &symbols, abort.get());
+  }));
+}
+
+void EditTab::assembleFinished() {
+  if (m_assemblePending) {
+    // The editor contents changed while assembling; the result is stale.
+    assemble();
+    return;
+  }
+
+  const auto res = m_assembleWatcher.result();
+  if (res.aborted || m_currentSourceType != SourceType::Assembly ||
+      !m_editorEnabled) {
+    return;
+  }
+
   *m_sourceErrors = res.errors;
   if (m_sourceErrors->size() == 0) {
     ProcessorHandler::loadProgram(std::make_shared<Program>(res.program));
@@ -320,29 +380,37 @@ void EditTab::assemble() {
 #endif
   }
   m_ui->codeEditor->rehighlight();
+  emit assemblyFinished();
 }
 
 void EditTab::compile() {
   // We don't care about asking our editor for syntax accepted, since there is
   // no C-syntax checking in Ripes.
-  auto res = CCManager::get().compile(m_ui->codeEditor->document());
+  GeneralStatusManager::setStatusTimed("Compiling...");
+  CCManager::get().compileAsync(m_ui->codeEditor->document()->toPlainText());
+}
+
+void EditTab::compileFinished(const CCManager::CCRes &res) {
   if (res.success) {
     // Compilation successful; load file through standard file loading functions
     LoadFileParams params;
     params.filepath = res.outFile;
     params.type = SourceType::InternalELF;
     loadFile(params);
-    // Clean up temporary source and output files
   } else if (!res.aborted) {
     CompilerErrorDialog errDiag(this);
     errDiag.setText("Compilation failed. Error output was:");
-    errDiag.setErrorText(CCManager::getError());
+    errDiag.setErrorText(res.errorOutput._stderr);
     errDiag.exec();
   }
+  // Clean up temporary output file
   res.clean();
 }
 
-EditTab::~EditTab() { delete m_ui; }
+EditTab::~EditTab() {
+  abortAssembly();
+  delete m_ui;
+}
 
 void EditTab::newProgram() {
   m_ui->codeEditor->clear();
@@ -391,120 +459,15 @@ bool EditTab::loadSourceFile(Program &, QFile &file) {
   return true;
 }
 
-using namespace ELFIO;
-class ELFIODwarfLoader : public ::dwarf::loader {
-public:
-  ELFIODwarfLoader(elfio &reader) : reader(reader) {}
-
-  const void *load(::dwarf::section_type section, size_t *size_out) override {
-    auto sec = reader.sections[::dwarf::elf::section_type_to_name(section)];
-    if (sec == nullptr)
-      return nullptr;
-    *size_out = sec->get_size();
-    return sec->get_data();
-  }
-
-private:
-  elfio &reader;
-};
-
-std::shared_ptr<ELFIODwarfLoader> createDwarfLoader(elfio &reader) {
-  return std::make_shared<ELFIODwarfLoader>(reader);
-}
-
-static bool isInternalSourceFile(const QString &filename) {
-  // Returns true if we have reason to believe that this file originated from
-  // within the Ripes editor. These will be temporary files like
-  // /.../Ripes.abc123.c
-  static QRegularExpression re("Ripes.[a-zA-Z0-9]+.c");
-  return re.match(filename).hasMatch();
-}
-
 bool EditTab::loadElfFile(Program &program, QFile &file) {
-  ELFIO::elfio reader;
-
-  // No file validity checking is performed - it is expected that Loaddialog has
-  // done all validity checking.
-  if (!reader.load(file.fileName().toStdString())) {
+  const QString err = Ripes::loadElfFile(program, file);
+  if (!err.isEmpty()) {
+    // No file validity checking is performed - it is expected that Loaddialog
+    // has done all validity checking.
     assert(false);
+    return false;
   }
 
-  for (const auto &elfSection : reader.sections) {
-    // Do not load .debug sections
-    if (!QString::fromStdString(elfSection->get_name()).startsWith(".debug")) {
-      ProgramSection section;
-      section.name = QString::fromStdString(elfSection->get_name());
-      section.address = elfSection->get_address();
-      // QByteArray performs a deep copy of the data when the data array is
-      // initialized at construction
-      section.data = QByteArray(elfSection->get_data(),
-                                static_cast<int>(elfSection->get_size()));
-      program.sections[section.name] = section;
-    }
-
-    if (elfSection->get_type() == SHT_SYMTAB) {
-      // Collect function symbols
-      const ELFIO::symbol_section_accessor symbols(reader, elfSection);
-      for (unsigned int j = 0; j < symbols.get_symbols_num(); ++j) {
-        std::string name;
-        ELFIO::Elf64_Addr value = 0;
-        ELFIO::Elf_Xword size;
-        unsigned char bind;
-        unsigned char type = STT_NOTYPE;
-        ELFIO::Elf_Half section_index;
-        unsigned char other;
-        symbols.get_symbol(j, name, value, size, bind, type, section_index,
-                           other);
-
-        if (type != STT_FUNC)
-          continue;
-        program.symbols[value] = QString::fromStdString(name);
-      }
-    }
-  }
-
-  // Load DWARF information into the source mapping of the program.
-  // We'll only load information from compilation units which originated from a
-  // source file that plausibly arrived from within the Ripes editor.
-  QString editorSrcFile;
-  try {
-    ::dwarf::dwarf dw(createDwarfLoader(reader));
-    for (auto &cu : dw.compilation_units()) {
-      for (auto &line : cu.get_line_table()) {
-        if (!line.file)
-          continue;
-        QString filePath = QString::fromStdString(line.file->path);
-        if (editorSrcFile.isEmpty()) {
-          // Try to see if this compilation unit is from the Ripes editor:
-          if (isInternalSourceFile(filePath))
-            editorSrcFile = filePath;
-        }
-        if (editorSrcFile != filePath)
-          continue;
-        program.sourceMapping[line.address].insert(line.line - 1);
-      }
-    }
-    if (!editorSrcFile.isEmpty()) {
-      // Finally, we need to generate a hash of the source file that we've
-      // loaded source mappings from, so the editor knows what editor contents
-      // applies to this program.
-      QFile srcFile(editorSrcFile);
-      if (srcFile.open(QFile::ReadOnly))
-        program.sourceHash = Program::calculateHash(srcFile.readAll());
-      else
-        throw ::dwarf::format_error("Could not find source file " +
-                                    editorSrcFile.toStdString());
-    }
-  } catch (::dwarf::format_error &e) {
-    std::string msg = "Could not load debug information: ";
-    msg += e.what();
-    GeneralStatusManager::setStatusTimed(QString::fromStdString(msg), 2500);
-  } catch (...) {
-    // Something else went wrong.
-  }
-
-  program.entryPoint = reader.get_entry();
-
   m_ui->curInputSrcLabel->setText("Executable (ELF)");
   m_ui->inputSrcPath->setText(file.fileName());
 
@@ -2,12 +2,15 @@
 
 #include <QByteArray>
 #include <QFile>
+#include <QFutureWatcher>
 #include <QWidget>
+#include <atomic>
 #include <map>
 #include <memory>
 
 #include "assembler/assembler.h"
 #include "assembler/program.h"
+#include "ccmanager.h"
 #include "ripestab.h"
 
 namespace Ripes {
@@ -48,6 +51,13 @@ signals:
   void programChanged(const std::shared_ptr<Program> &program);
   void editorStateChanged(bool enabled);
 
+  /**
+   * @brief assemblyFinished
+   * Emitted once the result of a background assembly job has been applied,
+   * i.e., the program has been loaded or the assembler errors have been set.
+   */
+  void assemblyFinished();
+
 public slots:
   void onSave();
   void onProcessorChanged();
@@ -72,8 +82,24 @@ public slots:
   void on_disassembledViewButton_toggled();
 
 private:
+  /**
+   * @brief assemble
+   * Starts assembling the current editor contents on a worker thread. If an
+   * assembly job is already running, it is aborted and a new job is started
+   * once it has terminated; only the result of the latest job is applied.
+   */
   void assemble();
+  void assembleFinished();
+  /// Aborts the running assembly job, if any, and waits for it to terminate.
+  void abortAssembly();
+
+  /**
+   * @brief compile
+   * Starts compiling the current editor contents. The compiler runs as a
+   * separate process; a new build supersedes any build in progress.
+   */
   void compile();
+  void compileFinished(const CCManager::CCRes &res);
 
   void updateProgramViewer();
   bool loadSourceFile(Program &program, QFile &file);
@@ -93,5 +119,13 @@ private:
   SourceType m_currentSourceType = SourceType::Assembly;
 
   bool m_editorEnabled = true;
+
+  QFutureWatcher<Assembler::AssembleResult> m_assembleWatcher;
+  std::shared_ptr<std::atomic<bool>> m_assembleAbort;
+  /// Assembler used by assembly jobs. A running job shares ownership of the
+  /// assembler it uses, so this may be replaced at any time.
+  std::shared_ptr<Assembler::AssemblerBase> m_jobAssembler;
+  /// Set when the editor contents changed while an assembly job was running.
+  bool m_assemblePending = false;
 };
 } // namespace Ripes
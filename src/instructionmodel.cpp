@@ -33,6 +33,8 @@ InstructionModel::InstructionModel(QObject *parent)
   }
   connect(ProcessorHandler::get(), &ProcessorHandler::procStateChangedNonRun,
           this, &InstructionModel::updateStageInfo);
+  connect(ProcessorHandler::get(), &ProcessorHandler::snapshotPublished, this,
+          [=] { setStageInfos(ProcessorHandler::getSnapshot().stages); });
   connect(ProcessorHandler::get(), &ProcessorHandler::processorReset, this,
           &InstructionModel::onProcessorReset);
   onProcessorReset();
@@ -63,18 +65,25 @@ void InstructionModel::updateRowCount() {
 int InstructionModel::rowCount(const QModelIndex &) const { return m_rowCount; }
 
 void InstructionModel::updateStageInfo() {
-  bool firstStageChanged = false;
+  std::map<StageIndex, StageInfo> stageInfos;
   for (auto idx : ProcessorHandler::getProcessor()->structure().stageIt()) {
+    stageInfos[idx] = ProcessorHandler::getProcessor()->stageInfo(idx);
+  }
+  setStageInfos(stageInfos);
+}
+
+void InstructionModel::setStageInfos(
+    const std::map<StageIndex, StageInfo> &stageInfos) {
+  bool firstStageChanged = false;
+  for (const auto &[idx, stageInfo] : stageInfos) {
     auto stageInfoIt = m_stageInfos.find(idx);
     if (stageInfoIt != m_stageInfos.end()) {
       auto &oldStageInfo = m_stageInfos.at(idx);
       if (idx == StageIndex(0, 0)) {
-        if (oldStageInfo.pc !=
-            ProcessorHandler::getProcessor()->stageInfo(idx).pc) {
+        if (oldStageInfo.pc != stageInfo.pc) {
           firstStageChanged = true;
         }
       }
-      const auto stageInfo = ProcessorHandler::getProcessor()->stageInfo(idx);
       const AInt oldAddress = oldStageInfo.pc;
       if (oldStageInfo != stageInfo) {
         oldStageInfo = stageInfo;
@@ -194,7 +203,9 @@ QVariant InstructionModel::data(const QModelIndex &index, int role) const {
 
 Qt::ItemFlags InstructionModel::flags(const QModelIndex &index) const {
   const auto def = Qt::ItemIsEnabled;
-  if (index.column() == Column::Breakpoint)
+  // Breakpoints are evaluated by the simulation thread, and may not be changed
+  // whilst running.
+  if (index.column() == Column::Breakpoint && !ProcessorHandler::isRunning())
     return Qt::ItemIsUserCheckable | def;
   return def;
 }
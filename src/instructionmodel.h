@@ -43,6 +43,7 @@ signals:
 
 private:
   void updateStageInfo();
+  void setStageInfos(const std::map<StageIndex, StageInfo> &stageInfos);
 
   QVariant BPData(AInt addr) const;
   QVariant PCData(AInt addr) const;
@@ -6,11 +6,9 @@ namespace Ripes {
 
 std::map<unsigned, std::set<unsigned>> IOBase::s_peripheralIDs;
 
-IOBase::IOBase(unsigned IOType, QWidget *parent)
-    : QWidget(parent), m_type(IOType) {
+IOBase::IOBase(unsigned IOType, QObject *parent)
+    : QObject(parent), m_type(IOType) {
   m_id = claimPeripheralId(m_type);
-  connect(this, &IOBase::scheduleUpdate, this,
-          QOverload<>::of(&QWidget::update));
 }
 
 QString cName(const QString &name) {
@@ -38,6 +36,17 @@ bool IOBase::setParameter(unsigned ID, const QVariant &value) {
   return true;
 }
 
+bool IOBase::setInput(AInt offset, VInt value) {
+  for (const auto &reg : registers()) {
+    if (reg.address == offset && reg.rw != RegDesc::RW::W) {
+      m_regs.write(offset / 4, value & vsrtl::generateBitmask(reg.bitWidth));
+      markDirty();
+      return true;
+    }
+  }
+  return false;
+}
+
 void IOBase::unregister() {
   std::atomic<bool> sync;
   std::condition_variable cv;
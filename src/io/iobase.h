@@ -1,11 +1,13 @@
 ﻿#pragma once
 
+#include <QObject>
 #include <QVariant>
-#include <QWidget>
+#include <atomic>
 #include <set>
 
 #include "../assembler/program.h"
 #include "binutils.h"
+#include "ioregisterblock.h"
 #include "serializers.h"
 
 #include "VSRTL/external/cereal/include/cereal/cereal.hpp"
@@ -59,11 +61,18 @@ struct RegDesc {
   bool exported = false;
 };
 
-class IOBase : public QWidget {
+/**
+ * @brief The IOBase class
+ * Register and behavioral model of an IO peripheral. Peripheral models are
+ * independent of any GUI; the graphical representation of a peripheral is
+ * provided by a separate IOView (see ioview.h), allowing for peripherals to be
+ * instantiated in headless (CLI) runs.
+ */
+class IOBase : public QObject {
   Q_OBJECT
 
 public:
-  IOBase(unsigned IOType /*ioregistry.h::IOType*/, QWidget *parent);
+  IOBase(unsigned IOType /*ioregistry.h::IOType*/, QObject *parent);
   virtual ~IOBase() {
     assert(m_didUnregister &&
            "IO peripherals must call unregister() in their destructor!");
@@ -118,6 +127,20 @@ public:
    */
   virtual void reset() {}
 
+  /**
+   * @brief setInput
+   * Drives the processor-readable register at byte @p offset to @p value, as
+   * if changed by the user. Used for scripting peripheral inputs. Returns
+   * false if no readable register exists at @p offset.
+   */
+  bool setInput(AInt offset, VInt value);
+
+  /**
+   * @brief registerBlock
+   * @returns the register file of this peripheral.
+   */
+  const IORegisterBlock &registerBlock() const { return m_regs; }
+
   /**
    * Read/write functions from processor
    */
@@ -130,6 +153,23 @@ public:
   std::function<void(AInt, AInt, VInt)> memWrite;
   std::function<VInt(AInt, AInt)> memRead;
 
+  /**
+   * @brief markDirty
+   * Flags that the visual state of this peripheral has changed. Safe to call
+   * from the simulation thread; peripherals should call this instead of
+   * directly requesting a repaint. Dirty peripherals are coalesced and
+   * refreshed by the IOManager at the rate given by RIPES_SETTING_UIUPDATEPS.
+   */
+  void markDirty() { m_dirty.store(true, std::memory_order_release); }
+
+  /**
+   * @brief takeDirty
+   * Clears the dirty flag of this peripheral, returning whether it was set.
+   */
+  bool takeDirty() {
+    return m_dirty.exchange(false, std::memory_order_acq_rel);
+  }
+
   unsigned iotype() const { return m_type; }
   unsigned id() const { return m_id; }
   void setID(unsigned id) {
@@ -173,14 +213,6 @@ signals:
    */
   void sizeChanged();
 
-  /**
-   * @brief scheduleUpdate
-   * Should be emitted when a peripheral requests to be repainted. We do this
-   * through signal/slot mechanisms to ensure that the actual update() is only
-   * performed on the GUI thread.
-   */
-  void scheduleUpdate();
-
   /**
    * @brief aboutToDelete
    * Signal emitted when this IO peripheral is about to be destroyed. @param ok
@@ -189,6 +221,14 @@ signals:
    */
   void aboutToDelete(std::atomic<bool> &ok);
 
+  /**
+   * @brief repaintRequested
+   * Emitted on the GUI thread, at most once per UI update, if the peripheral
+   * has been marked dirty since the last UI update. Views of the peripheral
+   * should refresh upon this signal.
+   */
+  void repaintRequested();
+
   /**
    * @brief paramsChanged
    * Emitted after a parameter has been changed _and_ recognized by the IOBase
@@ -212,6 +252,14 @@ protected:
   std::map<unsigned, IOParam> m_parameters;
   unsigned m_id = UINT_MAX;
 
+  /**
+   * @brief m_regs
+   * Register file of this peripheral. Any state accessed through
+   * ioRead/ioWrite should be kept in this block, such that it can be safely
+   * shared between the simulation thread and the GUI thread.
+   */
+  IORegisterBlock m_regs;
+
   static std::map<unsigned, std::set<unsigned>> s_peripheralIDs;
   static unsigned claimPeripheralId(const unsigned &ioType, int forcedID = -1) {
     unsigned id = 0;
@@ -256,6 +304,7 @@ private:
    */
   bool m_didUnregister = false;
   unsigned m_type;
+  std::atomic<bool> m_dirty{false};
 };
 } // namespace Ripes
 
@@ -0,0 +1,86 @@
+#include "iodispatch.h"
+
+#include <algorithm>
+
+namespace Ripes {
+
+void IODispatchTable::rebuild(const std::vector<IORegion> &regions) {
+  m_handlers.clear();
+  m_pageToHandler.clear();
+  if (regions.empty()) {
+    return;
+  }
+
+  m_base = regions.front().start;
+  AInt end = 0;
+  for (const auto &region : regions) {
+    m_base = std::min(m_base, region.start);
+    end = std::max(end, region.end());
+  }
+
+  const AInt nPages = ((end - m_base) + (1 << pageBits) - 1) >> pageBits;
+  m_pageToHandler.assign(nPages, s_noHandler);
+
+  for (const auto &region : regions) {
+    Q_ASSERT((region.start - m_base) % (1 << pageBits) == 0 &&
+             "Peripherals must be word-aligned");
+    const uint16_t idx = m_handlers.size();
+    m_handlers.push_back({region.peripheral, region.start,
+                          static_cast<IOType>(region.peripheral->iotype())});
+    const AInt firstPage = (region.start - m_base) >> pageBits;
+    const AInt lastPage =
+        ((region.end() - m_base) + (1 << pageBits) - 1) >> pageBits;
+    std::fill(m_pageToHandler.begin() + firstPage,
+              m_pageToHandler.begin() + lastPage, idx);
+  }
+}
+
+VInt IODispatchTable::ioRead(AInt address, unsigned bytes) const {
+  const Handler *handler = lookup(address);
+  if (!handler) {
+    return 0;
+  }
+
+  const AInt offset = address - handler->base;
+  switch (handler->type) {
+  case IOType::LED_MATRIX:
+    return static_cast<IOLedMatrix *>(handler->peripheral)
+        ->IOLedMatrix::ioRead(offset, bytes);
+  case IOType::SWITCHES:
+    return static_cast<IOSwitches *>(handler->peripheral)
+        ->IOSwitches::ioRead(offset, bytes);
+  case IOType::DPAD:
+    return static_cast<IODPad *>(handler->peripheral)
+        ->IODPad::ioRead(offset, bytes);
+  default:
+    return handler->peripheral->ioRead(offset, bytes);
+  }
+}
+
+void IODispatchTable::ioWrite(AInt address, VInt value, unsigned bytes) const {
+  const Handler *handler = lookup(address);
+  if (!handler) {
+    return;
+  }
+
+  const AInt offset = address - handler->base;
+  switch (handler->type) {
+  case IOType::LED_MATRIX:
+    static_cast<IOLedMatrix *>(handler->peripheral)
+        ->IOLedMatrix::ioWrite(offset, value, bytes);
+    return;
+  case IOType::SWITCHES:
+    static_cast<IOSwitches *>(handler->peripheral)
+        ->IOSwitches::ioWrite(offset, value, bytes);
+    return;
+  case IOType::DPAD:
+    static_cast<IODPad *>(handler->peripheral)
+        ->IODPad::ioWrite(offset, value, bytes);
+    return;
+  default:
+    handler->peripheral->ioWrite(offset, value, bytes);
+    return;
+  }
+}
+
+} // namespace Ripes
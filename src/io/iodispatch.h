@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+#include "ioregistry.h"
+
+namespace Ripes {
+
+/**
+ * @brief The IORegion struct
+ * A peripheral mapped into the address space at [start : start + size[.
+ */
+struct IORegion {
+  IOBase *peripheral;
+  AInt start;
+  unsigned size;
+  AInt end() const { return start + size; }
+};
+
+/**
+ * @brief The IODispatchTable class
+ * Direct-mapped lookup table from addresses within the memory-mapped IO span
+ * to the peripheral occupying the address. Lookups are a single indexed load,
+ * regardless of the number of instantiated peripherals.
+ *
+ * Accesses to built-in peripheral types are devirtualized, such that tight
+ * polling loops on peripheral registers avoid the virtual ioRead/ioWrite
+ * dispatch.
+ */
+class IODispatchTable {
+public:
+  /// All peripheral registers are word-aligned and peripheral sizes are a
+  /// multiple of the word size, so the table is indexed at word granularity.
+  static constexpr unsigned pageBits = 2;
+
+  /**
+   * @brief rebuild
+   * Rebuilds the table from the set of currently mapped @p regions.
+   */
+  void rebuild(const std::vector<IORegion> &regions);
+
+  VInt ioRead(AInt address, unsigned bytes) const;
+  void ioWrite(AInt address, VInt value, unsigned bytes) const;
+
+private:
+  struct Handler {
+    IOBase *peripheral;
+    AInt base;
+    IOType type;
+  };
+
+  const Handler *lookup(AInt address) const {
+    const AInt page = (address - m_base) >> pageBits;
+    if (address < m_base || page >= m_pageToHandler.size()) {
+      return nullptr;
+    }
+    const uint16_t idx = m_pageToHandler[page];
+    return idx == s_noHandler ? nullptr : &m_handlers[idx];
+  }
+
+  static constexpr uint16_t s_noHandler = UINT16_MAX;
+  AInt m_base = 0;
+  std::vector<uint16_t> m_pageToHandler;
+  std::vector<Handler> m_handlers;
+};
+
+} // namespace Ripes
@@ -1,10 +1,6 @@
 #pragma once
 
-#include <QPen>
 #include <QVariant>
-#include <QWidget>
-
-QT_FORWARD_DECLARE_CLASS(QAbstractButton);
 
 #include "iobase.h"
 
@@ -13,10 +9,10 @@ namespace Ripes {
 class IODPad : public IOBase {
   Q_OBJECT
 
+public:
   enum IdxToDir { UP, DOWN, LEFT, RIGHT, DIRECTIONS };
 
-public:
-  IODPad(QWidget *parent);
+  IODPad(QObject *parent);
   ~IODPad() { unregister(); };
 
   virtual unsigned byteSize() const override;
@@ -33,14 +29,16 @@ public:
   virtual VInt ioRead(AInt offset, unsigned size) override;
   virtual void ioWrite(AInt offset, VInt value, unsigned size) override;
 
+  bool buttonState(IdxToDir dir) const { return m_regs.read(dir); }
+  void setButton(IdxToDir dir, bool down) {
+    m_regs.write(dir, down);
+    markDirty();
+  }
+
 protected:
   virtual void parameterChanged(unsigned) override{/* no parameters */};
-  void keyPressEvent(QKeyEvent *e) override;
-  void keyReleaseEvent(QKeyEvent *e) override;
 
 private:
-  constexpr static unsigned m_maxSideWidth = 256;
   std::vector<RegDesc> m_regDescs;
-  std::map<IdxToDir, QAbstractButton *> m_buttons;
 };
 } // namespace Ripes
@@ -0,0 +1,90 @@
+#include "iodpadview.h"
+
+#include <QGridLayout>
+#include <QKeyEvent>
+#include <QToolButton>
+
+namespace Ripes {
+
+IODPadView::IODPadView(IODPad *dpad, QWidget *parent)
+    : IOView(dpad, parent), m_dpad(dpad) {
+  for (unsigned i = 0; i < IODPad::DIRECTIONS; ++i) {
+    Qt::ArrowType arrow;
+    switch (i) {
+    case IODPad::UP:
+      arrow = Qt::UpArrow;
+      break;
+    case IODPad::DOWN:
+      arrow = Qt::DownArrow;
+      break;
+    case IODPad::LEFT:
+      arrow = Qt::LeftArrow;
+      break;
+    case IODPad::RIGHT:
+      arrow = Qt::RightArrow;
+      break;
+    }
+    auto *button = new QToolButton();
+    const auto dir = static_cast<IODPad::IdxToDir>(i);
+    m_buttons[dir] = button;
+    button->setArrowType(arrow);
+    connect(button, &QAbstractButton::pressed, this,
+            [=] { m_dpad->setButton(dir, true); });
+    connect(button, &QAbstractButton::released, this,
+            [=] { m_dpad->setButton(dir, false); });
+  }
+
+  auto *gridLayout = new QGridLayout();
+  gridLayout->addWidget(m_buttons[IODPad::UP], 0, 1);
+  gridLayout->addWidget(m_buttons[IODPad::DOWN], 2, 1);
+  gridLayout->addWidget(m_buttons[IODPad::LEFT], 1, 0);
+  gridLayout->addWidget(m_buttons[IODPad::RIGHT], 1, 2);
+
+  setLayout(gridLayout);
+}
+
+void IODPadView::refresh() {
+  // Reflect any button state which was driven from outside of this view (ie.
+  // scripted inputs or keyboard presses).
+  for (const auto &it : m_buttons) {
+    it.second->setDown(m_dpad->buttonState(it.first));
+  }
+}
+
+void IODPadView::keyPressEvent(QKeyEvent *e) {
+  switch (e->key()) {
+  case Qt::Key_A:
+    m_dpad->setButton(IODPad::LEFT, true);
+    return;
+  case Qt::Key_D:
+    m_dpad->setButton(IODPad::RIGHT, true);
+    return;
+  case Qt::Key_W:
+    m_dpad->setButton(IODPad::UP, true);
+    return;
+  case Qt::Key_S:
+    m_dpad->setButton(IODPad::DOWN, true);
+    return;
+  }
+  IOView::keyPressEvent(e);
+}
+
+void IODPadView::keyReleaseEvent(QKeyEvent *e) {
+  switch (e->key()) {
+  case Qt::Key_A:
+    m_dpad->setButton(IODPad::LEFT, false);
+    return;
+  case Qt::Key_D:
+    m_dpad->setButton(IODPad::RIGHT, false);
+    return;
+  case Qt::Key_W:
+    m_dpad->setButton(IODPad::UP, false);
+    return;
+  case Qt::Key_S:
+    m_dpad->setButton(IODPad::DOWN, false);
+    return;
+  }
+  IOView::keyReleaseEvent(e);
+}
+
+} // namespace Ripes
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QWidget>
+
+QT_FORWARD_DECLARE_CLASS(QAbstractButton);
+
+#include "iodpad.h"
+#include "ioview.h"
+
+namespace Ripes {
+
+class IODPadView : public IOView {
+  Q_OBJECT
+
+public:
+  IODPadView(IODPad *dpad, QWidget *parent);
+
+protected:
+  void refresh() override;
+  void keyPressEvent(QKeyEvent *e) override;
+  void keyReleaseEvent(QKeyEvent *e) override;
+
+private:
+  IODPad *m_dpad = nullptr;
+  std::map<IODPad::IdxToDir, QAbstractButton *> m_buttons;
+};
+} // namespace Ripes
@@ -1,14 +1,11 @@
 #include "ioledmatrix.h"
 
-#include <QPainter>
-#include <QPen>
-
 #include "STLExtras.h"
 #include "ioregistry.h"
 
 namespace Ripes {
 
-IOLedMatrix::IOLedMatrix(QWidget *parent) : IOBase(IOType::LED_MATRIX, parent) {
+IOLedMatrix::IOLedMatrix(QObject *parent) : IOBase(IOType::LED_MATRIX, parent) {
   constexpr unsigned defaultWidth = 25;
 
   // Parameters
@@ -18,9 +15,6 @@ IOLedMatrix::IOLedMatrix(QWidget *parent) : IOBase(IOType::LED_MATRIX, parent) {
       IOParam(WIDTH, "Width", defaultWidth + 10, true, 1, m_maxSideWidth);
   m_parameters[SIZE] = IOParam(SIZE, "LED size", 8, true, 1, 100);
 
-  m_pen.setWidth(1);
-  m_pen.setColor(Qt::black);
-
   updateLEDRegs();
 }
 
@@ -44,28 +38,38 @@ QString IOLedMatrix::description() const {
 }
 
 VInt IOLedMatrix::ioRead(AInt offset, unsigned size) {
-  return (m_ledRegs.at(offset / 4) >> (offset % 4)) &
+  return (m_regs.read(offset / 4) >> (offset % 4)) &
          vsrtl::generateBitmask(size * 8);
 }
 
 void IOLedMatrix::ioWrite(AInt offset, VInt value, unsigned) {
   offset >>= 2; // word addressable
-  if (offset >= m_ledRegs.size()) {
+  if (offset >= m_regs.size()) {
     Q_ASSERT(false);
+    return;
   }
-  m_ledRegs.at(offset) = value;
-  emit scheduleUpdate();
+  m_regs.write(offset, value);
+  m_dirtyRows[offset / m_width].store(true, std::memory_order_release);
+  markDirty();
 }
 
-static QColor regToColor(uint32_t regVal) {
-  return QColor(regVal >> 16 & 0xFF, regVal >> 8 & 0xFF, regVal & 0xFF);
+void IOLedMatrix::markAllRowsDirty() {
+  for (auto &row : m_dirtyRows) {
+    row.store(true, std::memory_order_relaxed);
+  }
+  markDirty();
 }
 
 void IOLedMatrix::updateLEDRegs() {
   const unsigned width = m_parameters[WIDTH].value.toInt();
   const unsigned height = m_parameters[HEIGHT].value.toInt();
   const int nLEDs = width * height;
-  m_ledRegs.resize(nLEDs);
+  m_regs.resize(nLEDs);
+
+  m_width = width;
+  m_height = height;
+  m_ledSize = m_parameters[SIZE].value.toInt();
+  markAllRowsDirty();
 
   m_extraSymbols.clear();
   m_extraSymbols.push_back(IOSymbol{"WIDTH", width});
@@ -83,41 +87,7 @@ void IOLedMatrix::updateLEDRegs() {
     mRegDesc.value() = regdesc;
   }
 
-  updateGeometry();
   emit regMapChanged();
 }
 
-QSize IOLedMatrix::minimumSizeHint() const {
-  const int width = m_parameters.at(WIDTH).value.toInt();
-  const int height = m_parameters.at(HEIGHT).value.toInt();
-  const int size = m_parameters.at(SIZE).value.toInt();
-  const int pixelWidth = width * (size + m_pen.width());
-  const int pixelHeight = height * (size + m_pen.width());
-  return QSize(pixelWidth, pixelHeight);
-}
-
-void IOLedMatrix::paintEvent(QPaintEvent *) {
-  QPainter painter(this);
-  painter.setRenderHint(QPainter::Antialiasing);
-
-  painter.setPen(m_pen);
-
-  const int width = m_parameters[WIDTH].value.toInt();
-  const int height = m_parameters[HEIGHT].value.toInt();
-  const int size = m_parameters[SIZE].value.toInt();
-  for (int y = 0; y < height; y++) {
-    for (int x = 0; x < width; x++) {
-      QBrush brush(regToColor(m_ledRegs.at(y * width + x)));
-      painter.setBrush(brush);
-
-      const unsigned xpos = x * (size + m_pen.width());
-      const unsigned ypos = y * (size + m_pen.width());
-
-      painter.drawEllipse(xpos, ypos, size, size);
-    }
-  }
-
-  painter.end();
-}
-
 } // namespace Ripes
@@ -1,8 +1,9 @@
 #pragma once
 
-#include <QPen>
 #include <QVariant>
-#include <QWidget>
+
+#include <array>
+#include <atomic>
 
 #include "iobase.h"
 
@@ -14,7 +15,7 @@ class IOLedMatrix : public IOBase {
   enum Parameters { HEIGHT, WIDTH, SIZE };
 
 public:
-  IOLedMatrix(QWidget *parent);
+  IOLedMatrix(QObject *parent);
   ~IOLedMatrix() { unregister(); };
 
   virtual unsigned byteSize() const override;
@@ -35,27 +36,48 @@ public:
   virtual void ioWrite(AInt offset, VInt value, unsigned size) override;
 
   virtual void reset() override {
-    std::fill(m_ledRegs.begin(), m_ledRegs.end(), 0);
+    m_regs.clear();
+    markAllRowsDirty();
   }
 
-protected:
-  virtual void parameterChanged(unsigned) override { updateLEDRegs(); };
+  /**
+   * @brief matrixWidth, matrixHeight, ledSize
+   * Cached copies of the matrix parameters, avoiding parameter map lookups
+   * while rendering.
+   */
+  unsigned matrixWidth() const { return m_width; }
+  unsigned matrixHeight() const { return m_height; }
+  unsigned ledSize() const { return m_ledSize; }
 
   /**
-   * QWidget drawing
+   * @brief takeRowDirty
+   * Clears the dirty flag of row @p y, returning whether it was set. A row is
+   * flagged as dirty whenever one of its LEDs is written by the processor.
    */
-  void paintEvent(QPaintEvent *event) override;
-  QSize minimumSizeHint() const override;
+  bool takeRowDirty(unsigned y) {
+    return m_dirtyRows[y].exchange(false, std::memory_order_acquire);
+  }
+
+protected:
+  virtual void parameterChanged(unsigned) override { updateLEDRegs(); };
 
 private:
-  VInt regRead(AInt offset) const;
   void updateLEDRegs();
+  void markAllRowsDirty();
 
-  unsigned m_maxSideWidth = 256;
-  std::vector<uint32_t> m_ledRegs;
+  static constexpr unsigned m_maxSideWidth = 256;
   std::vector<RegDesc> m_regDescs;
   std::vector<IOSymbol> m_extraSymbols;
 
-  QPen m_pen;
+  unsigned m_width = 0;
+  unsigned m_height = 0;
+  unsigned m_ledSize = 0;
+
+  /**
+   * @brief m_dirtyRows
+   * Rows which have been written to by the processor since they were last
+   * rendered.
+   */
+  std::array<std::atomic<bool>, m_maxSideWidth> m_dirtyRows;
 };
 } // namespace Ripes
@@ -0,0 +1,84 @@
+#include "ioledmatrixview.h"
+
+#include <QPaintEvent>
+#include <QPainter>
+
+namespace Ripes {
+
+static QColor regToColor(uint32_t regVal) {
+  return QColor(regVal >> 16 & 0xFF, regVal >> 8 & 0xFF, regVal & 0xFF);
+}
+
+IOLedMatrixView::IOLedMatrixView(IOLedMatrix *ledMatrix, QWidget *parent)
+    : IOView(ledMatrix, parent), m_ledMatrix(ledMatrix) {
+  m_pen.setWidth(1);
+  m_pen.setColor(Qt::black);
+  parametersChanged();
+}
+
+void IOLedMatrixView::parametersChanged() {
+  m_image = QImage(minimumSizeHint(), QImage::Format_ARGB32_Premultiplied);
+  m_image.fill(Qt::transparent);
+  // The peripheral marks all rows as dirty upon a parameter change; render the
+  // full matrix right away rather than waiting for the next UI update.
+  refresh();
+  IOView::parametersChanged();
+}
+
+QSize IOLedMatrixView::minimumSizeHint() const {
+  const int pitch = m_ledMatrix->ledSize() + m_pen.width();
+  return QSize(m_ledMatrix->matrixWidth() * pitch,
+               m_ledMatrix->matrixHeight() * pitch);
+}
+
+void IOLedMatrixView::renderRow(QPainter &painter, unsigned y) {
+  const unsigned width = m_ledMatrix->matrixWidth();
+  const int size = m_ledMatrix->ledSize();
+  const int pitch = size + m_pen.width();
+  const int ypos = y * pitch;
+
+  // Clear the row before redrawing, given that LEDs are drawn antialiased.
+  painter.setCompositionMode(QPainter::CompositionMode_Source);
+  painter.fillRect(0, ypos, m_image.width(), pitch, Qt::transparent);
+  painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+  for (unsigned x = 0; x < width; x++) {
+    painter.setBrush(QBrush(regToColor(m_frame.at(y * width + x))));
+    painter.drawEllipse(x * pitch, ypos, size, size);
+  }
+}
+
+void IOLedMatrixView::refresh() {
+  // Dirty flags are consumed before taking the register snapshot; any write
+  // racing with the snapshot will re-flag its row for the next refresh.
+  std::vector<unsigned> dirtyRows;
+  for (unsigned y = 0; y < m_ledMatrix->matrixHeight(); y++) {
+    if (m_ledMatrix->takeRowDirty(y)) {
+      dirtyRows.push_back(y);
+    }
+  }
+  if (dirtyRows.empty()) {
+    return;
+  }
+
+  m_ledMatrix->registerBlock().snapshot(m_frame);
+
+  QPainter painter(&m_image);
+  painter.setRenderHint(QPainter::Antialiasing);
+  painter.setPen(m_pen);
+
+  const int pitch = m_ledMatrix->ledSize() + m_pen.width();
+  for (unsigned y : dirtyRows) {
+    renderRow(painter, y);
+    update(0, y * pitch, m_image.width(), pitch);
+  }
+  painter.end();
+}
+
+void IOLedMatrixView::paintEvent(QPaintEvent *event) {
+  QPainter painter(this);
+  painter.drawImage(event->rect(), m_image, event->rect());
+  painter.end();
+}
+
+} // namespace Ripes
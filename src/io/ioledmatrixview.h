@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QImage>
+#include <QPen>
+
+#include "ioledmatrix.h"
+#include "ioview.h"
+
+namespace Ripes {
+
+class IOLedMatrixView : public IOView {
+  Q_OBJECT
+
+public:
+  IOLedMatrixView(IOLedMatrix *ledMatrix, QWidget *parent);
+
+protected:
+  void refresh() override;
+  void parametersChanged() override;
+
+  void paintEvent(QPaintEvent *event) override;
+  QSize minimumSizeHint() const override;
+
+private:
+  /**
+   * @brief renderRow
+   * Renders row @p y of the LED matrix into the cached LED image.
+   */
+  void renderRow(QPainter &painter, unsigned y);
+
+  IOLedMatrix *m_ledMatrix = nullptr;
+
+  /**
+   * @brief m_image
+   * Cached rendering of the LED matrix, which paintEvent blits to the widget.
+   */
+  QImage m_image;
+
+  /**
+   * @brief m_frame
+   * Snapshot of the LED registers used when rendering m_image.
+   */
+  std::vector<uint32_t> m_frame;
+
+  QPen m_pen;
+};
+} // namespace Ripes
@@ -3,6 +3,7 @@
 #include "processorhandler.h"
 #include "ripessettings.h"
 
+#include <algorithm>
 #include <memory>
 #include <ostream>
 
@@ -18,9 +19,30 @@ IOManager::IOManager() : QObject(nullptr) {
   connect(ProcessorHandler::get(), &ProcessorHandler::processorReset, this,
           &IOManager::refreshMemoryMap);
 
+  // Peripheral repaints are rate-limited to the UI update frequency.
+  m_compositorTimer.setInterval(
+      1000.0 / RipesSettings::value(RIPES_SETTING_UIUPDATEPS).toInt());
+  connect(RipesSettings::getObserver(RIPES_SETTING_UIUPDATEPS),
+          &SettingObserver::modified, this, [=] {
+            m_compositorTimer.setInterval(
+                1000.0 /
+                RipesSettings::value(RIPES_SETTING_UIUPDATEPS).toInt());
+          });
+  connect(&m_compositorTimer, &QTimer::timeout, this,
+          &IOManager::refreshDirtyPeripherals);
+  m_compositorTimer.start();
+
   refreshMemoryMap();
 }
 
+void IOManager::refreshDirtyPeripherals() {
+  for (auto *device : m_peripherals) {
+    if (device->takeDirty()) {
+      emit device->repaintRequested();
+    }
+  }
+}
+
 QString IOManager::cSymbolsHeaderpath() const {
   if (m_symbolsHeaderFile) {
     return m_symbolsHeaderFile->fileName();
@@ -32,7 +54,7 @@ QString IOManager::cSymbolsHeaderpath() const {
 void IOManager::reset() {
   for (auto &device : m_peripherals) {
     device->reset();
-    device->update();
+    device->markDirty();
   }
 }
 
@@ -77,30 +99,66 @@ void IOManager::peripheralSizeChanged(IOBase *) {
 }
 
 void IOManager::registerPeripheralWithProcessor(IOBase *peripheral) {
-  ProcessorHandler::getMemory().addIORegion(
-      m_periphMMappings.at(peripheral).startAddr, peripheral->byteSize(),
-      vsrtl::core::IOFunctors{
-          [peripheral](AInt offset, VInt value, unsigned size) {
-            peripheral->ioWrite(offset, value, size);
-          },
-          [peripheral](AInt offset, unsigned size) {
-            return peripheral->ioRead(offset, size);
-          }});
-
   peripheral->memWrite = [](AInt address, VInt value, unsigned size) {
     ProcessorHandler::getMemory().writeMem(address, value, size);
   };
   peripheral->memRead = [](AInt address, unsigned size) {
     return ProcessorHandler::getMemory().readMem(address, size);
   };
+
+  refreshIORegions();
 }
 
 void IOManager::unregisterPeripheralWithProcessor(IOBase *peripheral) {
   const auto &mmEntry = m_periphMMappings.find(peripheral);
   if (mmEntry != m_periphMMappings.end()) {
-    ProcessorHandler::getMemory().removeIORegion(mmEntry->second.startAddr,
-                                                 mmEntry->second.size);
     m_periphMMappings.erase(mmEntry);
+    refreshIORegions();
+  }
+}
+
+void IOManager::refreshIORegions() {
+  auto &memory = ProcessorHandler::getMemory();
+  for (const auto &region : m_processorIORegions) {
+    memory.removeIORegion(region.first, region.second);
+  }
+  m_processorIORegions.clear();
+
+  std::vector<IORegion> regions;
+  for (const auto &periph : m_periphMMappings) {
+    regions.push_back(
+        {periph.first, periph.second.startAddr, periph.second.size});
+  }
+  m_ioDispatch.rebuild(regions);
+
+  // Coalesce adjacent peripherals into a single IO region. Gaps between
+  // peripherals are left unmapped, as they were before.
+  std::sort(regions.begin(), regions.end(),
+            [](const IORegion &a, const IORegion &b) {
+              return a.start < b.start;
+            });
+  for (const auto &region : regions) {
+    if (!m_processorIORegions.empty()) {
+      auto &last = m_processorIORegions.back();
+      if (last.first + last.second == region.start) {
+        last.second += region.size;
+        continue;
+      }
+    }
+    m_processorIORegions.push_back({region.start, region.size});
+  }
+
+  for (const auto &region : m_processorIORegions) {
+    const AInt start = region.first;
+    memory.addIORegion(
+        start, region.second,
+        vsrtl::core::IOFunctors{
+            [this, start](AInt offset, VInt value, unsigned size) {
+              m_ioDispatch.ioWrite(start + offset, value, size);
+            },
+            [this, start](AInt offset, unsigned size) {
+              return m_ioDispatch.ioRead(start + offset, size);
+            }});
   }
 }
 
@@ -136,9 +194,10 @@ void IOManager::removePeripheral(IOBase *peripheral, std::atomic<bool> &ok) {
 }
 
 void IOManager::refreshAllPeriphsToProcessor() {
-  for (const auto &periph : m_periphMMappings) {
-    registerPeripheralWithProcessor(periph.first);
-  }
+  // The IO regions registered with the previous processor were destroyed
+  // alongside its memory.
+  m_processorIORegions.clear();
+  refreshIORegions();
 }
 
 void IOManager::refreshMemoryMap() {
@@ -208,7 +267,9 @@ void IOManager::updateSymbols() {
                   "*****************";
 
     auto symbols = assemblerSymbolsForPeriph(p.first);
-    m_assemblerSymbols.abs.insert(symbols.begin(), symbols.end());
+    for (const auto &symbol : symbols)
+      m_assemblerSymbols.setValue(m_assemblerSymbols.intern(symbol.first),
+                                  symbol.second);
 
     for (const auto &symbol : assemblerSymbolsForPeriph(p.first)) {
       headerfile << "#define " + symbol.first.v + "\t" + "(0x" +
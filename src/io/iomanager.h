@@ -3,9 +3,11 @@
 #include "assembler/assembler_defines.h"
 #include "assembler/symbolmap.h"
 #include "iobase.h"
+#include "iodispatch.h"
 #include "ioregistry.h"
 
 #include <QFile>
+#include <QTimer>
 
 namespace Ripes {
 
@@ -83,6 +85,13 @@ private:
   void refreshMemoryMap();
   void peripheralSizeChanged(IOBase *peripheral);
 
+  /**
+   * @brief refreshDirtyPeripherals
+   * Requests a repaint of all peripherals which have been marked dirty since
+   * the last UI update.
+   */
+  void refreshDirtyPeripherals();
+
   /**
    * @brief registerPeripheralWithProcessor
    * Registers @param peripheral with the processor. Specifically, the
@@ -93,6 +102,15 @@ private:
   void registerPeripheralWithProcessor(IOBase *peripheral);
   void unregisterPeripheralWithProcessor(IOBase *peripheral);
 
+  /**
+   * @brief refreshIORegions
+   * Rebuilds the IO dispatch table from the current peripheral mappings, and
+   * registers a single IO region with the processor memory for each contiguous
+   * range of peripherals. Loads and stores to peripherals are then dispatched
+   * through m_ioDispatch instead of through per-peripheral IO regions.
+   */
+  void refreshIORegions();
+
   /**
    * @brief refreshAllPeriphsToProcessor
    * Shall be called after changing the processor. Registers all the currently
@@ -114,6 +132,21 @@ private:
   std::set<IOBase *> m_peripherals;
   Assembler::SymbolMap m_assemblerSymbols;
   std::unique_ptr<QFile> m_symbolsHeaderFile;
+  IODispatchTable m_ioDispatch;
+
+  /**
+   * @brief m_processorIORegions
+   * {start, size} of the IO regions currently registered with the processor
+   * memory.
+   */
+  std::vector<std::pair<AInt, unsigned>> m_processorIORegions;
+
+  /**
+   * @brief m_compositorTimer
+   * Periodically refreshes dirty peripherals. This coalesces any number of
+   * peripheral state changes in between two UI updates into a single repaint.
+   */
+  QTimer m_compositorTimer;
 };
 
 } // namespace Ripes
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Ripes {
+
+/**
+ * @brief The IORegisterBlock class
+ * Register file of an IO peripheral, shared between the simulation thread and
+ * the GUI thread.
+ *
+ * Each register is a 32-bit word which is read and written atomically, making
+ * single-register accesses race-free and wait-free from either thread. Writes
+ * additionally bump a sequence counter (a seqlock), allowing the GUI to take a
+ * consistent snapshot of the full register file for rendering.
+ *
+ * A register block is assumed to have a single writing thread at any point in
+ * time (ie. the simulation thread for output peripherals, the GUI thread for
+ * input peripherals).
+ */
+class IORegisterBlock {
+public:
+  IORegisterBlock() = default;
+  IORegisterBlock(const IORegisterBlock &) = delete;
+  IORegisterBlock &operator=(const IORegisterBlock &) = delete;
+
+  /**
+   * @brief resize
+   * Resizes the block to @p nWords registers, all initialized to zero. Not
+   * thread safe; must only be called while the processor is not accessing the
+   * peripheral (ie. upon parameter changes).
+   */
+  void resize(unsigned nWords) {
+    m_words = std::make_unique<std::atomic<uint32_t>[]>(nWords);
+    m_size = nWords;
+    clear();
+  }
+
+  unsigned size() const { return m_size; }
+
+  uint32_t read(unsigned idx) const {
+    Q_ASSERT(idx < m_size);
+    return m_words[idx].load(std::memory_order_relaxed);
+  }
+
+  void write(unsigned idx, uint32_t value) {
+    Q_ASSERT(idx < m_size);
+    beginWrite();
+    m_words[idx].store(value, std::memory_order_relaxed);
+    endWrite();
+  }
+
+  /**
+   * @brief setBit
+   * Sets or clears bit @p bit of register @p idx.
+   */
+  void setBit(unsigned idx, unsigned bit, bool value) {
+    Q_ASSERT(idx < m_size);
+    beginWrite();
+    if (value) {
+      m_words[idx].fetch_or(1u << bit, std::memory_order_relaxed);
+    } else {
+      m_words[idx].fetch_and(~(1u << bit), std::memory_order_relaxed);
+    }
+    endWrite();
+  }
+
+  void clear() {
+    beginWrite();
+    for (unsigned i = 0; i < m_size; ++i) {
+      m_words[i].store(0, std::memory_order_relaxed);
+    }
+    endWrite();
+  }
+
+  /**
+   * @brief version
+   * @returns a counter which changes upon every write to the block. May be used
+   * to cheaply detect whether the register file has changed.
+   */
+  unsigned version() const { return m_seq.load(std::memory_order_acquire); }
+
+  /**
+   * @brief snapshot
+   * Copies the register file into @p out. The copy is retried if a write
+   * occurred concurrently. To avoid starving the reader while the writer is
+   * continuously active, the last copy is accepted after a bounded number of
+   * retries; each register value is still individually consistent.
+   * @returns true if the snapshot is consistent across all registers.
+   */
+  bool snapshot(std::vector<uint32_t> &out) const {
+    constexpr unsigned maxRetries = 4;
+    out.resize(m_size);
+    for (unsigned attempt = 0; attempt < maxRetries; ++attempt) {
+      const unsigned seqBefore = m_seq.load(std::memory_order_acquire);
+      for (unsigned i = 0; i < m_size; ++i) {
+        out[i] = m_words[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      const unsigned seqAfter = m_seq.load(std::memory_order_relaxed);
+      if ((seqBefore & 1) == 0 && seqBefore == seqAfter) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  void beginWrite() {
+    const unsigned seq = m_seq.load(std::memory_order_relaxed);
+    m_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  void endWrite() {
+    m_seq.store(m_seq.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  std::unique_ptr<std::atomic<uint32_t>[]> m_words;
+  unsigned m_size = 0;
+  std::atomic<unsigned> m_seq{0};
+};
+
+} // namespace Ripes
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "iobase.h"
-#include <QWidget>
+#include <QObject>
 
 #include "iodpad.h"
 #include "ioledmatrix.h"
@@ -10,10 +10,12 @@
 /** @brief IORegistry
  *
  * This is where all peripherals should be registerred to be made available in
- * the UI. The peripheral must be registerred three times:
+ * the UI. The peripheral must be registerred four times:
  * - Add it to the IOType enum
  * - Add it to the IOTypeTitles map (Associate a name with the peripheral)
  * - Add it to the IOFactories map (Associate a constructor with the peripheral)
+ * - Add it to the IOViewFactories map in ioviewregistry.h (Associate a view
+ *   with the peripheral)
  */
 
 namespace Ripes {
@@ -21,12 +23,12 @@ namespace Ripes {
 enum IOType { LED_MATRIX, SWITCHES, DPAD, NPERIPHERALS };
 
 template <typename T>
-IOBase *createIO(QWidget *parent) {
+IOBase *createIO(QObject *parent) {
   static_assert(std::is_base_of<IOBase, T>::value);
   return new T(parent);
 }
 
-using IOFactory = std::function<IOBase *(QWidget *parent)>;
+using IOFactory = std::function<IOBase *(QObject *parent)>;
 
 const static std::map<IOType, QString> IOTypeTitles = {
     {IOType::LED_MATRIX, "LED Matrix"},
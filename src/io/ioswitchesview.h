@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QGridLayout>
+#include <QLabel>
+#include <QPen>
+#include <QtCore/QPropertyAnimation>
+#include <QtWidgets/QAbstractButton>
+
+#include "ioswitches.h"
+#include "ioview.h"
+
+namespace Ripes {
+
+/**
+ * Toggle button with slider. Based on
+ * https://codereview.stackexchange.com/questions/249076/implementing-toggle-button-using-qt
+ */
+
+class ToggleButton : public QAbstractButton {
+  Q_OBJECT
+  Q_PROPERTY(int mOffset READ offset WRITE setOffset NOTIFY mOffsetChanged);
+
+public:
+  explicit ToggleButton(int trackRadius, int thumbRadius, bool rotated,
+                        QWidget *parent = nullptr);
+  ~ToggleButton();
+
+  QSize sizeHint() const override;
+  void setChecked(bool checked);
+
+signals:
+  void mOffsetChanged(int);
+
+protected:
+  void paintEvent(QPaintEvent *) override;
+  void resizeEvent(QResizeEvent *) override;
+  void mouseReleaseEvent(QMouseEvent *) override;
+  void enterEvent(QEnterEvent *event) override;
+
+  int offset();
+  void setOffset(int value);
+
+private:
+  bool mRotated = false;
+  qreal mOffset;
+  qreal mBaseOffset;
+  qreal mMargin;
+  qreal mTrackRadius;
+  qreal mThumbRadius;
+  qreal mOpacity;
+  QPropertyAnimation *mAnimation;
+
+  QHash<bool, qreal> mEndOffset;
+  QHash<bool, QBrush> mTrackColor;
+  QHash<bool, QBrush> mThumbColor;
+  QHash<bool, QColor> mTextColor;
+  QHash<bool, QString> mThumbText;
+};
+
+class IOSwitchesView : public IOView {
+  Q_OBJECT
+
+public:
+  IOSwitchesView(IOSwitches *switches, QWidget *parent);
+
+protected:
+  void refresh() override;
+  void parametersChanged() override;
+
+private:
+  void updateSwitches();
+
+  IOSwitches *m_switchesModel = nullptr;
+  std::map<unsigned, std::pair<QLabel *, ToggleButton *>> m_switches;
+  QGridLayout *m_switchLayout;
+};
+} // namespace Ripes
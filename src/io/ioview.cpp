@@ -0,0 +1,13 @@
+#include "ioview.h"
+
+namespace Ripes {
+
+IOView::IOView(IOBase *peripheral, QWidget *parent)
+    : QWidget(parent), m_peripheral(peripheral) {
+  m_peripheral->setParent(this);
+  connect(m_peripheral, &IOBase::repaintRequested, this, &IOView::refresh);
+  connect(m_peripheral, &IOBase::paramsChanged, this,
+          &IOView::parametersChanged);
+}
+
+} // namespace Ripes
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QPointer>
+#include <QWidget>
+
+#include "iobase.h"
+
+namespace Ripes {
+
+/**
+ * @brief The IOView class
+ * Graphical representation of an IO peripheral model. A view takes ownership
+ * of its peripheral; deleting the view deletes (and thereby unregisters) the
+ * peripheral.
+ */
+class IOView : public QWidget {
+  Q_OBJECT
+
+public:
+  IOView(IOBase *peripheral, QWidget *parent);
+
+  IOBase *peripheral() const { return m_peripheral; }
+
+protected:
+  /**
+   * @brief refresh
+   * Called on the GUI thread whenever the peripheral requests a repaint (see
+   * IOBase::repaintRequested). Views may override this to re-render any cached
+   * visual state, or to synchronize widgets with the peripheral register
+   * state.
+   */
+  virtual void refresh() { update(); }
+
+  /**
+   * @brief parametersChanged
+   * Called whenever a parameter of the peripheral has been changed.
+   */
+  virtual void parametersChanged() { updateGeometry(); }
+
+private:
+  QPointer<IOBase> m_peripheral;
+};
+
+} // namespace Ripes
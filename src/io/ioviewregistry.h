@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ioregistry.h"
+#include "ioview.h"
+
+#include "iodpadview.h"
+#include "ioledmatrixview.h"
+#include "ioswitchesview.h"
+
+/** @brief IOViewRegistry
+ *
+ * Associates each peripheral type in IOType with the view used to display it
+ * in the UI.
+ */
+
+namespace Ripes {
+
+template <typename ViewT, typename PeriphT>
+IOView *createIOView(IOBase *peripheral, QWidget *parent) {
+  static_assert(std::is_base_of<IOView, ViewT>::value);
+  auto *typedPeripheral = dynamic_cast<PeriphT *>(peripheral);
+  Q_ASSERT(typedPeripheral != nullptr);
+  return new ViewT(typedPeripheral, parent);
+}
+
+using IOViewFactory =
+    std::function<IOView *(IOBase *peripheral, QWidget *parent)>;
+
+const static std::map<IOType, IOViewFactory> IOViewFactories = {
+    {IOType::LED_MATRIX, createIOView<IOLedMatrixView, IOLedMatrix>},
+    {IOType::SWITCHES, createIOView<IOSwitchesView, IOSwitches>},
+    {IOType::DPAD, createIOView<IODPadView, IODPad>}};
+
+} // namespace Ripes
@@ -1,6 +1,7 @@
 #include "iotab.h"
 #include "ui_iotab.h"
 
+#include <QApplication>
 #include <QDockWidget>
 #include <QGraphicsItem>
 #include <QMdiSubWindow>
@@ -55,14 +56,14 @@ IOTab::IOTab(QToolBar *toolbar, QWidget *parent)
             if (w == nullptr) {
               setPeripheralTabActive(nullptr);
             } else {
-              // MDI window -> QMainwindow -> QDockWidget -> IOBase widget...
+              // MDI window -> QMainwindow -> QDockWidget -> IOView widget...
               // Whew!
               auto *w1 = w->widget();
               auto *w2 = w1->findChildren<QDockWidget *>().at(0);
               auto *w3 = w2->widget();
-              auto *peripheral = dynamic_cast<IOBase *>(w3);
-              Q_ASSERT(peripheral != nullptr);
-              this->setPeripheralTabActive(peripheral);
+              auto *view = dynamic_cast<IOView *>(w3);
+              Q_ASSERT(view != nullptr);
+              this->setPeripheralTabActive(view->peripheral());
             }
           });
 
@@ -110,6 +111,8 @@ void IOTab::updateIOSymbolFilePreview() {
 
 IOBase *IOTab::createPeripheral(IOType type, int forcedID) {
   auto *peripheral = IOManager::get().createPeripheral(type, forcedID);
+  // The view takes ownership of the peripheral.
+  auto *view = IOViewFactories.at(type)(peripheral, nullptr);
 
   // Create tab for peripheral
   auto *peripheralTab = new IOPeripheralTab(this, peripheral);
@@ -124,12 +127,12 @@ IOBase *IOTab::createPeripheral(IOType type, int forcedID) {
       mw); // Shouldn't be needed, but MDI windows aren't created without this?
   auto *dw = new QDockWidget();
   dw->setFeatures(dw->features() & ~QDockWidget::DockWidgetClosable);
-  dw->setWidget(peripheral);
+  dw->setWidget(view);
   dw->setAllowedAreas(Qt::AllDockWidgetAreas);
   mw->addDockWidget(Qt::TopDockWidgetArea, dw);
   auto *mdiw = m_ui->mdiArea->addSubWindow(mw);
   mdiw->setWindowTitle(peripheral->name());
-  peripheral->setFocus();
+  view->setFocus();
 
   /* The following ensures that the MDI window which a peripheral is contained
    * within is resized when the widget itself is resized. It seems a bit
@@ -259,8 +262,9 @@ IOTab::~IOTab() {
    * been removed, we need to delete all IOBase objects before deleting the
    * IOTab itself. The default deletion mechanism is incorrect for this, given
    * that IOTab is first deleted, and then the underlying QObject is deleted
-   * (which deletes its children, being the IOBase objects). We delete from the
-   * subwindows because they are the top-level parent of the IOBase objects.
+   * (which deletes its children, being the IOView objects which own the IOBase
+   * objects). We delete from the subwindows because they are the top-level
+   * parent of the IOView objects.
    */
 
   // Copy subwindows collection, so we can safely iterate through it
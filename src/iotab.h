@@ -11,6 +11,7 @@
 
 #include "io/iomanager.h"
 #include "io/ioregistry.h"
+#include "io/ioviewregistry.h"
 
 namespace Ripes {
 
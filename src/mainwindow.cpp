@@ -113,6 +113,10 @@ MainWindow::MainWindow(QWidget *parent)
   // Reset and program reload signals
   connect(ProcessorHandler::get(), &ProcessorHandler::processorReset,
           [=] { SystemIO::reset(); });
+  connect(ProcessorHandler::get(), &ProcessorHandler::simulationError, this,
+          [=](const QString &message) {
+            QMessageBox::warning(this, "Error", message);
+          });
 
   connect(m_ui->actionSystem_calls, &QAction::triggered, this, [=] {
     SyscallViewer v;
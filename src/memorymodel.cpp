@@ -3,6 +3,9 @@
 #include <QBrush>
 #include <QFont>
 
+#include <climits>
+
+#include "colors.h"
 #include "fonts.h"
 #include "processorhandler.h"
 
@@ -18,9 +21,71 @@ int MemoryModel::columnCount(const QModelIndex &) const {
 int MemoryModel::rowCount(const QModelIndex &) const { return m_rowsVisible; }
 
 void MemoryModel::processorWasClocked() {
-  // Reload model
-  beginResetModel();
-  endResetModel();
+  const unsigned bytes = ProcessorHandler::currentISA()->bytes();
+  if (bytes != m_bytes ||
+      m_rows.size() != static_cast<size_t>(m_rowsVisible)) {
+    reloadWindow();
+    return;
+  }
+
+  // Refresh the visible window in place, and notify the view of contiguous
+  // runs of rows which changed since the last refresh.
+  const int lastColumn = columnCount() - 1;
+  int firstChanged = -1;
+  for (int row = 0; row <= m_rowsVisible; ++row) {
+    const bool changed = row < m_rowsVisible && readRow(row, rowCells(row));
+    if (changed && firstChanged == -1) {
+      firstChanged = row;
+    } else if (!changed && firstChanged != -1) {
+      emit dataChanged(index(firstChanged, 0), index(row - 1, lastColumn));
+      firstChanged = -1;
+    }
+  }
+}
+
+void MemoryModel::applyMemoryWrites(
+    const std::vector<ProcessorSnapshot::MemoryWrite> &writes) {
+  if (m_rows.size() != static_cast<size_t>(m_rowsVisible) || m_bytes == 0)
+    return;
+
+  std::vector<bool> changedRows(m_rows.size(), false);
+  if (m_watchEnabled) {
+    // Only writes since the previous snapshot are highlighted.
+    for (unsigned row = 0; row < m_rows.size(); ++row) {
+      Cell *cells = rowCells(row);
+      for (unsigned i = 0; i < m_bytes; ++i) {
+        changedRows[row] = changedRows[row] || cells[i].written;
+        cells[i].written = false;
+      }
+    }
+  }
+
+  for (const auto &write : writes) {
+    for (unsigned byte = 0; byte < write.bytes; ++byte) {
+      const AInt address = write.address + byte;
+      const uint8_t value =
+          static_cast<uint8_t>((write.value >> (CHAR_BIT * byte)) & 0xFF);
+      for (unsigned row = 0; row < m_rows.size(); ++row) {
+        const Row &r = m_rows[row];
+        if (!r.valid || address < r.address || address - r.address >= m_bytes)
+          continue;
+        Cell &cell = rowCells(row)[address - r.address];
+        const bool written = m_watchEnabled && cell.value != value;
+        changedRows[row] = changedRows[row] || !cell.contained ||
+                           cell.value != value || cell.written != written;
+        cell.contained = true;
+        cell.value = value;
+        cell.written = cell.written || written;
+        break;
+      }
+    }
+  }
+
+  const int lastColumn = columnCount() - 1;
+  for (unsigned row = 0; row < m_rows.size(); ++row) {
+    if (changedRows[row])
+      emit dataChanged(index(row, 0), index(row, lastColumn));
+  }
 }
 
 AInt maxAddress() {
@@ -30,7 +95,7 @@ AInt maxAddress() {
 void MemoryModel::setCentralAddress(AInt address) {
   address = address - (address % ProcessorHandler::currentISA()->bytes());
   m_centralAddress = address;
-  processorWasClocked();
+  reloadWindow();
 }
 
 // Checks whether an overflow or underflow error occurred when calculating the
@@ -50,13 +115,79 @@ bool validAddressChange(AInt currentAddress, AInt newAddress) {
   return validAddress;
 }
 
+void MemoryModel::reloadWindow() {
+  beginResetModel();
+  m_bytes = ProcessorHandler::currentISA()->bytes();
+  m_rows.resize(m_rowsVisible);
+  m_cells.assign(m_rowsVisible * m_bytes, Cell());
+  for (int row = 0; row < m_rowsVisible; ++row) {
+    const AInt alignedAddress = static_cast<AInt>(m_centralAddress) +
+                                ((((m_rowsVisible * m_bytes) / 2) / m_bytes) *
+                                 m_bytes) -
+                                (row * m_bytes);
+    m_rows[row] = {alignedAddress,
+                   validAddressChange(m_centralAddress, alignedAddress)};
+    readRow(row, rowCells(row));
+  }
+  // A new window is not a write to any of its addresses.
+  for (auto &cell : m_cells)
+    cell.written = false;
+  endResetModel();
+}
+
+bool MemoryModel::readRow(int row, Cell *cells) const {
+  const Row &r = m_rows.at(row);
+  bool changed = false;
+  auto update = [&](Cell &cell, bool contained, uint8_t value) {
+    const bool written =
+        m_watchEnabled && contained && cell.contained && cell.value != value;
+    changed |= cell.contained != contained || cell.value != value ||
+               cell.written != written;
+    cell = {contained, written, value};
+  };
+
+  if (!r.valid) {
+    for (unsigned i = 0; i < m_bytes; ++i)
+      update(cells[i], false, 0);
+    return changed;
+  }
+
+  auto &mem = ProcessorHandler::getMemory();
+  bool allContained = true;
+  for (unsigned i = 0; i < m_bytes; ++i)
+    allContained &= mem.contains(r.address + i);
+
+  if (allContained) {
+    // The common case; the entire row is read in a single access.
+    const VInt value = mem.readMemConst(r.address, m_bytes);
+    for (unsigned i = 0; i < m_bytes; ++i)
+      update(cells[i], true,
+             static_cast<uint8_t>((value >> (CHAR_BIT * i)) & 0xFF));
+  } else {
+    // Dont read memory which is not present (this will create an entry in the
+    // memory if done so).
+    for (unsigned i = 0; i < m_bytes; ++i) {
+      const bool contained = mem.contains(r.address + i);
+      const VInt value = contained ? mem.readMemConst(r.address + i, 1) : 0;
+      update(cells[i], contained, static_cast<uint8_t>(value & 0xFF));
+    }
+  }
+  return changed;
+}
+
+void MemoryModel::setWatchEnabled(bool enabled) {
+  m_watchEnabled = enabled;
+  // Clear any highlighted writes.
+  processorWasClocked();
+}
+
 void MemoryModel::offsetCentralAddress(int rowOffset) {
   const int byteOffset = rowOffset * ProcessorHandler::currentISA()->bytes();
   const AInt newCenterAddress = m_centralAddress + byteOffset;
   m_centralAddress = validAddressChange(m_centralAddress, newCenterAddress)
                          ? newCenterAddress
                          : m_centralAddress;
-  processorWasClocked();
+  reloadWindow();
 }
 
 QVariant MemoryModel::headerData(int section, Qt::Orientation orientation,
@@ -76,7 +207,7 @@ QVariant MemoryModel::headerData(int section, Qt::Orientation orientation,
 
 void MemoryModel::setRowsVisible(int rows) {
   m_rowsVisible = rows;
-  processorWasClocked();
+  reloadWindow();
 }
 
 QVariant MemoryModel::data(const QModelIndex &index, int role) const {
@@ -91,42 +222,25 @@ QVariant MemoryModel::data(const QModelIndex &index, int role) const {
     return QFont(Fonts::monospace, 11);
   }
 
-  const auto bytes = ProcessorHandler::currentISA()->bytes();
-  // Calculate the word-aligned address corresponding to the row of the current
-  // index. If the central address is at one of its two extrema, based on the
-  // address space of the processor, the aligned address is invalid.
-  /*
-  AInt alignedAddress;
-  bool validAddress = true;
-  if (m_centralAddress == 0x0) {
-      validAddress &= index.row() < m_rowsVisible / 2;
-  }
-  if (m_centralAddress >= maxAddress()) {
-      validAddress &= index.row() > m_rowsVisible / 2;
-  }
-  if (validAddress) {
-      alignedAddress = static_cast<AInt>(m_centralAddress) + ((((m_rowsVisible *
-  bytes) / 2) / bytes) * bytes) - (index.row() * bytes);
-  }
-*/
-
-  const AInt alignedAddress =
-      static_cast<AInt>(m_centralAddress) +
-      ((((m_rowsVisible * bytes) / 2) / bytes) * bytes) - (index.row() * bytes);
-  const bool validAddress =
-      validAddressChange(m_centralAddress, alignedAddress);
+  if (index.row() >= static_cast<int>(m_rows.size()) ||
+      index.column() >= static_cast<int>(FIXED_COLUMNS_CNT + m_bytes))
+    return QVariant();
 
-  const unsigned byteOffset = index.column() - FIXED_COLUMNS_CNT;
+  const Row &row = m_rows.at(index.row());
+  const Cell *cells = rowCells(index.row());
+  const unsigned byteOffset =
+      index.column() == Column::WordValue ? 0
+                                          : index.column() - FIXED_COLUMNS_CNT;
 
   if (index.column() == Column::Address) {
     if (role == Qt::DisplayRole) {
-      return addrData(alignedAddress, validAddress);
+      return addrData(row);
     } else if (role == Qt::ForegroundRole) {
       // Assign a brush if one of the byte-indexed address covered by the
       // aligned address has been written to
       QVariant unusedAddressBrush;
-      for (unsigned i = 0; i < ProcessorHandler::currentISA()->bytes(); ++i) {
-        QVariant addressBrush = fgColorData(alignedAddress, i, validAddress);
+      for (unsigned i = 0; i < m_bytes; ++i) {
+        QVariant addressBrush = fgColorData(row, cells[i]);
         if (addressBrush.isNull()) {
           return addressBrush;
         } else {
@@ -138,14 +252,22 @@ QVariant MemoryModel::data(const QModelIndex &index, int role) const {
   } else {
     switch (role) {
     case Qt::ForegroundRole:
-      return fgColorData(alignedAddress,
-                         index.column() == Column::WordValue ? 0 : byteOffset,
-                         validAddress);
+      return fgColorData(row, cells[byteOffset]);
+    case Qt::BackgroundRole: {
+      bool written = cells[byteOffset].written;
+      if (index.column() == Column::WordValue) {
+        for (unsigned i = 0; i < m_bytes; ++i)
+          written |= cells[i].written;
+      }
+      if (written)
+        return QBrush(QColor(Colors::Medalist).lighter(170));
+      break;
+    }
     case Qt::DisplayRole:
       if (index.column() == Column::WordValue) {
-        return wordData(alignedAddress, validAddress);
+        return wordData(row, cells);
       } else {
-        return byteData(alignedAddress, byteOffset, validAddress);
+        return byteData(row, cells[byteOffset]);
       }
     default:
       break;
@@ -157,54 +279,46 @@ QVariant MemoryModel::data(const QModelIndex &index, int role) const {
 
 void MemoryModel::setRadix(Radix r) {
   m_radix = r;
-  processorWasClocked();
+  reloadWindow();
 }
 
-QVariant MemoryModel::addrData(AInt address, bool validAddress) const {
-  if (!validAddress) {
+QVariant MemoryModel::addrData(const Row &row) const {
+  if (!row.valid) {
     return "-";
   }
-  return encodeRadixValue(address, Radix::Hex,
-                          ProcessorHandler::currentISA()->bytes());
+  return encodeRadixValue(row.address, Radix::Hex, m_bytes);
 }
 
-QVariant MemoryModel::fgColorData(AInt address, AInt byteOffset,
-                                  bool validAddress) const {
-  if (!validAddress ||
-      !ProcessorHandler::getMemory().contains(address + byteOffset)) {
+QVariant MemoryModel::fgColorData(const Row &row, const Cell &cell) const {
+  if (!row.valid || !cell.contained) {
     return QBrush(Qt::lightGray);
   } else {
     return QVariant(); // default
   }
 }
 
-QVariant MemoryModel::byteData(AInt address, AInt byteOffset,
-                               bool validAddress) const {
-  if (!validAddress) {
+QVariant MemoryModel::byteData(const Row &row, const Cell &cell) const {
+  if (!row.valid) {
     return "-";
-  } else if (!ProcessorHandler::getMemory().contains(address + byteOffset)) {
-    // Dont read the memory (this will create an entry in the memory if done
-    // so). Instead, create a "fake" entry in the memory model, containing X's.
+  } else if (!cell.contained) {
+    // Memory which is not present is displayed as X's.
     return "X";
   } else {
-    VInt value =
-        ProcessorHandler::getMemory().readMemConst(address + byteOffset, 1);
-    return encodeRadixValue(value & 0xFF, m_radix, 1);
+    return encodeRadixValue(cell.value, m_radix, 1);
   }
 }
 
-QVariant MemoryModel::wordData(AInt address, bool validAddress) const {
-  if (!validAddress) {
+QVariant MemoryModel::wordData(const Row &row, const Cell *cells) const {
+  if (!row.valid) {
     return "-";
-  } else if (!ProcessorHandler::getMemory().contains(address)) {
-    // Dont read the memory (this will create an entry in the memory if done
-    // so). Instead, create a "fake" entry in the memory model, containing X's.
+  } else if (!cells[0].contained) {
+    // Memory which is not present is displayed as X's.
     return "X";
   } else {
-    unsigned bytes = ProcessorHandler::currentISA()->bytes();
-    return encodeRadixValue(
-        ProcessorHandler::getMemory().readMemConst(address, bytes), m_radix,
-        bytes);
+    VInt value = 0;
+    for (unsigned i = 0; i < m_bytes; ++i)
+      value |= static_cast<VInt>(cells[i].value) << (CHAR_BIT * i);
+    return encodeRadixValue(value, m_radix, m_bytes);
   }
 }
 
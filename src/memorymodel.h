@@ -2,8 +2,11 @@
 
 #include <QAbstractTableModel>
 
+#include "processorsnapshot.h"
 #include "radix.h"
 
+#include <vector>
+
 namespace Ripes {
 
 class MemoryModel : public QAbstractTableModel {
@@ -25,19 +28,60 @@ public:
   void setRadix(Radix r);
   Radix getRadix() const { return m_radix; }
 
+  /// Enables or disables the watch mode of the model. In watch mode, the
+  /// visible address window is watched for writes; bytes which were modified
+  /// since the previous refresh of the model are highlighted.
+  void setWatchEnabled(bool enabled);
+  bool watchEnabled() const { return m_watchEnabled; }
+
 public slots:
+  /// Refreshes the visible address window from memory. Only rows whose
+  /// contents changed are reported as changed to the view.
   void processorWasClocked();
+  /// Applies memory writes published in a processor snapshot to the visible
+  /// address window, without accessing memory. Used whilst the processor is
+  /// running.
+  void applyMemoryWrites(
+      const std::vector<Ripes::ProcessorSnapshot::MemoryWrite> &writes);
   void setRowsVisible(int rows);
   void offsetCentralAddress(int rowOffset);
   void setCentralAddress(Ripes::AInt address);
 
 private:
-  QVariant addrData(AInt address, bool validAddress) const;
-  QVariant byteData(AInt address, AInt byteOffset, bool validAddress) const;
-  QVariant wordData(AInt address, bool validAddress) const;
-  QVariant fgColorData(AInt address, AInt byteOffset, bool validAddress) const;
+  struct Cell {
+    // Whether the byte is present in memory.
+    bool contained = false;
+    // Whether the byte was modified at the last refresh (in watch mode).
+    bool written = false;
+    uint8_t value = 0;
+  };
+  struct Row {
+    AInt address = 0;
+    bool valid = false;
+  };
+
+  /// Recomputes the visible address window and reloads it, resetting the
+  /// model.
+  void reloadWindow();
+  /// Reads the contents of row @p row into @p cells. Returns true if any
+  /// cell changed.
+  bool readRow(int row, Cell *cells) const;
+  Cell *rowCells(int row) { return &m_cells[row * m_bytes]; }
+  const Cell *rowCells(int row) const { return &m_cells[row * m_bytes]; }
+
+  QVariant addrData(const Row &row) const;
+  QVariant byteData(const Row &row, const Cell &cell) const;
+  QVariant wordData(const Row &row, const Cell *cells) const;
+  QVariant fgColorData(const Row &row, const Cell &cell) const;
 
   Radix m_radix = Radix::Hex;
+  bool m_watchEnabled = false;
+
+  // Snapshot of the visible address window, as of the last refresh. Cells are
+  // stored row-major, with m_bytes cells per row.
+  unsigned m_bytes = 0;
+  std::vector<Row> m_rows;
+  std::vector<Cell> m_cells;
 
   AInt m_centralAddress = 0; // Memory address at the center of the model
   int m_rowsVisible = 0;     // Number of rows currently visible in the view
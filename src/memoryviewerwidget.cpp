@@ -1,6 +1,7 @@
 #include "memoryviewerwidget.h"
 #include "ui_memoryviewerwidget.h"
 
+#include <QCheckBox>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QTableView>
@@ -30,6 +31,11 @@ MemoryViewerWidget::MemoryViewerWidget(QWidget *parent)
           [=] { setEnabled(true); });
   connect(ProcessorHandler::get(), &ProcessorHandler::procStateChangedNonRun,
           this, [=] { this->updateView(); });
+  connect(ProcessorHandler::get(), &ProcessorHandler::snapshotPublished, this,
+          [=] {
+            m_memoryModel->applyMemoryWrites(
+                ProcessorHandler::getSnapshot().memoryWrites);
+          });
   connect(ProcessorHandler::get(), &ProcessorHandler::memoryFocusAddressChanged,
           this, &MemoryViewerWidget::setCentralAddress);
 }
@@ -57,6 +63,12 @@ void MemoryViewerWidget::setupNavigationWidgets() {
   layout->addWidget(new QLabel("Go to section: ", m_ui->flowParentLayout));
   layout->addWidget(m_goToSection);
   flowLayout->addItem(layout);
+
+  m_watchWrites = new QCheckBox("Highlight writes", m_ui->flowParentLayout);
+  m_watchWrites->setToolTip(
+      "Highlight bytes within the visible memory region which were modified "
+      "since the view was last updated");
+  flowLayout->addWidget(m_watchWrites);
 }
 
 void MemoryViewerWidget::setCentralAddress(AInt address) {
@@ -74,6 +86,9 @@ void MemoryViewerWidget::updateModel() {
   m_radixSelector->setRadix(m_memoryModel->getRadix());
   connect(m_radixSelector, &RadixSelectorWidget::radixChanged, m_memoryModel,
           &MemoryModel::setRadix);
+  m_memoryModel->setWatchEnabled(m_watchWrites->isChecked());
+  connect(m_watchWrites, &QCheckBox::toggled, m_memoryModel,
+          &MemoryModel::setWatchEnabled);
 
   // Connect scroll events on the view to modify the center address of the model
   connect(m_ui->memoryView, &MemoryView::scrolled, newModel, [=](bool dir) {
@@ -2,6 +2,8 @@
 
 #include <QWidget>
 
+class QCheckBox;
+
 #include "ripes_types.h"
 
 namespace Ripes {
@@ -37,5 +39,6 @@ private:
   RadixSelectorWidget *m_radixSelector = nullptr;
   GoToComboBox *m_goToSection = nullptr;
   GoToComboBox *m_goToRegister = nullptr;
+  QCheckBox *m_watchWrites = nullptr;
 };
 } // namespace Ripes
@@ -2,6 +2,7 @@
 
 #include "processorhandler.h"
 #include "ripessettings.h"
+#include "utilities/cycleprofiler.h"
 
 #include <vector>
 
@@ -53,8 +54,7 @@ void PipelineDiagramModel::processorWasClocked() {
   gatherStageInfo();
 
   const auto cycleCount = ProcessorHandler::getProcessor()->getCycleCount();
-  if (cycleCount >=
-      RipesSettings::value(RIPES_SETTING_PIPEDIAGRAM_MAXCYCLES).toInt()) {
+  if (cycleCount >= m_maxCycles.value()) {
     m_atMaxCycles = true;
   }
 }
@@ -71,6 +71,7 @@ void PipelineDiagramModel::prepareForView() {
 }
 
 void PipelineDiagramModel::gatherStageInfo() {
+  CycleProfiler::Scope scope(CycleProfiler::PipelineDiagram);
   long long cycleCount = ProcessorHandler::getProcessor()->getCycleCount();
   auto stageInfoForCycle = m_cycleStageInfos.find(cycleCount);
   if (stageInfoForCycle != m_cycleStageInfos.end()) {
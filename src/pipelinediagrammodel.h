@@ -1,6 +1,7 @@
 #pragma once
 
 #include "processors/interface/ripesprocessor.h"
+#include "ripessettings.h"
 #include <QAbstractTableModel>
 
 namespace Ripes {
@@ -44,5 +45,6 @@ private:
    * the value has been reached.
    */
   bool m_atMaxCycles = false;
+  CachedSetting<int> m_maxCycles{RIPES_SETTING_PIPEDIAGRAM_MAXCYCLES};
 };
 } // namespace Ripes
@@ -1,6 +1,7 @@
 #include "pipelinediagramwidget.h"
 #include "ui_pipelinediagramwidget.h"
 
+#include <QApplication>
 #include <QClipboard>
 #include <QHeaderView>
 
@@ -12,8 +12,7 @@
 
 #include "syscall/riscv_syscall.h"
 
-#include <QMessageBox>
-#include <QtConcurrent/QtConcurrent>
+#include <QCoreApplication>
 
 namespace Ripes {
 
@@ -53,13 +52,22 @@ ProcessorHandler::ProcessorHandler() {
   m_procStateChangeTimer.setSingleShot(true);
   m_procStateChangeTimer.setInterval(
       1000.0 / RipesSettings::value(RIPES_SETTING_UIUPDATEPS).toInt());
+  m_snapshotTimer.setInterval(m_procStateChangeTimer.interval());
   connect(RipesSettings::getObserver(RIPES_SETTING_UIUPDATEPS),
           &SettingObserver::modified, this, [=] {
             m_procStateChangeTimer.setInterval(
                 1000.0 /
                 RipesSettings::value(RIPES_SETTING_UIUPDATEPS).toInt());
+            m_snapshotTimer.setInterval(m_procStateChangeTimer.interval());
           });
 
+  // Pick up snapshots published by the simulation thread whilst running.
+  connect(&m_snapshotTimer, &QTimer::timeout, this, [=] {
+    if (m_snapshots.update()) {
+      emit snapshotPublished();
+    }
+  });
+
   connect(&m_procStateChangeTimer, &QTimer::timeout, this, [=] {
     emit procStateChangedNonRun();
     m_enqueueStateChangeLock.lock();
@@ -70,13 +78,13 @@ ProcessorHandler::ProcessorHandler() {
     m_enqueueStateChangeLock.unlock();
   });
 
-  // Connect the runwatcher finished signals
-  connect(&m_runWatcher, &QFutureWatcher<void>::finished, this, [=] {
-    emit runFinished();
+  // runFinished is emitted from the simulation thread; the connection is
+  // queued onto the thread of the handler.
+  connect(this, &ProcessorHandler::runFinished, this, [=] {
+    m_snapshotTimer.stop();
     _triggerProcStateChangeTimer();
+    ProcessorStatusManager::clearStatus();
   });
-  connect(&m_runWatcher, &QFutureWatcher<void>::finished, this,
-          [=] { ProcessorStatusManager::clearStatus(); });
 
   // Connect relevant settings changes to VSRTL
   connect(RipesSettings::getObserver(RIPES_SETTING_REWINDSTACKSIZE),
@@ -93,6 +101,14 @@ ProcessorHandler::ProcessorHandler() {
           &SettingObserver::modified, this, &ProcessorHandler::_reset);
 
   m_syscallManager = std::make_unique<RISCVSyscallManager>();
+
+  m_simThread = std::make_unique<SimulationThread>(
+      [=](const SimulationCommand &command) { executeCommand(command); });
+  m_simThread->start();
+  if (auto *app = QCoreApplication::instance()) {
+    connect(app, &QCoreApplication::aboutToQuit, this, [=] { _stopRun(); });
+  }
+
   m_constructing = false;
 }
 
@@ -124,6 +140,12 @@ void ProcessorHandler::_loadProgram(const std::shared_ptr<Program> &p) {
   const auto textStart = textSection->address;
   const auto textEnd = textSection->address + textSection->data.length();
 
+  // Precompute the executable ranges of the program, which the processor
+  // queries on every cycle.
+  AddressRanges executableRanges;
+  executableRanges.add(textStart, textEnd);
+  m_currentProcessor->setExecutableRanges(executableRanges);
+
   // Update breakpoints to stay within the loaded program range
   std::vector<AInt> bpsToRemove;
   for (const auto &bp : m_breakpoints) {
@@ -158,38 +180,123 @@ void ProcessorHandler::_triggerProcStateChangeTimer() {
   m_enqueueStateChangeLock.unlock();
 }
 
-class ProcessorClocker : public QRunnable {
-public:
-  explicit ProcessorClocker(std::mutex &clockLock) : clockLock(clockLock) {}
-  void run() override {
-    std::unique_lock l(clockLock);
-    ProcessorHandler::getProcessorNonConst()->clock();
-    ProcessorHandler::checkProcessorFinished();
-    if (ProcessorHandler::checkBreakpoint()) {
-      ProcessorHandler::stopRun();
-    }
-  }
+void ProcessorHandler::_clock(unsigned long long cycles) {
+  // If the simulation thread is too far behind on previous clock requests, this
+  // request is dropped.
+  SimulationCommand command;
+  command.type = SimulationCommand::Step;
+  command.cycles = cycles;
+  m_simThread->tryPost(command);
+}
 
-private:
-  std::mutex &clockLock;
-};
-
-void ProcessorHandler::_clock() {
-  // Attempt to grab the clock lock - if not possible to acquire, this means
-  // that there already is an ongoing clock event. This _clock event will
-  // therefore be ignored.
-  if (m_clockLock.try_lock()) {
-    QThreadPool::globalInstance()->start(new ProcessorClocker(m_clockLock));
-    m_clockLock.unlock();
-  }
+void ProcessorHandler::_reverse() {
+  SimulationCommand command;
+  command.type = SimulationCommand::Reverse;
+  executeAndWait(command);
+}
+
+void ProcessorHandler::_invoke(const std::function<void()> &function) {
+  SimulationCommand command;
+  command.type = SimulationCommand::Invoke;
+  command.function = function;
+  executeAndWait(command);
 }
 
 void ProcessorHandler::_run() {
   ProcessorStatusManager::setStatusTimed("Running...");
+  m_running = true;
   emit runStarted();
 
-  // Start running through the VSRTL Widget interface
-  m_runWatcher.setFuture(QtConcurrent::run([=] {
+  m_snapshotInterval = std::chrono::milliseconds(m_snapshotTimer.interval());
+  m_snapshotTimer.start();
+
+  SimulationCommand command;
+  command.type = SimulationCommand::Run;
+  m_simThread->post(command);
+}
+
+void ProcessorHandler::recordMemoryWrite() {
+  const MemoryAccess access = m_currentProcessor->dataMemAccess();
+  if (access.type == MemoryAccess::Write) {
+    m_pendingWrites[m_pendingWriteCount++ % m_pendingWrites.size()] = access;
+  }
+}
+
+void ProcessorHandler::publishSnapshot() {
+  auto &snapshot = m_snapshots.back();
+  snapshot.cycleCount = m_currentProcessor->getCycleCount();
+  snapshot.instructionsRetired = m_currentProcessor->getInstructionsRetired();
+
+  const unsigned regCnt = _currentISA()->regCnt();
+  for (const auto &rfid : m_currentProcessor->registerFiles()) {
+    auto &values = snapshot.registers[rfid];
+    values.resize(regCnt);
+    for (unsigned i = 0; i < regCnt; ++i) {
+      values[i] = m_currentProcessor->getRegister(rfid, i);
+    }
+  }
+
+  snapshot.stages.clear();
+  for (const auto &idx : m_currentProcessor->structure().stageIt()) {
+    snapshot.stages[idx] = m_currentProcessor->stageInfo(idx);
+  }
+
+  // Written values are read back from memory, as the writes may have been
+  // overwritten since.
+  snapshot.memoryWrites.clear();
+  const size_t capacity = m_pendingWrites.size();
+  const size_t first =
+      m_pendingWriteCount - std::min(m_pendingWriteCount, capacity);
+  for (size_t i = first; i < m_pendingWriteCount; ++i) {
+    const MemoryAccess &access = m_pendingWrites[i % capacity];
+    snapshot.memoryWrites.push_back(
+        {access.address, access.bytes,
+         m_currentProcessor->getMemory().readMemConst(access.address,
+                                                      access.bytes)});
+  }
+  m_pendingWriteCount = 0;
+
+  m_snapshots.publish();
+}
+
+void ProcessorHandler::executeAndWait(const SimulationCommand &command) {
+  if (m_simThread->isCurrentThread()) {
+    executeCommand(command);
+    return;
+  }
+
+  // A preceding clock command may block waiting for user input through a
+  // system call. This would never complete whilst the caller is waiting, so
+  // the system call is aborted, but only once it is actually blocking.
+  QSemaphore done;
+  SimulationCommand waitedCommand = command;
+  waitedCommand.done = &done;
+  m_simThread->post(waitedCommand);
+  while (!done.tryAcquire(1, 100)) {
+    if (SystemIO::isWaitingForInput())
+      SystemIO::abortSyscall();
+  }
+}
+
+void ProcessorHandler::executeCommand(const SimulationCommand &command) {
+  switch (command.type) {
+  case SimulationCommand::Step: {
+    for (unsigned long long i = 0; i < command.cycles; ++i) {
+      m_currentProcessor->clock();
+      if (m_currentProcessor->finished()) {
+        emit exit();
+        break;
+      }
+      if (_checkBreakpoint()) {
+        emit stopping();
+        break;
+      }
+      if (m_stopRunningFlag)
+        break;
+    }
+    break;
+  }
+  case SimulationCommand::Run: {
     auto *vsrtl_proc =
         dynamic_cast<vsrtl::SimDesign *>(m_currentProcessor.get());
 
@@ -197,16 +304,56 @@ void ProcessorHandler::_run() {
       vsrtl_proc->setEnableSignals(false);
     }
 
+    // Snapshots are published at the UI update rate. Reading the time is
+    // comparatively expensive, so it is only checked every few cycles.
+    constexpr unsigned long long snapshotCheckCycles = 256;
+    using Clock = std::chrono::steady_clock;
+    auto nextSnapshot = Clock::now() + m_snapshotInterval;
+    unsigned long long cycles = 0;
+    m_pendingWriteCount = 0;
+
     while (!(_checkBreakpoint() || m_currentProcessor->finished() ||
              m_stopRunningFlag)) {
       m_currentProcessor->clock();
+      recordMemoryWrite();
+      if (++cycles % snapshotCheckCycles == 0 && Clock::now() >= nextSnapshot) {
+        publishSnapshot();
+        nextSnapshot = Clock::now() + m_snapshotInterval;
+      }
     }
 
     if (vsrtl_proc) {
       vsrtl_proc->setEnableSignals(true);
     }
+    m_running = false;
     emit runFinished();
-  }));
+    break;
+  }
+  case SimulationCommand::Reverse:
+    m_currentProcessor->reverseProcessor();
+    break;
+  case SimulationCommand::Reset:
+    m_currentProcessor->resetProcessor();
+    // Rewrite register initializations
+    for (const auto &kv : m_currentRegInits) {
+      m_currentProcessor->setRegister(RegisterFileType::GPR, kv.first,
+                                      kv.second);
+      m_currentProcessor->registerJournal().record(RegisterFileType::GPR,
+                                                   kv.first, kv.second);
+    }
+    break;
+  case SimulationCommand::SetRegister:
+    m_currentProcessor->setRegister(command.rfid, command.idx, command.value);
+    m_currentProcessor->registerJournal().record(command.rfid, command.idx,
+                                                 command.value);
+    break;
+  case SimulationCommand::Invoke:
+    command.function();
+    break;
+  case SimulationCommand::Sync:
+  case SimulationCommand::Quit:
+    break;
+  }
 }
 
 void ProcessorHandler::_setBreakpoint(const AInt address, bool enabled) {
@@ -217,17 +364,6 @@ void ProcessorHandler::_setBreakpoint(const AInt address, bool enabled) {
   }
 }
 
-void ProcessorHandler::_loadProcessorToWidget(vsrtl::VSRTLWidget *widget,
-                                              bool doPlaceAndRoute) {
-  m_vsrtlWidget = widget;
-
-  // Currently, only VSRTL processors can be visualized
-  if (auto *vsrtlProcessor =
-          dynamic_cast<RipesVSRTLProcessor *>(m_currentProcessor.get())) {
-    widget->setDesign(vsrtlProcessor, doPlaceAndRoute);
-  }
-}
-
 bool ProcessorHandler::_hasBreakpoint(const AInt address) const {
   return m_breakpoints.count(address);
 }
@@ -249,16 +385,41 @@ void ProcessorHandler::_toggleBreakpoint(const AInt address) {
 
 void ProcessorHandler::_clearBreakpoints() { m_breakpoints.clear(); }
 
-void ProcessorHandler::createAssemblerForCurrentISA() {
+std::shared_ptr<Assembler::AssemblerBase>
+ProcessorHandler::_createAssembler() const {
   const auto &ISA = _currentISA();
 
   if (auto *rv32isa = dynamic_cast<const ISAInfo<ISA::RV32I> *>(ISA)) {
-    m_currentAssembler = std::make_shared<Assembler::RV32I_Assembler>(rv32isa);
+    return std::make_shared<Assembler::RV32I_Assembler>(rv32isa);
   } else if (auto *rv64isa = dynamic_cast<const ISAInfo<ISA::RV64I> *>(ISA)) {
-    m_currentAssembler = std::make_shared<Assembler::RV64I_Assembler>(rv64isa);
-  } else {
-    Q_UNREACHABLE();
+    return std::make_shared<Assembler::RV64I_Assembler>(rv64isa);
+  }
+  Q_UNREACHABLE();
+}
+
+std::shared_ptr<Assembler::AssemblerBase>
+ProcessorHandler::_createJobAssembler() const {
+  const auto &ISA = _currentISA();
+
+  // The ISA info copy is kept alive for as long as the assembler.
+  if (auto *rv32isa = dynamic_cast<const ISAInfo<ISA::RV32I> *>(ISA)) {
+    auto isa =
+        std::make_shared<ISAInfo<ISA::RV32I>>(rv32isa->enabledExtensions());
+    return std::shared_ptr<Assembler::AssemblerBase>(
+        new Assembler::RV32I_Assembler(isa.get(), true),
+        [isa](Assembler::AssemblerBase *assembler) { delete assembler; });
+  } else if (auto *rv64isa = dynamic_cast<const ISAInfo<ISA::RV64I> *>(ISA)) {
+    auto isa =
+        std::make_shared<ISAInfo<ISA::RV64I>>(rv64isa->enabledExtensions());
+    return std::shared_ptr<Assembler::AssemblerBase>(
+        new Assembler::RV64I_Assembler(isa.get(), true),
+        [isa](Assembler::AssemblerBase *assembler) { delete assembler; });
   }
+  Q_UNREACHABLE();
+}
+
+void ProcessorHandler::createAssemblerForCurrentISA() {
+  m_currentAssembler = _createAssembler();
 }
 
 void ProcessorHandler::_reset() {
@@ -266,14 +427,14 @@ void ProcessorHandler::_reset() {
     return;
   }
 
-  SystemIO::abortSyscall();
-  getProcessorNonConst()->resetProcessor();
-
-  // Rewrite register initializations
-  for (const auto &kv : m_currentRegInits) {
-    _setRegisterValue(RegisterFileType::GPR, kv.first, kv.second);
+  if (_isRunning()) {
+    _stopRun();
   }
 
+  SimulationCommand command;
+  command.type = SimulationCommand::Reset;
+  executeAndWait(command);
+
   // Reset IO devices.
   IOManager::get().reset();
 
@@ -286,6 +447,14 @@ void ProcessorHandler::_reset() {
 void ProcessorHandler::_selectProcessor(const ProcessorID &id,
                                         const QStringList &extensions,
                                         const RegisterInitialization &setup) {
+  // The processor must not be replaced whilst being clocked.
+  if (m_simThread) {
+    _stopRun();
+  }
+  if (m_currentProcessor) {
+    emit processorAboutToChange();
+  }
+
   m_currentID = id;
   m_currentRegInits = setup;
   RipesSettings::setValue(RIPES_SETTING_PROCESSOR_ID, id);
@@ -301,10 +470,6 @@ void ProcessorHandler::_selectProcessor(const ProcessorID &id,
   // Processor initializations
   m_currentProcessor =
       ProcessorRegistry::constructProcessor(m_currentID, extensions);
-  m_currentProcessor->isExecutableAddress = [=](AInt address) {
-    return _isExecutableAddress(address);
-  };
-
   // Syscall handling initialization
   m_currentProcessor->trapHandler = [=] { syscallTrap(); };
 
@@ -318,18 +483,17 @@ void ProcessorHandler::_selectProcessor(const ProcessorID &id,
     emit programChanged();
   }
 
-  // Connect wrappers for making processor signal emissions thread safe.
-  m_signalWrappers.clear();
-  m_signalWrappers.push_back(std::unique_ptr<vsrtl::GallantSignalWrapperBase>(
-      new vsrtl::GallantSignalWrapper(
-          this,
-          [=] {
-            if (!_isRunning()) {
-              emit processorClockedNonRun();
-              _triggerProcStateChangeTimer();
-            }
-          },
-          m_currentProcessor->processorWasClocked)));
+  // Connect relays for making processor signal emissions thread safe.
+  m_signalRelays.clear();
+  m_signalRelays.push_back(std::make_unique<GallantSignalRelay>(
+      this,
+      [=] {
+        if (!_isRunning()) {
+          emit processorClockedNonRun();
+          _triggerProcStateChangeTimer();
+        }
+      },
+      m_currentProcessor->processorWasClocked));
   // Connect ProcessorHandler::processorClocked since things connected to this
   // signal _must_ be updated _for each_ processor cycle, in order. Which would
   // not be possible through processorClockedNonRun, which might be cross-thread
@@ -337,23 +501,21 @@ void ProcessorHandler::_selectProcessor(const ProcessorID &id,
   m_currentProcessor->processorWasClocked.Connect(
       this, &ProcessorHandler::processorClocked);
 
-  m_signalWrappers.push_back(std::unique_ptr<vsrtl::GallantSignalWrapperBase>(
-      new vsrtl::GallantSignalWrapper(
-          this,
-          [=] {
-            emit processorReset();
-            _triggerProcStateChangeTimer();
-          },
-          m_currentProcessor->processorWasReset)));
-
-  m_signalWrappers.push_back(std::unique_ptr<vsrtl::GallantSignalWrapperBase>(
-      new vsrtl::GallantSignalWrapper(
-          this,
-          [=] {
-            emit processorReversed();
-            _triggerProcStateChangeTimer();
-          },
-          m_currentProcessor->processorWasReversed)));
+  m_signalRelays.push_back(std::make_unique<GallantSignalRelay>(
+      this,
+      [=] {
+        emit processorReset();
+        _triggerProcStateChangeTimer();
+      },
+      m_currentProcessor->processorWasReset));
+
+  m_signalRelays.push_back(std::make_unique<GallantSignalRelay>(
+      this,
+      [=] {
+        emit processorReversed();
+        _triggerProcStateChangeTimer();
+      },
+      m_currentProcessor->processorWasReversed));
 
   emit processorChanged();
 
@@ -394,21 +556,18 @@ QString ProcessorHandler::_disassembleInstr(const AInt addr) const {
 }
 
 void ProcessorHandler::syscallTrap() {
-  auto futureWatcher = QFutureWatcher<bool>();
-  futureWatcher.setFuture(QtConcurrent::run([=] {
-    const unsigned int function = m_currentProcessor->getRegister(
-        RegisterFileType::GPR, _currentISA()->syscallReg());
-    return m_syscallManager->execute(function);
-  }));
-
-  futureWatcher.waitForFinished();
-  if (!futureWatcher.result()) {
+  // Traps are raised from within a clock cycle, which does not proceed until
+  // the system call has been handled. The system call is therefore executed
+  // directly on the clocking (simulation) thread.
+  const unsigned int function = m_currentProcessor->getRegister(
+      RegisterFileType::GPR, _currentISA()->syscallReg());
+  if (!m_syscallManager->execute(function)) {
     // Syscall handling failed, stop running processor
     setStopRunFlag();
   }
 }
 
-bool ProcessorHandler::_isRunning() { return !m_runWatcher.isFinished(); }
+bool ProcessorHandler::_isRunning() { return m_running; }
 
 void ProcessorHandler::_checkProcessorFinished() {
   if (m_currentProcessor->finished())
@@ -417,34 +576,36 @@ void ProcessorHandler::_checkProcessorFinished() {
 
 void ProcessorHandler::setStopRunFlag() {
   emit stopping();
-  if (m_runWatcher.isRunning()) {
+  if (m_running) {
     m_stopRunningFlag = true;
-    // We might be currently trapping for user I/O. Signal to abort the trap, in
-    // this avoiding a deadlock.
-    SystemIO::abortSyscall();
   }
+  // We might be currently trapping for user I/O. Signal to abort the trap, in
+  // this avoiding a deadlock.
+  SystemIO::abortSyscall();
 }
 
 void ProcessorHandler::_stopRun() {
   setStopRunFlag();
-  m_runWatcher.waitForFinished();
+  if (!m_simThread->isCurrentThread()) {
+    // Also interrupt any multi-cycle clock request which is in progress.
+    m_stopRunningFlag = true;
+    m_simThread->waitForIdle();
+  }
   m_stopRunningFlag = false;
 }
 
 bool ProcessorHandler::_isExecutableAddress(AInt address) const {
-  if (m_program) {
-    if (auto *textSection = m_program->getSection(TEXT_SECTION_NAME)) {
-      const auto textStart = textSection->address;
-      const auto textEnd = textSection->address + textSection->data.length();
-      return textStart <= address && address < textEnd;
-    }
-  }
-  return false;
+  return m_currentProcessor->isExecutableAddress(address);
 }
 
 void ProcessorHandler::_setRegisterValue(RegisterFileType rfid,
                                          const unsigned idx, VInt value) {
-  m_currentProcessor->setRegister(rfid, idx, value);
+  SimulationCommand command;
+  command.type = SimulationCommand::SetRegister;
+  command.rfid = rfid;
+  command.idx = idx;
+  command.value = value;
+  executeAndWait(command);
 }
 
 VInt ProcessorHandler::_getRegisterValue(RegisterFileType rfid,
@@ -1,18 +1,23 @@
 #pragma once
 
-#include <QFuture>
-#include <QFutureWatcher>
 #include <QObject>
+#include <QTimer>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <set>
 
-#include "VSRTL/graphics/gallantsignalwrapper.h"
 #include "assembler/assembler.h"
 #include "assembler/program.h"
 #include "processorregistry.h"
 #include "processors/interface/ripesprocessor.h"
+#include "processorsnapshot.h"
+#include "simulationthread.h"
 #include "syscall/ripes_syscall.h"
-
-#include "VSRTL/graphics/vsrtl_widget.h"
+#include "utilities/gallantsignalrelay.h"
+#include "utilities/triplebuffer.h"
 
 namespace Ripes {
 
@@ -21,6 +26,10 @@ namespace Ripes {
  * Manages construction and destruction of a VSRTL processor design, when
  * selecting between processors. Manages all interaction and control of the
  * current processor.
+ *
+ * Clocking, running, reversing and resetting the processor, as well as writing
+ * its registers, is performed on a dedicated simulation thread, which executes
+ * these as commands posted by the GUI thread.
  */
 class ProcessorHandler : public QObject {
   Q_OBJECT
@@ -45,6 +54,16 @@ public:
     return get()->_getAssembler();
   }
 
+  /// Returns a new assembler for the current ISA. Assemblers are not thread
+  /// safe; jobs assembling outside of the GUI thread must use their own
+  /// instance rather than the shared one returned by getAssembler(). The
+  /// returned assembler owns a copy of the ISA info, and takes a snapshot of
+  /// the segment pointer settings, so it remains valid when the processor or
+  /// the settings change.
+  static std::shared_ptr<Assembler::AssemblerBase> createJobAssembler() {
+    return get()->_createJobAssembler();
+  }
+
   /// Returns the ID of the currently instantiated processor.
   static const ProcessorID &getID() { return get()->_getID(); }
 
@@ -70,16 +89,6 @@ public:
   /// be used to enable VSRTL-specific functionality, such as processor drawing.
   static bool isVSRTLProcessor();
 
-  /**
-   * @brief loadProcessorToWidget
-   * Loads the current processor to the @param VSRTLWidget. Required given that
-   * ProcessorHandler::getProcessor returns a const ptr.
-   */
-  static void loadProcessorToWidget(vsrtl::VSRTLWidget *widget,
-                                    bool doPlaceAndRoute = false) {
-    get()->_loadProcessorToWidget(widget, doPlaceAndRoute);
-  }
-
   /**
    * @brief selectProcessor
    * Constructs the processor identified by @param id, and performs all
@@ -185,6 +194,24 @@ public:
   /// Returns true if the simulator is currently in "run" mode.
   static bool isRunning() { return get()->_isRunning(); }
 
+  /**
+   * @brief invoke
+   * Executes @p function on the simulation thread, in order with any other
+   * simulation commands, and blocks until it has been executed. Allows for
+   * driving the current processor in ways not covered by the other commands
+   * (e.g. co-simulation).
+   */
+  static void invoke(const std::function<void()> &function) {
+    get()->_invoke(function);
+  }
+
+  /// Returns the most recent snapshot of the processor state which was
+  /// published whilst running. Must only be accessed from the GUI thread,
+  /// typically in response to snapshotPublished.
+  static const ProcessorSnapshot &getSnapshot() {
+    return get()->m_snapshots.front();
+  }
+
   static void setMemoryFocusAddress(AInt address) {
     emit get()->memoryFocusAddressChanged(address);
   }
@@ -198,7 +225,19 @@ public:
    */
   static void run() { get()->_run(); }
 
-  static void clock() { get()->_clock(); }
+  /**
+   * @brief clock
+   * Asynchronously clocks the current processor for up to @p cycles cycles,
+   * stopping early if the processor finishes or hits a breakpoint. The request
+   * is dropped if the simulation thread is too far behind on previous requests.
+   */
+  static void clock(unsigned long long cycles = 1) { get()->_clock(cycles); }
+
+  /**
+   * @brief reverse
+   * Undoes the latest clock cycle of the current processor.
+   */
+  static void reverse() { get()->_reverse(); }
 
   /**
    * @brief stopRun
@@ -215,6 +254,13 @@ signals:
    */
   void processorChanged();
 
+  /**
+   * @brief processorAboutToChange
+   * Emitted before the current processor is replaced. Receivers must stop
+   * using the current processor and its ISA before returning.
+   */
+  void processorAboutToChange();
+
   /**
    * @brief exit
    * end the current simulation, disallowing further clocking of the processor
@@ -236,6 +282,20 @@ signals:
   void runStarted();
   void runFinished();
 
+  /**
+   * @brief snapshotPublished
+   * Emitted, at most at the UI update rate, whilst running when a new snapshot
+   * of the processor state is available through getSnapshot().
+   */
+  void snapshotPublished();
+
+  /**
+   * @brief simulationError
+   * Emitted when the simulation encounters an error which should be reported
+   * to the user, i.e. an unknown system call.
+   */
+  void simulationError(const QString &message);
+
   /**
    * @brief Various signals wrapping around the direct VSRTL model emission
    * signals. This is done to avoid relying component to having to reconnect to
@@ -260,9 +320,9 @@ signals:
 private slots:
   /**
    * @brief syscallTrap
-   * Connects to the processors system call request interface. Will concurrently
-   * run the systemcall manager to handle the requested functionality, and
-   * return once the system call was handled.
+   * Connects to the processors system call request interface. Runs the system
+   * call manager to handle the requested functionality, and returns once the
+   * system call was handled.
    */
   void syscallTrap();
 
@@ -284,8 +344,6 @@ private:
     return m_currentProcessor->implementsISA();
   }
   const SyscallManager &_getSyscallManager() const { return *m_syscallManager; }
-  void _loadProcessorToWidget(vsrtl::VSRTLWidget *widget,
-                              bool doPlaceAndRoute = false);
   void _selectProcessor(
       const ProcessorID &id, const QStringList &extensions = {},
       const RegisterInitialization &setup = RegisterInitialization());
@@ -306,13 +364,30 @@ private:
   void _checkProcessorFinished();
   bool _isRunning();
   void _run();
-  void _clock();
+  void _clock(unsigned long long cycles);
+  void _reverse();
+  void _invoke(const std::function<void()> &function);
   void _reset();
   void _stopRun();
   void _triggerProcStateChangeTimer();
 
+  /// Records the data memory write, if any, of the latest clock cycle for the
+  /// next snapshot.
+  void recordMemoryWrite();
+  /// Publishes a snapshot of the current processor state.
+  void publishSnapshot();
+
+  std::shared_ptr<Assembler::AssemblerBase> _createAssembler() const;
+  std::shared_ptr<Assembler::AssemblerBase> _createJobAssembler() const;
   void createAssemblerForCurrentISA();
   void setStopRunFlag();
+
+  /// Executes @p command on the simulation thread.
+  void executeCommand(const SimulationCommand &command);
+  /// Posts @p command to the simulation thread and waits for it to be
+  /// executed. Any system call which a preceding command is blocked upon is
+  /// aborted.
+  void executeAndWait(const SimulationCommand &command);
   ProcessorHandler();
 
   // Flag used during construction to avoid calling ProcessorHandler::get() to
@@ -324,18 +399,31 @@ private:
   std::unique_ptr<SyscallManager> m_syscallManager;
   std::shared_ptr<Assembler::AssemblerBase> m_currentAssembler;
 
-  /**
-   * @brief m_vsrtlWidget
-   * The VSRTL Widget associated which the processor models will be loaded to
-   */
-  vsrtl::VSRTLWidget *m_vsrtlWidget = nullptr;
-
   std::set<AInt> m_breakpoints;
   std::shared_ptr<Program> m_program;
 
-  QFutureWatcher<void> m_runWatcher;
-  bool m_stopRunningFlag = false;
-  std::mutex m_clockLock;
+  /**
+   * @brief m_simThread
+   * The thread on which all clocking and mutation of the current processor
+   * takes place.
+   */
+  std::unique_ptr<SimulationThread> m_simThread;
+  std::atomic<bool> m_running{false};
+  std::atomic<bool> m_stopRunningFlag{false};
+
+  /**
+   * @brief m_snapshots
+   * Snapshots of the processor state are published by the simulation thread
+   * whilst running, every m_snapshotInterval. The GUI thread picks up the
+   * latest snapshot every m_snapshotTimer timeout.
+   */
+  TripleBuffer<ProcessorSnapshot> m_snapshots;
+  std::chrono::milliseconds m_snapshotInterval{0};
+  QTimer m_snapshotTimer;
+  // Memory writes since the last snapshot, as a ring buffer of the most recent
+  // writes.
+  std::array<MemoryAccess, 64> m_pendingWrites;
+  size_t m_pendingWriteCount = 0;
 
   /**
    * @brief To avoid excessive UI updates due to things relying on
@@ -353,7 +441,6 @@ private:
    * the execution environment.
    */
   QSemaphore m_sem;
-  std::vector<std::unique_ptr<vsrtl::GallantSignalWrapperBase>>
-      m_signalWrappers;
+  std::vector<std::unique_ptr<GallantSignalRelay>> m_signalRelays;
 };
 } // namespace Ripes
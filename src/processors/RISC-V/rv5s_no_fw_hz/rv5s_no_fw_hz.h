@@ -410,9 +410,23 @@ public:
     if (memwb_reg->valid_out.uValue() != 0 &&
         isExecutableAddress(memwb_reg->pc_out.uValue())) {
       m_instructionsRetired++;
+      if (retireHandler) {
+        auto retired = retiredInstruction(memwb_reg->pc_out.uValue());
+        setRegisterWrite(retired, registerFile->wr_en.uValue(),
+                         registerFile->wr_addr.uValue(),
+                         registerFile->data_in.uValue());
+        attachMemStageAccess(retired);
+        retireHandler(retired);
+      }
+    }
+    if (retireHandler) {
+      recordMemStageAccess(exmem_reg->pc_out.uValue(), data_mem,
+                           data_mem->data_in.uValue());
     }
 
-    Design::clock();
+    journalRegisterWrite(registerFile);
+
+    clockDesign();
   }
 
   void reverse() override {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include "VSRTL/core/vsrtl_adder.h"
 #include "VSRTL/core/vsrtl_constant.h"
 #include "VSRTL/core/vsrtl_design.h"
@@ -858,8 +860,48 @@ public:
     // An instruction has been retired if the instruction in the WB stage is
     // valid and the PC is within the executable range of the program
     m_instructionsRetired += instructionsRetired();
+    if (retireHandler) {
+      reportRetired();
+      // Only the data lane accesses memory.
+      recordMemStageAccess(exmem_reg->pc4_out.uValue(), data_mem,
+                           data_mem->data_in.uValue());
+    }
+
+    journalRegisterWrite(registerFile->rf_1);
+    journalRegisterWrite(registerFile->rf_2);
+
+    clockDesign();
+  }
+
+  void reportRetired() {
+    if (memwb_reg->valid_out.uValue() == 0)
+      return;
+
+    std::optional<RetiredInstruction> exec, data;
+    if (isExecutableAddress(memwb_reg->pc_out.uValue()) &&
+        memwb_reg->exec_valid_out.uValue()) {
+      exec = retiredInstruction(memwb_reg->pc_out.uValue());
+      setRegisterWrite(*exec, registerFile->wr_1_en.uValue(),
+                       registerFile->wr_1_addr.uValue(),
+                       registerFile->data_1_in.uValue());
+    }
+    if (isExecutableAddress(memwb_reg->pc4_out.uValue()) &&
+        memwb_reg->data_valid_out.uValue()) {
+      data = retiredInstruction(memwb_reg->pc4_out.uValue());
+      setRegisterWrite(*data, registerFile->wr_2_en.uValue(),
+                       registerFile->wr_2_addr.uValue(),
+                       registerFile->data_2_in.uValue());
+      attachMemStageAccess(*data);
+    }
 
-    Design::clock();
+    // Instructions issued together are consecutive; report them in program
+    // order.
+    if (exec && data && data->pc < exec->pc)
+      std::swap(exec, data);
+    if (exec)
+      retireHandler(*exec);
+    if (data)
+      retireHandler(*data);
   }
 
   void reverse() override {
@@ -211,12 +211,21 @@ public:
   void clockProcessor() override {
     // Single cycle processor; 1 instruction retired per cycle!
     m_instructionsRetired++;
+    if (retireHandler) {
+      auto retired = retiredInstruction(pc_reg->out.uValue());
+      setRegisterWrite(retired, registerFile->wr_en.uValue(),
+                       registerFile->wr_addr.uValue(),
+                       registerFile->data_in.uValue());
+      setMemoryAccess(retired, dataMemAccess(), data_mem->data_in.uValue());
+      retireHandler(retired);
+    }
+    journalRegisterWrite(registerFile);
 
     // m_finishInNextCycle may be set during Design::clock(). Store the value
     // before clocking the processor, and emit finished if this was the final
     // clock cycle.
     const bool finishInThisCycle = m_finishInNextCycle;
-    Design::clock();
+    clockDesign();
     if (finishInThisCycle) {
       m_finished = true;
     }
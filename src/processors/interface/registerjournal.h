@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+#include "../../isa/isainfo.h"
+#include "../../ripes_types.h"
+
+namespace Ripes {
+
+/**
+ * @brief The RegisterJournal class
+ * A bounded journal of the register writes performed by a processor. Processor
+ * models record the register writes which they perform in each clock cycle.
+ * Consumers keep track of the journal position up to which they have consumed
+ * the journal, and use forEachSince() to visit only the writes performed since,
+ * rather than re-reading (and diffing) all registers.
+ *
+ * Writes which are not recorded as such (i.e. reversing or resetting the
+ * processor) invalidate the journal, in which case consumers must re-read the
+ * register files.
+ */
+class RegisterJournal {
+public:
+  struct Write {
+    RegisterFileType rfid = RegisterFileType::GPR;
+    unsigned index = 0;
+    VInt value = 0;
+  };
+
+  static constexpr size_t s_capacity = 256;
+
+  /// Records a write of @p value to register @p index of register file
+  /// @p rfid.
+  void record(RegisterFileType rfid, unsigned index, VInt value) {
+    const uint64_t position = m_position.load(std::memory_order_relaxed);
+    // Announce the write before overwriting the oldest slot, allowing for
+    // consumers to detect whether a slot changed whilst being read.
+    m_recording.store(position + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_writes[position % s_capacity] = {rfid, index, value};
+    // Publish the write only once its slot has been written.
+    m_position.store(position + 1, std::memory_order_release);
+    m_writesRecorded.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Invalidates all journal entries recorded so far.
+  void invalidate() {
+    const uint64_t position = m_position.load(std::memory_order_relaxed) + 1;
+    m_validFrom.store(position, std::memory_order_relaxed);
+    m_position.store(position, std::memory_order_release);
+  }
+
+  /// Invalidates the journal and clears the count of recorded writes.
+  void clear() {
+    invalidate();
+    m_writesRecorded.store(0, std::memory_order_relaxed);
+  }
+
+  /// Current position of the journal. A consumer which has consumed the
+  /// journal up to this position is up to date.
+  uint64_t position() const {
+    return m_position.load(std::memory_order_acquire);
+  }
+
+  /// Total number of writes recorded since the journal was cleared.
+  uint64_t writesRecorded() const {
+    return m_writesRecorded.load(std::memory_order_relaxed);
+  }
+
+  /// Calls @p f for each write recorded since journal position @p from, in the
+  /// order in which they were recorded, and returns the journal position up to
+  /// which the journal was consumed. Returns std::nullopt, without calling
+  /// @p f, if these writes are no longer available (the journal was invalidated
+  /// or overflowed since @p from); the consumer must then re-read the register
+  /// files. The journal may be recorded to by a single thread whilst being
+  /// consumed by another; writes recorded after the returned position are left
+  /// for the next call.
+  template <typename F>
+  std::optional<uint64_t> forEachSince(uint64_t from, const F &f) const {
+    const uint64_t end = m_position.load(std::memory_order_acquire);
+    if (from < m_validFrom.load(std::memory_order_relaxed) || from > end ||
+        end - from > s_capacity)
+      return std::nullopt;
+
+    // Copy the writes before visiting them, and discard the copy if any of
+    // the slots was overwritten by a write recorded in the meantime.
+    std::array<Write, s_capacity> writes;
+    for (uint64_t pos = from; pos < end; ++pos)
+      writes[pos - from] = m_writes[pos % s_capacity];
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_recording.load(std::memory_order_relaxed) > from + s_capacity)
+      return std::nullopt;
+
+    for (uint64_t pos = from; pos < end; ++pos)
+      f(writes[pos - from]);
+    return end;
+  }
+
+private:
+  std::array<Write, s_capacity> m_writes;
+  std::atomic<uint64_t> m_position{0};
+  /// Position of the write currently being recorded, plus one.
+  std::atomic<uint64_t> m_recording{0};
+  std::atomic<uint64_t> m_validFrom{0};
+  std::atomic<uint64_t> m_writesRecorded{0};
+};
+
+} // namespace Ripes
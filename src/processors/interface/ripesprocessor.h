@@ -4,10 +4,14 @@
 
 #include "Signals/Signal.h"
 #include "VSRTL/core/vsrtl_design.h"
+#include <algorithm>
 #include <map>
+#include <vector>
 
 #include "../../isa/isainfo.h"
 #include "../../ripes_types.h"
+#include "../../utilities/cycleprofiler.h"
+#include "registerjournal.h"
 
 namespace Ripes {
 
@@ -39,6 +43,25 @@ struct MemoryAccess {
   unsigned bytes;
 };
 
+/// Architectural effects of a retired instruction, as reported through
+/// RipesProcessor::retireHandler.
+struct RetiredInstruction {
+  /// Cycle in which the instruction retired.
+  long long cycle = 0;
+  AInt pc = 0;
+  /// Instruction word. 2 bytes for compressed instructions, else 4 bytes.
+  VInt instr = 0;
+  unsigned instrBytes = 4;
+  /// Register write of the instruction, if any (writes to x0 are omitted).
+  bool regWrite = false;
+  unsigned rd = 0;
+  VInt rdValue = 0;
+  /// Data memory access of the instruction, if any. For writes, memValue is
+  /// the value written.
+  MemoryAccess memAccess;
+  VInt memValue = 0;
+};
+
 /// A StageIndex denotes a unique stage within a processor.
 struct StageIndex : public std::pair<unsigned, unsigned> {
   using std::pair<unsigned, unsigned>::pair;
@@ -109,6 +132,42 @@ struct ProcessorStructure : public std::map<unsigned, unsigned> {
   }
 };
 
+/**
+ * @brief The AddressRanges class
+ * A flat, sorted set of half-open [start, end[ address ranges. Lookups are
+ * inlinable and allocation free, making the set suitable for queries on the
+ * per-cycle path of a processor model. Ranges are expected to be
+ * non-overlapping.
+ */
+class AddressRanges {
+public:
+  void clear() { m_ranges.clear(); }
+  bool empty() const { return m_ranges.empty(); }
+
+  void add(AInt start, AInt end) {
+    if (start >= end)
+      return;
+    const auto range = std::make_pair(start, end);
+    m_ranges.insert(
+        std::upper_bound(m_ranges.begin(), m_ranges.end(), range), range);
+  }
+
+  bool contains(AInt address) const {
+    // Programs typically contain a single or a few executable ranges; a linear
+    // scan over the sorted ranges is faster than a binary search here.
+    for (const auto &range : m_ranges) {
+      if (address < range.first)
+        return false;
+      if (address < range.second)
+        return true;
+    }
+    return false;
+  }
+
+private:
+  std::vector<std::pair<AInt, AInt>> m_ranges;
+};
+
 /**
  * @brief The RipesProcessor class
  * Interface for all Ripes processors. This interface is intended to be
@@ -267,6 +326,7 @@ public:
    * Clocks the processor.
    */
   void clock() {
+    CycleProfiler::Scope scope(CycleProfiler::Cycle);
     if (!finished())
       clockProcessor();
   }
@@ -316,10 +376,23 @@ public:
 
   /**
    * @brief isExecutableAddress
-   * Callback that the processor can use to query the Ripes environment. Returns
-   * whether the @p address is an address which is valid to be executed.
+   * Returns whether the @p address is an address which is valid to be executed.
+   * Queried by processor models for every stage in every cycle, and thus
+   * resolved against the executable ranges which Ripes sets upon loading a
+   * program.
    */
-  std::function<bool(AInt)> isExecutableAddress;
+  bool isExecutableAddress(AInt address) const {
+    return m_executableRanges.contains(address);
+  }
+
+  /**
+   * @brief setExecutableRanges
+   * Sets the address ranges which are valid to be executed. Must not be called
+   * while the processor is being clocked.
+   */
+  void setExecutableRanges(const AddressRanges &ranges) {
+    m_executableRanges = ranges;
+  }
 
   /**
    * @brief trapHandler
@@ -330,6 +403,25 @@ public:
    */
   std::function<void(void)> trapHandler;
 
+  /**
+   * @brief retireHandler
+   * Optional callback invoked by the processor model for every instruction it
+   * retires, in program order, from within clock(). Retirement is not
+   * reported while reversing. When unset, processor models perform no
+   * retirement bookkeeping beyond counting retired instructions.
+   */
+  std::function<void(const RetiredInstruction &)> retireHandler;
+
+  /**
+   * @brief registerJournal
+   * Journal of the register writes performed by the processor. Processor models
+   * record the register writes performed in each clock cycle, and invalidate
+   * the journal whenever registers are modified otherwise (i.e. reversing or
+   * resetting).
+   */
+  RegisterJournal &registerJournal() { return m_registerJournal; }
+  const RegisterJournal &registerJournal() const { return m_registerJournal; }
+
   /** ======================== FEATURE: Reversible ======================== */
   // Enabled by setting m_features.isReversible = true
 
@@ -357,6 +449,10 @@ protected:
   // m_features should be adjusted accordingly during processor construction
   unsigned m_features;
   bool m_emitsSignals = true;
+  RegisterJournal m_registerJournal;
+
+private:
+  AddressRanges m_executableRanges;
 };
 
 } // namespace Ripes
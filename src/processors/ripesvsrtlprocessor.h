@@ -7,6 +7,7 @@
 #include "RISC-V/riscv.h"
 #include "VSRTL/core/vsrtl_design.h"
 #include "interface/ripesprocessor.h"
+#include "../utilities/cycleprofiler.h"
 
 namespace Ripes {
 
@@ -18,7 +19,8 @@ public:
                   Features::hasICacheInterface};
 
     // Shim signal emissions from VSRTL to RipesProcessor
-    designWasClocked.Connect(&processorWasClocked, &Gallant::Signal0<>::Emit);
+    designWasClocked.Connect(this,
+                             &RipesVSRTLProcessor::emitProcessorWasClocked);
     designWasReversed.Connect(&processorWasReversed, &Gallant::Signal0<>::Emit);
     designWasReset.Connect(&processorWasReset, &Gallant::Signal0<>::Emit);
   }
@@ -26,9 +28,13 @@ public:
   virtual void resetProcessor() override {
     m_instructionsRetired = 0;
     reset();
+    m_registerJournal.clear();
   }
 
-  virtual void reverseProcessor() override { reverse(); }
+  virtual void reverseProcessor() override {
+    reverse();
+    m_registerJournal.invalidate();
+  }
 
   long long getInstructionsRetired() const override {
     return m_instructionsRetired;
@@ -46,6 +52,88 @@ public:
   }
 
 protected:
+  /**
+   * @brief clockDesign
+   * Clocks the VSRTL design. Processor models should clock their design
+   * through this function, to have it accounted for by the CycleProfiler.
+   */
+  void clockDesign() {
+    CycleProfiler::Scope scope(CycleProfiler::DesignClock);
+    Design::clock();
+  }
+
+  /**
+   * @brief retiredInstruction
+   * Returns a retirement record of the instruction at @p pc in the current
+   * cycle. The instruction word is read from memory; register and memory
+   * effects are filled in by the processor model.
+   */
+  RetiredInstruction retiredInstruction(AInt pc) {
+    RetiredInstruction retired;
+    retired.cycle = m_cycleCount;
+    retired.pc = pc;
+    const VInt word = getMemory().readMem(pc, 4);
+    // Compressed instructions do not have their two least significant bits
+    // set.
+    retired.instrBytes = (word & 0b11) == 0b11 ? 4 : 2;
+    retired.instr = word & (retired.instrBytes == 4 ? 0xFFFFFFFF : 0xFFFF);
+    return retired;
+  }
+
+  /**
+   * @brief journalRegisterWrite
+   * Records the write which register file @p rf performs upon the next clock
+   * cycle, if any, in the register journal. Processor models must call this
+   * before clocking the design.
+   */
+  template <typename RF>
+  void journalRegisterWrite(RF *rf,
+                            RegisterFileType rfid = RegisterFileType::GPR) {
+    if (rf->wr_en_0->out.uValue()) {
+      m_registerJournal.record(rfid, rf->wr_addr.uValue(),
+                               rf->data_in.uValue());
+    }
+  }
+
+  static void setRegisterWrite(RetiredInstruction &retired, bool enabled,
+                               unsigned rd, VInt value) {
+    retired.regWrite = enabled && rd != 0;
+    retired.rd = rd;
+    retired.rdValue = value;
+  }
+
+  static void setMemoryAccess(RetiredInstruction &retired,
+                              const MemoryAccess &access, VInt storeValue) {
+    retired.memAccess = access;
+    if (access.type == MemoryAccess::Write) {
+      const VInt mask = access.bytes >= sizeof(VInt)
+                            ? ~VInt(0)
+                            : (VInt(1) << (access.bytes * 8)) - 1;
+      retired.memValue = storeValue & mask;
+    }
+  }
+
+  /**
+   * @brief recordMemStageAccess
+   * In pipelined models, an instruction accesses data memory some cycles before
+   * it retires. Models record the access of the instruction in the memory
+   * stage before clocking, such that it can be attached to the instruction
+   * once it retires (see attachMemStageAccess). Only required while a
+   * retireHandler is set.
+   */
+  void recordMemStageAccess(AInt pc,
+                            const vsrtl::core::BaseMemory<true> *memory,
+                            VInt storeValue) {
+    m_memStageAccess = {pc, memToAccessInfo(memory), storeValue};
+  }
+
+  void attachMemStageAccess(RetiredInstruction &retired) const {
+    if (m_memStageAccess.pc == retired.pc) {
+      setMemoryAccess(retired, m_memStageAccess.access,
+                      m_memStageAccess.storeValue);
+    }
+  }
+
   MemoryAccess
   memToAccessInfo(const vsrtl::core::BaseMemory<true> *memory) const {
     MemoryAccess access;
@@ -104,9 +192,22 @@ protected:
     return access;
   }
 
+  struct MemStageAccess {
+    AInt pc = 0;
+    MemoryAccess access;
+    VInt storeValue = 0;
+  };
+  MemStageAccess m_memStageAccess;
+
   // m_instructionsRetired should be modified by the processor when it retires
   // (or "un-retires", while reversing) an instruction
   long long m_instructionsRetired = 0;
+
+private:
+  void emitProcessorWasClocked() {
+    CycleProfiler::Scope scope(CycleProfiler::ClockedSignal);
+    processorWasClocked.Emit();
+  }
 };
 
 } // namespace Ripes
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "processors/interface/ripesprocessor.h"
+
+namespace Ripes {
+
+/**
+ * @brief The ProcessorSnapshot struct
+ * A copy of the user-visible state of the processor, published by the
+ * simulation thread whilst running. This allows the GUI to display the
+ * progress of a run without accessing the processor while it is being
+ * clocked.
+ */
+struct ProcessorSnapshot {
+  struct MemoryWrite {
+    AInt address = 0;
+    unsigned bytes = 0;
+    /// Contents of the written bytes as of the snapshot.
+    VInt value = 0;
+  };
+
+  long long cycleCount = 0;
+  long long instructionsRetired = 0;
+  std::map<RegisterFileType, std::vector<VInt>> registers;
+  std::map<StageIndex, StageInfo> stages;
+  /// Memory writes performed since the previous snapshot, oldest first. Only
+  /// the most recent writes are retained.
+  std::vector<MemoryWrite> memoryWrites;
+};
+
+} // namespace Ripes
@@ -24,6 +24,7 @@
 #include "VSRTL/graphics/vsrtl_widget.h"
 
 #include "processors/interface/ripesprocessor.h"
+#include "processors/ripesvsrtlprocessor.h"
 
 namespace Ripes {
 
@@ -108,20 +109,10 @@ ProcessorTab::ProcessorTab(QToolBar *controlToolbar,
 
   setupSimulatorActions(controlToolbar);
 
-  // Setup statistics update timer - this timer is distinct from the
-  // ProcessorHandler's update timer, given that it needs to run during
-  // 'running' the processor.
-  m_statUpdateTimer = new QTimer(this);
-  m_statUpdateTimer->setInterval(
-      1000.0 / RipesSettings::value(RIPES_SETTING_UIUPDATEPS).toInt());
-  connect(m_statUpdateTimer, &QTimer::timeout, this,
+  // Statistics are updated from the processor snapshots published whilst
+  // running the processor.
+  connect(ProcessorHandler::get(), &ProcessorHandler::snapshotPublished, this,
           &ProcessorTab::updateStatistics);
-  connect(RipesSettings::getObserver(RIPES_SETTING_UIUPDATEPS),
-          &SettingObserver::modified, m_statUpdateTimer, [=] {
-            m_statUpdateTimer->setInterval(
-                1000.0 /
-                RipesSettings::value(RIPES_SETTING_UIUPDATEPS).toInt());
-          });
 
   // Connect changes in VSRTL reversible stack size to checking whether the
   // simulator is reversible
@@ -299,14 +290,20 @@ void ProcessorTab::setupSimulatorActions(QToolBar *controlToolbar) {
 }
 
 void ProcessorTab::updateStatistics() {
+  long long cycleCount, instrsRetired;
+  if (ProcessorHandler::isRunning()) {
+    const auto &snapshot = ProcessorHandler::getSnapshot();
+    cycleCount = snapshot.cycleCount;
+    instrsRetired = snapshot.instructionsRetired;
+  } else {
+    cycleCount = ProcessorHandler::getProcessor()->getCycleCount();
+    instrsRetired = ProcessorHandler::getProcessor()->getInstructionsRetired();
+  }
+
   static auto lastUpdateTime = std::chrono::system_clock::now();
-  static long long lastCycleCount =
-      ProcessorHandler::getProcessor()->getCycleCount();
+  static long long lastCycleCount = cycleCount;
 
   const auto timeNow = std::chrono::system_clock::now();
-  const auto cycleCount = ProcessorHandler::getProcessor()->getCycleCount();
-  const auto instrsRetired =
-      ProcessorHandler::getProcessor()->getInstructionsRetired();
   const auto timeDiff = std::chrono::duration_cast<std::chrono::milliseconds>(
                             timeNow - lastUpdateTime)
                             .count() /
@@ -348,7 +345,11 @@ void ProcessorTab::fitToScreen() { m_vsrtlWidget->zoomToFit(); }
 
 void ProcessorTab::loadProcessorToWidget(const Layout *layout) {
   const bool doPlaceAndRoute = layout != nullptr;
-  ProcessorHandler::loadProcessorToWidget(m_vsrtlWidget, doPlaceAndRoute);
+  // Currently, only VSRTL processors can be visualized
+  if (auto *vsrtlProcessor = dynamic_cast<RipesVSRTLProcessor *>(
+          ProcessorHandler::getProcessorNonConst())) {
+    m_vsrtlWidget->setDesign(vsrtlProcessor, doPlaceAndRoute);
+  }
 
   // Construct stage instruction labels
   auto *topLevelComponent = m_vsrtlWidget->getTopLevelComponent();
@@ -520,7 +521,6 @@ void ProcessorTab::runFinished() {
   pause();
   ProcessorHandler::checkProcessorFinished();
   m_vsrtlWidget->sync();
-  m_statUpdateTimer->stop();
 }
 
 void ProcessorTab::autoClockTimeout() {
@@ -562,10 +562,8 @@ void ProcessorTab::run(bool state) {
   }
   if (state) {
     ProcessorHandler::run();
-    m_statUpdateTimer->start();
   } else {
     ProcessorHandler::stopRun();
-    m_statUpdateTimer->stop();
   }
 
   // Enable/Disable all actions based on whether the processor is running.
@@ -577,14 +575,13 @@ void ProcessorTab::run(bool state) {
   m_displayValuesAction->setEnabled(!state);
   m_pipelineDiagramAction->setEnabled(!state);
 
-  // Disable widgets which are not updated when running the processor
+  // Disable widgets which are not updated when running the processor. The
+  // register and instruction views are updated from processor snapshots.
   m_vsrtlWidget->setEnabled(!state);
-  m_ui->registerContainerWidget->setEnabled(!state);
-  m_ui->instructionView->setEnabled(!state);
 }
 
 void ProcessorTab::reverse() {
-  m_vsrtlWidget->reverse();
+  ProcessorHandler::reverse();
   enableSimulatorControls();
 }
 
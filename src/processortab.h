@@ -74,8 +74,6 @@ private:
 
   std::map<StageIndex, vsrtl::Label *> m_stageInstructionLabels;
 
-  QTimer *m_statUpdateTimer;
-
   // Actions
   QAction *m_selectProcessorAction = nullptr;
   QAction *m_clockAction = nullptr;
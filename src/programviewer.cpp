@@ -5,6 +5,7 @@
 #include <QEvent>
 #include <QFontMetricsF>
 #include <QMenu>
+#include <QMimeData>
 #include <QTextBlock>
 
 #include "colors.h"
@@ -20,6 +21,8 @@ ProgramViewer::ProgramViewer(QWidget *parent) : HighlightableTextEdit(parent) {
           &ProgramViewer::updateSidebarWidth);
   connect(this, &QPlainTextEdit::updateRequest, this,
           &ProgramViewer::updateSidebar);
+  connect(verticalScrollBar(), &QScrollBar::valueChanged, this,
+          &ProgramViewer::renderVisibleLines);
   updateSidebarWidth(0);
 
   // Set font for the entire widget. calls to fontMetrics() will get the
@@ -31,6 +34,7 @@ ProgramViewer::ProgramViewer(QWidget *parent) : HighlightableTextEdit(parent) {
   setTabStopDistance(QFontMetricsF(m_font).horizontalAdvance(' ') * 4);
 
   setLineWrapMode(QPlainTextEdit::NoWrap);
+  document()->setUndoRedoEnabled(false);
 }
 
 void ProgramViewer::clearBreakpoints() { ProcessorHandler::clearBreakpoints(); }
@@ -41,6 +45,7 @@ void ProgramViewer::resizeEvent(QResizeEvent *e) {
   const QRect cr = contentsRect();
   m_breakpointArea->setGeometry(cr.left(), cr.top(), m_breakpointArea->width(),
                                 cr.height());
+  renderVisibleLines();
 
   // we need to update the highlighted lines whenever resizing the window to
   // recalculate the highlighting gradient, reflecting the new widget size
@@ -48,18 +53,60 @@ void ProgramViewer::resizeEvent(QResizeEvent *e) {
 }
 
 void ProgramViewer::updateProgram(bool binary) {
-  m_labelAddrOffsetMap.clear();
-  const QString text =
-      binary ? Assembler::binobjdump(ProcessorHandler::getProgram(),
-                                     m_labelAddrOffsetMap)
-             : Assembler::objdump(ProcessorHandler::getProgram(),
-                                  m_labelAddrOffsetMap);
+  m_listing = Assembler::ObjdumpListing(
+      ProcessorHandler::getProgram(),
+      binary ? Assembler::ObjdumpListing::Format::Binary
+             : Assembler::ObjdumpListing::Format::Disassembly);
 
   clearBlockHighlights();
-  setPlainText(text);
+  // Each line of the listing is terminated by a newline. Lines are rendered
+  // once visible.
+  setPlainText(QString(m_listing.lineCount(), '\n'));
+  renderVisibleLines();
   updateHighlightedAddresses();
 }
 
+void ProgramViewer::renderVisibleLines() {
+  const int viewportBottom = viewport()->rect().bottom();
+  QTextBlock block = firstVisibleBlock();
+  editPreservingHighlights([&] {
+    QTextCursor cursor(document());
+    while (block.isValid() &&
+           blockBoundingGeometry(block).translated(contentOffset()).top() <=
+               viewportBottom) {
+      const unsigned line = block.blockNumber();
+      // Rendered blocks are marked through their user state, which is reset
+      // whenever the document is replaced.
+      if (block.userState() == -1 && line < m_listing.lineCount()) {
+        cursor.setPosition(block.position());
+        cursor.insertText(m_listing.line(line));
+        block.setUserState(1);
+      }
+      block = block.next();
+    }
+  });
+}
+
+QMimeData *ProgramViewer::createMimeDataFromSelection() const {
+  const QTextCursor cursor = textCursor();
+  const QTextBlock first = document()->findBlock(cursor.selectionStart());
+  const QTextBlock last = document()->findBlock(cursor.selectionEnd());
+  for (auto block = first; block.isValid(); block = block.next()) {
+    if (block.userState() == -1 &&
+        static_cast<unsigned>(block.blockNumber()) < m_listing.lineCount()) {
+      // The selection spans lines which have not yet been rendered; copy the
+      // selected lines in their entirety from the listing.
+      auto *mimeData = new QMimeData();
+      mimeData->setText(
+          m_listing.text(first.blockNumber(), last.blockNumber() + 1));
+      return mimeData;
+    }
+    if (block == last)
+      break;
+  }
+  return HighlightableTextEdit::createMimeDataFromSelection();
+}
+
 void ProgramViewer::updateSidebar(const QRect &rect, int /*dy*/) {
   m_breakpointArea->update(0, rect.y(), m_breakpointArea->width(),
                            rect.height());
@@ -175,31 +222,31 @@ QTextBlock ProgramViewer::blockForAddress(AInt addr) const {
       adjustedLineNumber = index.value();
   }
 
-  if (m_labelAddrOffsetMap.empty()) {
+  if (m_listing.addrOffsetMap().empty()) {
     return document()->findBlockByNumber(adjustedLineNumber);
   }
 
   uint64_t lineNumber = adjustedLineNumber;
-  auto low = m_labelAddrOffsetMap.lower_bound(lineNumber);
-  if (low == m_labelAddrOffsetMap.begin() && lineNumber < low->first) {
+  auto low = m_listing.addrOffsetMap().lower_bound(lineNumber);
+  if (low == m_listing.addrOffsetMap().begin() && lineNumber < low->first) {
     // The line number is less that the position of the first offset block;
     // block is directly inferred from linenumber.
     return document()->findBlockByNumber(adjustedLineNumber);
   }
 
   auto high = low;
-  if (low != m_labelAddrOffsetMap.begin()) {
-    low = std::prev(m_labelAddrOffsetMap.lower_bound(lineNumber));
+  if (low != m_listing.addrOffsetMap().begin()) {
+    low = std::prev(m_listing.addrOffsetMap().lower_bound(lineNumber));
   }
   high = std::next(low);
 
   auto validBlockRange = [&] {
-    if (m_labelAddrOffsetMap.count(lineNumber))
+    if (m_listing.addrOffsetMap().count(lineNumber))
       return false;
 
     bool valid = true;
     valid &= (low->first - low->second.first) <= adjustedLineNumber;
-    if (high != m_labelAddrOffsetMap.end()) {
+    if (high != m_listing.addrOffsetMap().end()) {
       valid &= adjustedLineNumber < (high->first - high->second.first);
     }
     return valid;
@@ -207,12 +254,12 @@ QTextBlock ProgramViewer::blockForAddress(AInt addr) const {
 
   // Adjust low and high iterators to locate the range bounds of the address
   while (!validBlockRange()) {
-    low = m_labelAddrOffsetMap.lower_bound(lineNumber);
+    low = m_listing.addrOffsetMap().lower_bound(lineNumber);
     high = std::next(low);
     lineNumber = low->first + 1;
   }
 
-  const int offsetSum = high == m_labelAddrOffsetMap.end()
+  const int offsetSum = high == m_listing.addrOffsetMap().end()
                             ? low->second.first + 1
                             : high->second.first;
   lineNumber = offsetSum + adjustedLineNumber;
@@ -241,25 +288,25 @@ AInt ProgramViewer::addressForBlock(QTextBlock block, bool &ok) const {
   const int lineNumber = block.blockNumber();
 
   // Clicking an invalid line? (non-instruction line)
-  if (m_labelAddrOffsetMap.count(lineNumber)) {
+  if (m_listing.addrOffsetMap().count(lineNumber)) {
     ok = false;
     return 0;
   }
 
   // To identify the program address corresponding to the selected line, we find
-  // the lower bound of the selected block in the m_labelAddrOffsetMap and
+  // the lower bound of the selected block in the m_listing.addrOffsetMap() and
   // subtract the invalid line count up to the given point.
   int adjustedLineNumber = lineNumber;
 
-  if (m_labelAddrOffsetMap.empty()) {
+  if (m_listing.addrOffsetMap().empty()) {
     auto calcAddressRes = calcAddressFunc(adjustedLineNumber);
     ok = calcAddressRes.has_value();
     return ok ? calcAddressRes.value() : 0;
   }
 
-  auto low = m_labelAddrOffsetMap.lower_bound(lineNumber);
+  auto low = m_listing.addrOffsetMap().lower_bound(lineNumber);
 
-  if ((low == m_labelAddrOffsetMap.begin()) &&
+  if ((low == m_listing.addrOffsetMap().begin()) &&
       static_cast<unsigned>(lineNumber) < low->first) {
     // The line number is less that the position of the first offset block;
     // address is directly inferred from linenumber.
@@ -268,8 +315,8 @@ AInt ProgramViewer::addressForBlock(QTextBlock block, bool &ok) const {
     return ok ? calcAddressRes.value() : 0;
   }
 
-  if (low != m_labelAddrOffsetMap.begin()) {
-    low = std::prev(m_labelAddrOffsetMap.lower_bound(lineNumber));
+  if (low != m_listing.addrOffsetMap().begin()) {
+    low = std::prev(m_listing.addrOffsetMap().lower_bound(lineNumber));
   }
 
   adjustedLineNumber -= (low->second.first + 1);
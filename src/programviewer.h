@@ -32,7 +32,7 @@ public:
   void setCenterAddress(const AInt address);
 
   const Assembler::AddrOffsetMap &addressOffsetMap() const {
-    return m_labelAddrOffsetMap;
+    return m_listing.addrOffsetMap();
   }
 
   ///
@@ -48,6 +48,7 @@ public slots:
 
 protected:
   void resizeEvent(QResizeEvent *event) override;
+  QMimeData *createMimeDataFromSelection() const override;
 
 private slots:
   void updateSidebar(const QRect &, int);
@@ -62,6 +63,16 @@ private:
    */
   void updateCenterAddressFromProcessor();
 
+  /**
+   * @brief renderVisibleLines
+   * The document of the viewer initially consists of empty lines; the text of
+   * each line is rendered from the listing once it first becomes visible.
+   * Laying out the listing is still linear in the size of the program (each
+   * instruction is disassembled to learn its size), but only the visible lines
+   * are rendered.
+   */
+  void renderVisibleLines();
+
   // A timer is needed for only catching one of the multiple wheel events that
   // occur on a regular mouse scroll
   QTimer m_fontTimer;
@@ -75,15 +86,16 @@ private:
   BreakpointArea *m_breakpointArea;
 
   /**
-   * @brief m_labelAddrOffsetMap
-   * To correctly correlate a line index with program address location whilst
-   * accounting for additional output in the disassembled view of a program, we
-   * provide the AddrOffsetMap. Key in this map indicate line numbers (starting
-   * from 0) which does >not< correspond with an address. The value of the key
+   * @brief m_listing
+   * The listing of the currently displayed program. To correctly correlate a
+   * line index with program address location whilst accounting for additional
+   * output in the disassembled view of a program, the listing provides an
+   * AddrOffsetMap. Key in this map indicate line numbers (starting from 0)
+   * which does >not< correspond with an address. The value of the key
    * corresponds to the total sum of non-address lines encountered up to and
    * including the given label.
    */
-  Assembler::AddrOffsetMap m_labelAddrOffsetMap;
+  Assembler::ObjdumpListing m_listing;
 };
 
 class BreakpointArea : public QWidget {
@@ -11,6 +11,8 @@ RegisterContainerWidget::RegisterContainerWidget(QWidget *parent)
   m_ui->setupUi(this);
   connect(ProcessorHandler::get(), &ProcessorHandler::procStateChangedNonRun,
           this, &RegisterContainerWidget::updateView);
+  connect(ProcessorHandler::get(), &ProcessorHandler::snapshotPublished, this,
+          &RegisterContainerWidget::updateView);
   connect(ProcessorHandler::get(), &ProcessorHandler::processorChanged, this,
           &RegisterContainerWidget::initialize);
   initialize();
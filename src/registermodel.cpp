@@ -16,6 +16,17 @@ RegisterModel::RegisterModel(RegisterFileType rft, QObject *parent)
 }
 
 std::vector<VInt> RegisterModel::gatherRegisterValues() {
+  if (ProcessorHandler::isRunning()) {
+    // The processor is not accessed whilst running; values are taken from the
+    // latest published snapshot.
+    const auto &registers = ProcessorHandler::getSnapshot().registers;
+    const auto it = registers.find(m_rft);
+    if (it != registers.end() &&
+        it->second.size() == static_cast<size_t>(rowCount()))
+      return it->second;
+    return m_regValues;
+  }
+
   std::vector<VInt> vals;
   for (int i = 0; i < rowCount(); ++i)
     vals.push_back(ProcessorHandler::getRegisterValue(m_rft, i));
@@ -29,7 +40,16 @@ int RegisterModel::rowCount(const QModelIndex &) const {
 }
 
 void RegisterModel::processorWasClocked() {
-  // Reload model
+  if (!ProcessorHandler::isRunning() &&
+      m_regValues.size() == static_cast<size_t>(rowCount()) &&
+      updateFromJournal())
+    return;
+
+  // Reload model. The journal position is taken before re-reading the
+  // registers, such that writes recorded in the meantime are replayed by the
+  // next update.
+  const uint64_t journalPosition =
+      ProcessorHandler::getProcessor()->registerJournal().position();
   beginResetModel();
   endResetModel();
   const auto newRegValues = gatherRegisterValues();
@@ -43,6 +63,42 @@ void RegisterModel::processorWasClocked() {
     }
   }
   m_regValues = newRegValues;
+  if (!ProcessorHandler::isRunning())
+    m_journalPosition = journalPosition;
+}
+
+bool RegisterModel::updateFromJournal() {
+  const auto &journal = ProcessorHandler::getProcessor()->registerJournal();
+  int lastModified = -1;
+  const auto consumed = journal.forEachSince(
+      m_journalPosition, [&](const RegisterJournal::Write &write) {
+        if (write.rfid != m_rft || write.index >= m_regValues.size())
+          return;
+        // The register is re-read, given that it may have been written again
+        // since the journaled write.
+        const VInt value = registerData(write.index);
+        if (value != m_regValues[write.index]) {
+          m_regValues[write.index] = value;
+          lastModified = write.index;
+          emit dataChanged(index(write.index, Column::Value),
+                           index(write.index, Column::Value));
+        }
+      });
+  if (!consumed)
+    return false;
+
+  m_journalPosition = *consumed;
+  if (lastModified != -1) {
+    const int prevModified = m_mostRecentlyModifiedReg;
+    m_mostRecentlyModifiedReg = lastModified;
+    if (prevModified != -1 && prevModified != lastModified) {
+      emit dataChanged(index(prevModified, 0),
+                       index(prevModified, NColumns - 1));
+    }
+    emit dataChanged(index(lastModified, 0), index(lastModified, NColumns - 1));
+    emit registerChanged(lastModified);
+  }
+  return true;
 }
 
 bool RegisterModel::setData(const QModelIndex &index, const QVariant &value,
@@ -125,7 +181,8 @@ QVariant RegisterModel::data(const QModelIndex &index, int role) const {
 
 void RegisterModel::setRadix(Ripes::Radix r) {
   m_radix = r;
-  processorWasClocked();
+  beginResetModel();
+  endResetModel();
 }
 
 QVariant RegisterModel::nameData(unsigned idx) const {
@@ -141,6 +198,8 @@ QVariant RegisterModel::tooltipData(unsigned idx) const {
 }
 
 VInt RegisterModel::registerData(unsigned idx) const {
+  if (ProcessorHandler::isRunning() && idx < m_regValues.size())
+    return m_regValues[idx];
   return ProcessorHandler::getRegisterValue(m_rft, idx);
 }
 
@@ -152,7 +211,7 @@ Qt::ItemFlags RegisterModel::flags(const QModelIndex &index) const {
   const auto def = ProcessorHandler::currentISA()->regIsReadOnly(index.row())
                        ? Qt::NoItemFlags
                        : Qt::ItemIsEnabled;
-  if (index.column() == Column::Value)
+  if (index.column() == Column::Value && !ProcessorHandler::isRunning())
     return Qt::ItemIsEditable | def;
   return def;
 }
@@ -43,6 +43,10 @@ signals:
 
 private:
   std::vector<VInt> gatherRegisterValues();
+  /// Updates the registers written since the last update, as recorded in the
+  /// register journal of the processor. Returns false if the journal does not
+  /// cover all writes since the last update.
+  bool updateFromJournal();
 
   QVariant nameData(unsigned idx) const;
   QVariant aliasData(unsigned idx) const;
@@ -56,5 +60,7 @@ private:
 
   int m_mostRecentlyModifiedReg = -1;
   std::vector<VInt> m_regValues;
+  /// Position of the processor's register journal as of the last update.
+  uint64_t m_journalPosition = 0;
 };
 } // namespace Ripes
@@ -1,6 +1,7 @@
 #include "registerwidget.h"
 #include "ui_registerwidget.h"
 
+#include <QApplication>
 #include <QClipboard>
 #include <QHeaderView>
 #include <QInputDialog>
@@ -25,6 +25,8 @@ const std::map<QString, QVariant> s_defaultSettings = {
     {RIPES_SETTING_CONSOLEFONT,
      QVariant() /* Let Console define its own default font */},
     {RIPES_SETTING_CONSOLEFONT, QColorConstants::Black},
+    {RIPES_SETTING_CONSOLE_SCROLLBACK, 100},
+    {RIPES_SETTING_CONSOLE_OUTPUTFILE, ""},
     {RIPES_SETTING_INDENTAMT, 4},
     {RIPES_SETTING_UIUPDATEPS, 25},
 
@@ -75,12 +77,23 @@ const std::map<QString, QVariant> s_defaultSettings = {
     {RIPES_SETTING_SAVE_SOURCE, true},
     {RIPES_SETTING_SAVE_BINARY, false}};
 
+SettingObserver::SettingObserver(const QString &key) : m_key(key) {
+  QSettings settings;
+  Q_ASSERT(settings.contains(m_key));
+  m_value = settings.value(m_key);
+}
+
 void SettingObserver::setValue(const QVariant &v) {
   QSettings settings;
   Q_ASSERT(settings.contains(m_key));
   settings.setValue(m_key, v);
+  const QVariant value = settings.value(m_key);
+  {
+    QMutexLocker lock(&m_lock);
+    m_value = value;
+  }
 
-  emit modified(value());
+  emit modified(value);
 }
 
 void SettingObserver::trigger() { setValue(value()); }
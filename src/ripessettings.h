@@ -2,8 +2,12 @@
 
 #include <QColor>
 #include <QFont>
+#include <QMutex>
 #include <QSettings>
 
+#include <atomic>
+#include <type_traits>
+
 namespace Ripes {
 
 // =========== Definitions of the name of all settings within Ripes ============
@@ -19,6 +23,8 @@ namespace Ripes {
 #define RIPES_SETTING_CONSOLEBG ("console_bg_color")
 #define RIPES_SETTING_CONSOLEFONTCOLOR ("console_font_color")
 #define RIPES_SETTING_CONSOLEFONT ("console_font")
+#define RIPES_SETTING_CONSOLE_SCROLLBACK ("console_scrollback")
+#define RIPES_SETTING_CONSOLE_OUTPUTFILE ("console_output_file")
 #define RIPES_SETTING_INDENTAMT ("editor_indent")
 #define RIPES_SETTING_UIUPDATEPS ("ui_update_ps")
 
@@ -68,20 +74,20 @@ const extern std::map<QString, QVariant> s_defaultSettings;
  * A wrapper class around a single Ripes setting.
  * Provides a slot for setting the setting and a signal for broadcasting that
  * the setting was modified. Useful for propagating settings changes to all over
- * the codebase.
+ * the codebase. The value of the setting may be read from any thread, whereas
+ * it must only be modified from the GUI thread.
  */
 class SettingObserver : public QObject {
   Q_OBJECT
   friend class RipesSettings;
 
 public:
-  SettingObserver(const QString &key) : m_key(key) {}
+  SettingObserver(const QString &key);
 
   template <typename T = QVariant>
   T value() const {
-    QSettings settings;
-    Q_ASSERT(settings.contains(m_key));
-    return settings.value(m_key).value<T>();
+    QMutexLocker lock(&m_lock);
+    return m_value.value<T>();
   }
 
 signals:
@@ -93,6 +99,10 @@ public slots:
 
 private:
   QString m_key;
+  // In-memory copy of the setting, avoiding a QSettings lookup on each read.
+  // Guarded by m_lock.
+  QVariant m_value;
+  mutable QMutex m_lock;
 };
 
 class RipesSettings : public QSettings {
@@ -124,4 +134,37 @@ private:
   std::map<QString, SettingObserver> m_observers;
 };
 
+/**
+ * @brief The CachedSetting class
+ * A typed copy of a single Ripes setting, for settings which are read on hot
+ * paths (e.g. once per clock cycle). The setting is converted to T once, and
+ * refreshed whenever the setting is modified. The copy is atomic, such that it
+ * may be read from the simulator thread whilst modified from the GUI thread.
+ */
+template <typename T>
+class CachedSetting {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "CachedSetting requires a trivially copyable type");
+
+public:
+  CachedSetting(const QString &key) {
+    auto *observer = RipesSettings::getObserver(key);
+    m_value.store(observer->value<T>(), std::memory_order_relaxed);
+    m_connection = QObject::connect(
+        observer, &SettingObserver::modified, [this](const QVariant &value) {
+          m_value.store(value.value<T>(), std::memory_order_relaxed);
+        });
+  }
+  ~CachedSetting() { QObject::disconnect(m_connection); }
+
+  CachedSetting(const CachedSetting &) = delete;
+  CachedSetting &operator=(const CachedSetting &) = delete;
+
+  T value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<T> m_value;
+  QMetaObject::Connection m_connection;
+};
+
 } // namespace Ripes
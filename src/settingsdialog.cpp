@@ -412,13 +412,11 @@ QWidget *SettingsDialog::createEnvironmentPage() {
   maxPointsSb->setMinimum(2);
   maxPointsSb->setMaximum(INT_MAX);
   appendToLayout({maxPointsLabel, maxPointsSb}, pageLayout,
-                 "Minimum number of points to be kept in the cache plot. Once "
-                 "2x this amount is reached, the cache "
-                 "plot will be resampled to this minimum value, and new points "
-                 "will be added based on the sampling "
-                 "rate after the resampling. This resampling allows for "
-                 "real-time plotting regardless of the number of "
-                 "simulation cycles.");
+                 "Minimum resolution of the cache plot. The visible range of "
+                 "the plot is divided into at least this many intervals, for "
+                 "each of which the minimum and maximum value is plotted. "
+                 "This allows for real-time plotting regardless of the number "
+                 "of simulation cycles.");
 
   auto [maxPipeDiagCycLabel, maxPipeDiagCycSb] =
       createSettingsWidgets<QSpinBox>(RIPES_SETTING_PIPEDIAGRAM_MAXCYCLES,
@@ -446,6 +444,29 @@ QWidget *SettingsDialog::createEnvironmentPage() {
   appendToLayout(createSettingsWidgets<QPushButton, QColorDialog>(
                      RIPES_SETTING_CONSOLEBG, "Console background color:"),
                  consoleLayout);
+
+  auto [scrollbackLabel, scrollbackSb] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_CONSOLE_SCROLLBACK, "Console scrollback lines:");
+  scrollbackSb->setMinimum(1);
+  scrollbackSb->setMaximum(INT_MAX);
+  appendToLayout({scrollbackLabel, scrollbackSb}, consoleLayout,
+                 "Maximum number of lines kept in the console. Older lines are "
+                 "discarded.");
+  auto [outputFileLabel, outputFile] = createSettingsWidgets<QLineEdit>(
+      RIPES_SETTING_CONSOLE_OUTPUTFILE, "Console output file:");
+  // Only apply the path once editing has finished; applying each intermediate
+  // path would create files for partially typed paths.
+  auto *outputFileObserver =
+      RipesSettings::getObserver(RIPES_SETTING_CONSOLE_OUTPUTFILE);
+  outputFile->disconnect(outputFileObserver);
+  connect(outputFile, &QLineEdit::editingFinished, outputFileObserver,
+          [outputFile = outputFile, outputFileObserver] {
+            if (outputFileObserver->value().toString() != outputFile->text())
+              outputFileObserver->setValue(outputFile->text());
+          });
+  appendToLayout({outputFileLabel, outputFile}, consoleLayout,
+                 "If set, all console output is additionally written to this "
+                 "file, regardless of the console scrollback.");
   appendToLayout(consoleGroupBox, pageLayout);
 
   return pageWidget;
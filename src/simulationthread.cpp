@@ -0,0 +1,52 @@
+#include "simulationthread.h"
+
+namespace Ripes {
+
+SimulationThread::SimulationThread(const Executor &executor, QObject *parent)
+    : QThread(parent), m_executor(executor) {}
+
+SimulationThread::~SimulationThread() {
+  if (isRunning()) {
+    SimulationCommand quit;
+    quit.type = SimulationCommand::Quit;
+    post(quit);
+    wait();
+  }
+}
+
+bool SimulationThread::tryPost(const SimulationCommand &command) {
+  if (!m_commands.push(command))
+    return false;
+  m_pending.release();
+  return true;
+}
+
+void SimulationThread::post(const SimulationCommand &command) {
+  while (!tryPost(command))
+    QThread::yieldCurrentThread();
+}
+
+void SimulationThread::execute(SimulationCommand command) {
+  Q_ASSERT(!isCurrentThread() &&
+           "Simulation commands cannot be awaited from the simulation thread");
+  QSemaphore done;
+  command.done = &done;
+  post(command);
+  done.acquire();
+}
+
+void SimulationThread::run() {
+  SimulationCommand command;
+  for (;;) {
+    m_pending.acquire();
+    m_commands.pop(command);
+    if (command.type == SimulationCommand::Quit)
+      return;
+    if (command.type != SimulationCommand::Sync)
+      m_executor(command);
+    if (command.done)
+      command.done->release();
+  }
+}
+
+} // namespace Ripes
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QSemaphore>
+#include <QThread>
+
+#include <functional>
+
+#include "isa/isainfo.h"
+#include "ripes_types.h"
+#include "utilities/spscqueue.h"
+
+namespace Ripes {
+
+/**
+ * @brief The SimulationCommand struct
+ * A request for the simulation thread to operate on the current processor.
+ */
+struct SimulationCommand {
+  enum Type {
+    /// Clock the processor for up to @p cycles cycles.
+    Step,
+    /// Clock the processor until stopped, finished or at a breakpoint.
+    Run,
+    /// Undo the latest clock cycle.
+    Reverse,
+    /// Reset the processor.
+    Reset,
+    /// Write @p value to register @p idx of register file @p rfid.
+    SetRegister,
+    /// Call @p function.
+    Invoke,
+    /// No operation; used to wait for all preceding commands to execute.
+    Sync,
+    /// Terminates the simulation thread.
+    Quit
+  };
+
+  Type type = Sync;
+  unsigned long long cycles = 1;
+  RegisterFileType rfid = RegisterFileType::GPR;
+  unsigned idx = 0;
+  VInt value = 0;
+  std::function<void()> function;
+
+  /// If set, released once the command has been executed.
+  QSemaphore *done = nullptr;
+};
+
+/**
+ * @brief The SimulationThread class
+ * A long-lived thread which executes simulation commands, in order, from a
+ * lock-free command queue. The queue has a single producer; commands must only
+ * be posted from the thread which owns the SimulationThread. Commands are
+ * executed through the executor provided upon construction.
+ *
+ * Only the command queue itself is lock-free. Whilst the queue is empty, the
+ * simulation thread sleeps on a semaphore, and posting a command may take the
+ * internal lock of the semaphore to wake it up.
+ */
+class SimulationThread : public QThread {
+public:
+  using Executor = std::function<void(const SimulationCommand &)>;
+
+  SimulationThread(const Executor &executor, QObject *parent = nullptr);
+  ~SimulationThread() override;
+
+  /// Posts @p command to the simulation thread. Returns false, dropping the
+  /// command, if the command queue is full.
+  bool tryPost(const SimulationCommand &command);
+
+  /// Posts @p command to the simulation thread, waiting for room in the
+  /// command queue if it is full.
+  void post(const SimulationCommand &command);
+
+  /// Posts @p command to the simulation thread and blocks until it has been
+  /// executed.
+  void execute(SimulationCommand command);
+
+  /// Blocks until all previously posted commands have been executed.
+  void waitForIdle() { execute(SimulationCommand()); }
+
+  /// Returns true if called from within the simulation thread.
+  bool isCurrentThread() const { return QThread::currentThread() == this; }
+
+protected:
+  void run() override;
+
+private:
+  Executor m_executor;
+  SPSCQueue<SimulationCommand, 256> m_commands;
+  /// Number of commands in m_commands; the simulation thread sleeps on this
+  /// whilst the queue is empty. Unlike the queue, this is not lock-free.
+  QSemaphore m_pending;
+};
+
+} // namespace Ripes
@@ -6,6 +6,8 @@
 
 #include <QPushButton>
 
+#include <algorithm>
+
 namespace Ripes {
 
 SymbolNavigator::SymbolNavigator(const ReverseSymbolMap &symbolmap,
@@ -25,8 +27,14 @@ SymbolNavigator::SymbolNavigator(const ReverseSymbolMap &symbolmap,
       QHeaderView::ResizeToContents);
   m_ui->buttonBox->button(QDialogButtonBox::Ok)->setText("Go to symbol");
 
-  for (const auto &iter : symbolmap) {
-    addSymbol(iter.first, iter.second);
+  // The symbol map is unordered; list symbols by address.
+  std::vector<std::pair<AInt, QString>> symbols;
+  symbols.reserve(symbolmap.size());
+  for (const auto &iter : symbolmap)
+    symbols.push_back({iter.first, iter.second.v});
+  std::sort(symbols.begin(), symbols.end());
+  for (const auto &symbol : symbols) {
+    addSymbol(symbol.first, symbol.second);
   }
   m_ui->symbolTable->selectRow(0);
 }
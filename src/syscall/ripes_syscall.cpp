@@ -1,21 +1,20 @@
 #include "ripes_syscall.h"
 
 #include "processorhandler.h"
+#include "utilities/cycleprofiler.h"
 
 namespace Ripes {
 
 bool SyscallManager::execute(SyscallID id) {
+  CycleProfiler::Scope scope(CycleProfiler::Syscall);
   if (m_syscalls.count(id) == 0) {
-    postToGUIThread([=] {
-      QMessageBox::warning(
-          nullptr, "Error",
-          "Unknown system call in register '" +
-              ProcessorHandler::currentISA()->regAlias(
-                  ProcessorHandler::currentISA()->syscallReg()) +
-              "': " + QString::number(id) +
-              "\nRefer to \"Help->System calls\" for a list of support system "
-              "calls.");
-    });
+    emit ProcessorHandler::get()->simulationError(
+        "Unknown system call in register '" +
+        ProcessorHandler::currentISA()->regAlias(
+            ProcessorHandler::currentISA()->syscallReg()) +
+        "': " + QString::number(id) +
+        "\nRefer to \"Help->System calls\" for a list of support system "
+        "calls.");
     return false;
   } else {
     const auto &syscall = m_syscalls.at(id);
@@ -1,8 +1,5 @@
 #pragma once
 
-#include <QApplication>
-#include <QLabel>
-#include <QMessageBox>
 #include <QString>
 #include <QThread>
 
@@ -10,5 +10,6 @@ std::map<int, QFile> SystemIO::FileIOData::files;
 QByteArray SystemIO::FileIOData::s_stdinBuffer;
 QMutex SystemIO::FileIOData::s_stdioMutex;
 QWaitCondition SystemIO::FileIOData::s_stdinBufferEmpty;
-bool SystemIO::s_abortSyscall = false;
+std::atomic<bool> SystemIO::s_abortSyscall{false};
+std::atomic<bool> SystemIO::s_waitingForInput{false};
 } // namespace Ripes
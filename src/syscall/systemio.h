@@ -3,18 +3,19 @@
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
-#include <QInputDialog>
 #include <QMutex>
 #include <QObject>
 #include <QTemporaryFile>
 #include <QTextStream>
 #include <QWaitCondition>
 
+#include <atomic>
 #include <stdexcept>
 #include <sys/stat.h>
 
 #include "STLExtras.h"
 #include "statusmanager.h"
+#include "utilities/cycleprofiler.h"
 
 namespace Ripes {
 
@@ -66,7 +67,14 @@ private:
   static QString s_fileErrorString; // = ("File operation OK");
 
   // Flag used for aborting waiting for I/O
-  static bool s_abortSyscall;
+  static std::atomic<bool> s_abortSyscall;
+  // Set whilst a system call is blocked waiting for console input
+  static std::atomic<bool> s_waitingForInput;
+
+  struct InputWait {
+    InputWait() { s_waitingForInput = true; }
+    ~InputWait() { s_waitingForInput = false; }
+  };
 
   // Standard I/O Channels
   enum STDIO { STDIN = 0, STDOUT = 1, STDERR = 2, STDIO_END };
@@ -347,6 +355,9 @@ public:
         SystemIOStatusManager::setStatusTimed("Waiting for user input...",
                                               99999999);
       });
+      // Time spent waiting on the user is not part of the simulation cost.
+      CycleProfiler::Pause pause;
+      InputWait inputWait;
       while (myBuffer.size() < lengthRequested) {
         // Lock the stdio objects and try to read from stdio. If no data is
         // present, wait until so.
@@ -431,6 +442,9 @@ public:
   static void printString(const QString &string) { emit get().doPrint(string); }
   static void reset() { FileIOData::resetFiles(); }
   static void abortSyscall() { s_abortSyscall = true; }
+  /// Returns true if a system call is currently blocked waiting for console
+  /// input.
+  static bool isWaitingForInput() { return s_waitingForInput; }
 
 signals:
   void doPrint(const QString &);
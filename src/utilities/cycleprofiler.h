@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Ripes {
+
+/**
+ * @brief The CycleProfiler class
+ * Opt-in instrumentation of where simulation time is spent within a processor
+ * cycle. Code on the per-cycle path marks its regions with a
+ * CycleProfiler::Scope; when profiling is disabled, a scope costs a single
+ * relaxed atomic load.
+ *
+ * Regions may be nested (e.g. Syscall executes within DesignClock, which in
+ * turn executes within Cycle), and are accumulated independently. Time spent
+ * blocking on the user (see CycleProfiler::Pause) is excluded from all regions
+ * of the blocking thread and accumulated to InputWait instead.
+ */
+class CycleProfiler {
+public:
+  enum Region {
+    /// RipesProcessor::clock, ie. the full cost of a processor cycle.
+    Cycle,
+    /// Design::clock of VSRTL processor models; component propagation and
+    /// register clocking, including the clocked signal emission.
+    DesignClock,
+    /// Emission of RipesProcessor::processorWasClocked to all listeners.
+    ClockedSignal,
+    /// L1CacheShim::processorWasClocked
+    CacheShim,
+    /// PipelineDiagramModel::gatherStageInfo
+    PipelineDiagram,
+    /// SyscallManager::execute
+    Syscall,
+    /// Time spent blocked waiting for console input within system calls.
+    InputWait,
+    NumRegions
+  };
+
+  struct Counter {
+    std::atomic<uint64_t> ns{0};
+    std::atomic<uint64_t> calls{0};
+  };
+
+  static CycleProfiler &get() {
+    static CycleProfiler profiler;
+    return profiler;
+  }
+
+  static bool isEnabled() {
+    return get().m_enabled.load(std::memory_order_relaxed);
+  }
+  static void setEnabled(bool enabled) {
+    get().m_enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  /// Clears all accumulated counters.
+  static void reset() {
+    for (auto &counter : get().m_counters) {
+      counter.ns.store(0, std::memory_order_relaxed);
+      counter.calls.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  static void record(Region region, uint64_t ns) {
+    auto &counter = get().m_counters[region];
+    counter.ns.fetch_add(ns, std::memory_order_relaxed);
+    counter.calls.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static uint64_t nanoseconds(Region region) {
+    return get().m_counters[region].ns.load(std::memory_order_relaxed);
+  }
+  static uint64_t calls(Region region) {
+    return get().m_counters[region].calls.load(std::memory_order_relaxed);
+  }
+
+  static const char *name(Region region) {
+    switch (region) {
+    case Cycle:
+      return "cycle";
+    case DesignClock:
+      return "design clock";
+    case ClockedSignal:
+      return "clocked signal";
+    case CacheShim:
+      return "cache shim";
+    case PipelineDiagram:
+      return "pipeline diagram";
+    case Syscall:
+      return "syscall";
+    case InputWait:
+      return "input wait";
+    case NumRegions:
+      break;
+    }
+    return "";
+  }
+
+  /**
+   * @brief The Scope class
+   * Records the time spent between construction and destruction of the scope
+   * to the given region, if profiling was enabled upon construction.
+   */
+  class Scope {
+  public:
+    explicit Scope(Region region) : m_region(region) {
+      if (isEnabled()) {
+        m_active = true;
+        m_pausedAtStart = pausedNs();
+        m_start = std::chrono::steady_clock::now();
+      }
+    }
+    ~Scope() {
+      if (m_active) {
+        const uint64_t paused = pausedNs() - m_pausedAtStart;
+        const uint64_t elapsed = elapsedNs(m_start);
+        record(m_region, elapsed > paused ? elapsed - paused : 0);
+      }
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    Region m_region;
+    bool m_active = false;
+    uint64_t m_pausedAtStart = 0;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  /**
+   * @brief The Pause class
+   * Marks a region wherein the calling thread is blocked on something external
+   * to the simulation, such as user input. The time spent is subtracted from
+   * all enclosing scopes of the thread and recorded to InputWait.
+   */
+  class Pause {
+  public:
+    Pause() {
+      if (isEnabled()) {
+        m_active = true;
+        m_start = std::chrono::steady_clock::now();
+      }
+    }
+    ~Pause() {
+      if (m_active) {
+        const uint64_t elapsed = elapsedNs(m_start);
+        pausedNs() += elapsed;
+        record(InputWait, elapsed);
+      }
+    }
+    Pause(const Pause &) = delete;
+    Pause &operator=(const Pause &) = delete;
+
+  private:
+    bool m_active = false;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+private:
+  CycleProfiler() = default;
+
+  static uint64_t elapsedNs(std::chrono::steady_clock::time_point start) {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+        .count();
+  }
+
+  /// Total time paused on the calling thread.
+  static uint64_t &pausedNs() {
+    thread_local uint64_t ns = 0;
+    return ns;
+  }
+
+  std::atomic<bool> m_enabled{false};
+  std::array<Counter, NumRegions> m_counters;
+};
+
+} // namespace Ripes
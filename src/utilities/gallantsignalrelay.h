@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QMetaObject>
+#include <QObject>
+
+#include <functional>
+
+#include "Signals/Signal.h"
+
+namespace Ripes {
+
+/**
+ * @brief The GallantSignalRelay class
+ * Relays emissions of a Gallant signal to a function executed in the thread of
+ * a receiving QObject. Gallant signals are emitted by the processor models in
+ * whichever thread clocks the processor; relaying these makes it safe for the
+ * receiver to react to them.
+ *
+ * The relay must outlive the emitting signal, given that it does not
+ * disconnect itself upon destruction.
+ */
+class GallantSignalRelay {
+public:
+  GallantSignalRelay(QObject *receiver, const std::function<void()> &f,
+                     Gallant::Signal0<> &signal)
+      : m_receiver(receiver), m_f(f) {
+    signal.Connect(this, &GallantSignalRelay::relay);
+  }
+  GallantSignalRelay(const GallantSignalRelay &) = delete;
+  GallantSignalRelay &operator=(const GallantSignalRelay &) = delete;
+
+private:
+  void relay() { QMetaObject::invokeMethod(m_receiver, m_f); }
+
+  QObject *m_receiver = nullptr;
+  std::function<void()> m_f;
+};
+
+} // namespace Ripes
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace Ripes {
+
+/**
+ * @brief The SPSCQueue class
+ * A bounded, lock-free single-producer/single-consumer queue. push() may only
+ * be called from a single (producer) thread, and pop() from a single
+ * (consumer) thread. Neither operation blocks; push() fails when the queue is
+ * full and pop() fails when it is empty.
+ */
+template <typename T, size_t Capacity>
+class SPSCQueue {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "SPSCQueue capacity must be a power of two");
+
+public:
+  /// Appends @p value to the queue. Returns false if the queue is full.
+  bool push(const T &value) {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+      return false;
+    m_buffer[tail & (Capacity - 1)] = value;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Removes the oldest value of the queue into @p value. Returns false if the
+  /// queue is empty.
+  bool pop(T &value) {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire))
+      return false;
+    value = m_buffer[head & (Capacity - 1)];
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const {
+    return m_head.load(std::memory_order_acquire) ==
+           m_tail.load(std::memory_order_acquire);
+  }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+private:
+  std::array<T, Capacity> m_buffer;
+  // The indices are written by different threads; keep them on separate cache
+  // lines to avoid false sharing between the producer and the consumer.
+  alignas(64) std::atomic<size_t> m_head{0};
+  alignas(64) std::atomic<size_t> m_tail{0};
+};
+
+} // namespace Ripes
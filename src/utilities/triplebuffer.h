@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace Ripes {
+
+/**
+ * @brief The TripleBuffer class
+ * Lock-free hand-over of values from a single writer thread to a single reader
+ * thread. The writer fills back() and publishes it; the reader picks up the
+ * most recently published value through update() and reads it through
+ * front(). Neither side ever waits on the other, and the writer may publish at
+ * any rate; values which the reader did not pick up in time are overwritten.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+  /// Writer: the buffer to be filled with the next value.
+  T &back() { return m_buffers[m_back]; }
+
+  /// Writer: publishes the contents of back(). back() then refers to a buffer
+  /// which holds some older value.
+  void publish() {
+    m_back = m_middle.exchange(m_back | s_fresh, std::memory_order_acq_rel) &
+             s_indexMask;
+  }
+
+  /// Reader: picks up the most recently published value, if any value was
+  /// published since the last update. Returns true if front() changed.
+  bool update() {
+    if (!(m_middle.load(std::memory_order_relaxed) & s_fresh))
+      return false;
+    m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) &
+              s_indexMask;
+    return true;
+  }
+
+  /// Reader: the most recently picked up value.
+  const T &front() const { return m_buffers[m_front]; }
+
+private:
+  static constexpr unsigned s_indexMask = 0b11;
+  static constexpr unsigned s_fresh = 0b100;
+
+  std::array<T, 3> m_buffers;
+  // Index of the buffer which is in transit between the writer and the reader,
+  // tagged with s_fresh if it has not yet been picked up by the reader.
+  std::atomic<unsigned> m_middle{1};
+  // Owned by the writer.
+  unsigned m_back = 0;
+  // Owned by the reader.
+  unsigned m_front = 2;
+};
+
+} // namespace Ripes
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QObject>
+#include <QSignalSpy>
 #include <QTest>
 
 #include "edittab.h"
@@ -39,9 +40,15 @@ private:
   // Load a program through the edittab. This is not really suited for automatic
   // testing, since the edit tab will trigger assembling after some timeout. To
   // work around this, we allow for a bit of delay when loading the program.
+  // Assembly runs in the background, so wait for the edit tab to apply the
+  // result.
   void processNewTest() {
-    if (currentTestType == SourceType::Assembly)
+    if (currentTestType == SourceType::Assembly) {
+      QSignalSpy assembled(m_editTab, &EditTab::assemblyFinished);
       m_editTab->sourceCodeChanged();
+      if (!assembled.wait(10000))
+        QFAIL("Assembly never finished!");
+    }
 
     int timeouts = 5;
     while (timeouts-- > 0 && !ProcessorHandler::getProgram()) {
@@ -0,0 +1,27 @@
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QtGlobal>
+
+namespace {
+
+/// Gives each test process a temporary settings store of its own. Tests are
+/// run concurrently (see run_tests.sh), and would otherwise share (and race
+/// on) the user's settings store, besides modifying the user's configuration.
+/// This is linked into every test executable and runs during static
+/// initialization, i.e. before any access to RipesSettings.
+class TestSettings {
+public:
+  TestSettings() {
+    Q_ASSERT(m_dir.isValid());
+    QSettings::setDefaultFormat(QSettings::IniFormat);
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope,
+                       m_dir.path());
+  }
+
+private:
+  QTemporaryDir m_dir;
+};
+
+const TestSettings s_testSettings;
+
+} // namespace
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QtGlobal>
+
+namespace Ripes {
+
+/// Utility for distributing the work items of a test (e.g. test programs ×
+/// processor models) across multiple processes. Since all simulation goes
+/// through the ProcessorHandler singleton, a single test process can only
+/// simulate one processor at a time; parallelism is instead achieved by
+/// launching multiple instances of a test binary, each executing a disjoint
+/// shard of the work items. The shard of a process is selected through the
+/// RIPES_TEST_SHARD_INDEX and RIPES_TEST_SHARD_COUNT environment variables
+/// (see create_sharded_qtest in test/CMakeLists.txt). If unset, all work items
+/// are executed.
+class TestSharding {
+public:
+  TestSharding() {
+    bool ok = false;
+    const int count =
+        qEnvironmentVariableIntValue("RIPES_TEST_SHARD_COUNT", &ok);
+    if (ok && count > 1) {
+      m_count = count;
+      m_index = qEnvironmentVariableIntValue("RIPES_TEST_SHARD_INDEX");
+      Q_ASSERT(m_index < m_count && "Invalid test shard index");
+    }
+  }
+
+  /// Returns true if the next work item belongs to this process' shard. Must be
+  /// called once for every work item, in a deterministic order.
+  bool next() { return (m_item++ % m_count) == m_index; }
+
+  unsigned index() const { return m_index; }
+  unsigned count() const { return m_count; }
+
+private:
+  unsigned m_index = 0;
+  unsigned m_count = 1;
+  unsigned m_item = 0;
+};
+
+} // namespace Ripes
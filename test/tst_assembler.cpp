@@ -40,6 +40,7 @@ private slots:
   void tst_weirdDirectives();
   void tst_edgeImmediates();
   void tst_benchmarkNew();
+  void tst_abort();
   void tst_invalidreg();
   void tst_expression();
   void tst_invalidLabel();
@@ -47,6 +48,7 @@ private slots:
   void tst_stringDirectives();
   void tst_riscv();
   void tst_relativeLabels();
+  void tst_lexer();
 
 private:
   QString createProgram(int entries) {
@@ -262,6 +264,27 @@ void tst_Assembler::tst_benchmarkNew() {
   QBENCHMARK { assembler.assembleRaw(program); }
 }
 
+void tst_Assembler::tst_abort() {
+  auto isa = std::make_unique<ISAInfo<ISA::RV32I>>(QStringList());
+  auto assembler = RV32I_Assembler(isa.get());
+  auto program = createProgram(100);
+
+  std::atomic<bool> abort = false;
+  auto res = assembler.assembleRaw(program, nullptr, &abort);
+  QVERIFY(!res.aborted);
+  QVERIFY(res.errors.empty());
+
+  abort = true;
+  res = assembler.assembleRaw(program, nullptr, &abort);
+  QVERIFY(res.aborted);
+  QVERIFY(res.errors.empty());
+
+  // The abort flag only applies to the assemble call it was provided to.
+  res = assembler.assembleRaw(program);
+  QVERIFY(!res.aborted);
+  QVERIFY(res.errors.empty());
+}
+
 void tst_Assembler::tst_simpleprogram() {
   testAssemble(QStringList() << ".data"
                              << "B: .word 1, 2, 2"
@@ -418,5 +441,42 @@ void tst_Assembler::tst_matcher() {
   }
 }
 
+void tst_Assembler::tst_lexer() {
+  std::vector<LexedToken> tokens;
+  auto checkTokens =
+      [&](const QString &line,
+          const std::vector<std::pair<TokenClass, QString>> &expected) {
+        lexLine(line, '#', tokens);
+        QCOMPARE(tokens.size(), expected.size());
+        for (unsigned i = 0; i < expected.size(); ++i) {
+          QCOMPARE(tokens.at(i).tokenClass, expected.at(i).first);
+          QCOMPARE(line.mid(tokens.at(i).start, tokens.at(i).length),
+                   expected.at(i).second);
+        }
+      };
+
+  checkTokens(R"(L1: lw a0, -4(sp) # "comment" 1b)",
+              {{TokenClass::Label, "L1:"},
+               {TokenClass::Identifier, "lw"},
+               {TokenClass::Identifier, "a0"},
+               {TokenClass::Immediate, "-4"},
+               {TokenClass::Punctuation, "("},
+               {TokenClass::Identifier, "sp"},
+               {TokenClass::Punctuation, ")"},
+               {TokenClass::Comment, R"(# "comment" 1b)"}});
+
+  // Quoted separators and escaped quotes are part of the string token.
+  checkTokens(R"(.string "a, \" b")", {{TokenClass::Identifier, ".string"},
+                                      {TokenClass::String, R"("a, \" b")"}});
+
+  // A sign following a word is an operator, not part of an immediate.
+  checkTokens("li a0 B-0x10",
+              {{TokenClass::Identifier, "li"},
+               {TokenClass::Identifier, "a0"},
+               {TokenClass::Identifier, "B"},
+               {TokenClass::Punctuation, "-"},
+               {TokenClass::Immediate, "0x10"}});
+}
+
 QTEST_APPLESS_MAIN(tst_Assembler)
 #include "tst_assembler.moc"
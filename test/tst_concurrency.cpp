@@ -0,0 +1,297 @@
+#include <QSemaphore>
+#include <QtTest/QTest>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "processors/interface/registerjournal.h"
+#include "simulationthread.h"
+#include "utilities/spscqueue.h"
+#include "utilities/triplebuffer.h"
+
+using namespace Ripes;
+
+// Tests of the primitives used for communicating with the simulation thread.
+
+// A value which is torn if its words differ.
+struct Snapshot {
+  std::array<unsigned, 64> words{};
+  void fill(unsigned value) { words.fill(value); }
+  bool torn() const {
+    for (const unsigned word : words) {
+      if (word != words.front())
+        return true;
+    }
+    return false;
+  }
+};
+
+// Number of values passed between threads in the multithreaded tests.
+constexpr unsigned s_nValues = 100000;
+
+class tst_Concurrency : public QObject {
+  Q_OBJECT
+
+private slots:
+  void tst_queueEmptyFull();
+  void tst_queueWraparound();
+  void tst_queueThreaded();
+  void tst_commandOrder();
+  void tst_commandQueueFull();
+  void tst_waitForIdle();
+  void tst_tripleBufferPublish();
+  void tst_tripleBufferThreaded();
+  void tst_registerJournalThreaded();
+};
+
+void tst_Concurrency::tst_queueEmptyFull() {
+  SPSCQueue<int, 4> queue;
+  int value = -1;
+  QVERIFY(queue.empty());
+  QVERIFY(!queue.pop(value));
+  QCOMPARE(value, -1);
+
+  for (int i = 0; i < 4; ++i)
+    QVERIFY(queue.push(i));
+  QVERIFY(!queue.empty());
+  QVERIFY(!queue.push(4));
+
+  // Popping a value makes room for another.
+  QVERIFY(queue.pop(value));
+  QCOMPARE(value, 0);
+  QVERIFY(queue.push(4));
+  QVERIFY(!queue.push(5));
+
+  for (int i = 1; i <= 4; ++i) {
+    QVERIFY(queue.pop(value));
+    QCOMPARE(value, i);
+  }
+  QVERIFY(queue.empty());
+  QVERIFY(!queue.pop(value));
+}
+
+void tst_Concurrency::tst_queueWraparound() {
+  // Pushing and popping 3 values at a time through a queue of capacity 4 makes
+  // the indices wrap around the buffer at every possible offset.
+  SPSCQueue<int, 4> queue;
+  int next = 0;
+  int expected = 0;
+  for (int round = 0; round < 100; ++round) {
+    for (int i = 0; i < 3; ++i)
+      QVERIFY(queue.push(next++));
+    for (int i = 0; i < 3; ++i) {
+      int value;
+      QVERIFY(queue.pop(value));
+      QCOMPARE(value, expected++);
+    }
+    QVERIFY(queue.empty());
+  }
+}
+
+void tst_Concurrency::tst_queueThreaded() {
+  SPSCQueue<unsigned, 64> queue;
+  std::thread producer([&] {
+    for (unsigned i = 0; i < s_nValues; ++i) {
+      while (!queue.push(i))
+        std::this_thread::yield();
+    }
+  });
+
+  // Values are received in order, without loss nor duplication.
+  unsigned expected = 0;
+  bool inOrder = true;
+  while (expected < s_nValues) {
+    unsigned value;
+    if (!queue.pop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    inOrder &= value == expected++;
+  }
+  producer.join();
+  QVERIFY(inOrder);
+  QVERIFY(queue.empty());
+}
+
+void tst_Concurrency::tst_commandOrder() {
+  // Only accessed from the simulation thread until it is idle.
+  std::vector<unsigned long long> executed;
+  bool onSimThread = true;
+  SimulationThread *simThread = nullptr;
+  SimulationThread thread([&](const SimulationCommand &command) {
+    onSimThread &= simThread->isCurrentThread();
+    executed.push_back(command.cycles);
+  });
+  simThread = &thread;
+  thread.start();
+
+  // Post more commands than fit in the command queue.
+  for (unsigned i = 0; i < 1000; ++i) {
+    SimulationCommand command;
+    command.type = SimulationCommand::Step;
+    command.cycles = i;
+    thread.post(command);
+  }
+  thread.waitForIdle();
+
+  QVERIFY(onSimThread);
+  QCOMPARE(executed.size(), size_t(1000));
+  for (unsigned i = 0; i < executed.size(); ++i)
+    QCOMPARE(executed[i], static_cast<unsigned long long>(i));
+}
+
+void tst_Concurrency::tst_commandQueueFull() {
+  QSemaphore started;
+  QSemaphore gate;
+  std::atomic<unsigned> executed{0};
+  SimulationThread thread([&](const SimulationCommand &command) {
+    if (command.cycles == 0) {
+      started.release();
+      gate.acquire();
+    }
+    ++executed;
+  });
+  thread.start();
+
+  // Block the simulation thread in the first command, and fill the queue.
+  SimulationCommand command;
+  command.type = SimulationCommand::Step;
+  command.cycles = 0;
+  QVERIFY(thread.tryPost(command));
+  started.acquire();
+  command.cycles = 1;
+  for (unsigned i = 0; i < 256; ++i)
+    QVERIFY(thread.tryPost(command));
+  QVERIFY(!thread.tryPost(command));
+
+  gate.release();
+  thread.waitForIdle();
+  QCOMPARE(executed.load(), 257u);
+}
+
+void tst_Concurrency::tst_waitForIdle() {
+  std::atomic<unsigned> executed{0};
+  SimulationThread thread([&](const SimulationCommand &) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ++executed;
+  });
+  thread.start();
+
+  // Posted commands are executed asynchronously; waitForIdle returns once
+  // all of them have been executed.
+  SimulationCommand command;
+  command.type = SimulationCommand::Step;
+  for (unsigned i = 0; i < 20; ++i)
+    thread.post(command);
+  thread.waitForIdle();
+  QCOMPARE(executed.load(), 20u);
+
+  // execute() returns once the command itself has been executed.
+  thread.execute(command);
+  QCOMPARE(executed.load(), 21u);
+}
+
+void tst_Concurrency::tst_tripleBufferPublish() {
+  TripleBuffer<Snapshot> buffer;
+  QVERIFY(!buffer.update());
+
+  buffer.back().fill(1);
+  buffer.publish();
+  QVERIFY(buffer.update());
+  QCOMPARE(buffer.front().words.front(), 1u);
+  // A value is only picked up once.
+  QVERIFY(!buffer.update());
+  QCOMPARE(buffer.front().words.front(), 1u);
+
+  // Writing to the back buffer does not affect the front buffer.
+  buffer.back().fill(2);
+  QCOMPARE(buffer.front().words.front(), 1u);
+  buffer.publish();
+
+  // If multiple values are published between updates, the most recent one is
+  // picked up.
+  buffer.back().fill(3);
+  buffer.publish();
+  QVERIFY(buffer.update());
+  QCOMPARE(buffer.front().words.front(), 3u);
+  QVERIFY(!buffer.front().torn());
+  QVERIFY(!buffer.update());
+}
+
+void tst_Concurrency::tst_tripleBufferThreaded() {
+  TripleBuffer<Snapshot> buffer;
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    for (unsigned i = 1; i <= s_nValues; ++i) {
+      buffer.back().fill(i);
+      buffer.publish();
+    }
+    done = true;
+  });
+
+  // Every value picked up by the reader is complete, and newer than the
+  // previous one.
+  unsigned last = 0;
+  bool torn = false;
+  bool stale = false;
+  while (!done) {
+    if (!buffer.update())
+      continue;
+    const Snapshot &snapshot = buffer.front();
+    torn |= snapshot.torn();
+    stale |= snapshot.words.front() <= last;
+    last = snapshot.words.front();
+  }
+  writer.join();
+
+  QVERIFY(!torn);
+  QVERIFY(!stale);
+  // Once the writer is done, the final value is available to the reader.
+  if (last != s_nValues) {
+    QVERIFY(buffer.update());
+    QVERIFY(!buffer.front().torn());
+    QCOMPARE(buffer.front().words.front(), s_nValues);
+  }
+}
+
+void tst_Concurrency::tst_registerJournalThreaded() {
+  RegisterJournal journal;
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    for (unsigned i = 1; i <= s_nValues; ++i)
+      journal.record(RegisterFileType::GPR, i % 32, i);
+    done = true;
+  });
+
+  // Consumed writes are complete and in order. If the writer overflows the
+  // journal, consumption restarts from the current position, as a consumer
+  // re-reading the register files would.
+  uint64_t position = 0;
+  VInt last = 0;
+  bool inOrder = true;
+  bool complete = true;
+  const auto consume = [&] {
+    const auto end = journal.forEachSince(
+        position, [&](const RegisterJournal::Write &write) {
+          complete &= write.index == write.value % 32;
+          inOrder &= write.value > last;
+          last = write.value;
+        });
+    position = end ? *end : journal.position();
+  };
+  while (!done)
+    consume();
+  writer.join();
+  consume();
+
+  QVERIFY(complete);
+  QVERIFY(inOrder);
+  QCOMPARE(position, journal.position());
+  QCOMPARE(journal.writesRecorded(), uint64_t(s_nValues));
+}
+
+QTEST_MAIN(tst_Concurrency)
+#include "tst_concurrency.moc"
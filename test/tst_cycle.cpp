@@ -0,0 +1,321 @@
+#include <QMetaEnum>
+#include <QtTest/QTest>
+
+#include "processorhandler.h"
+#include "processorregistry.h"
+#include "programloader.h"
+#include "ripessettings.h"
+#include "utilities/cycleprofiler.h"
+
+using namespace Ripes;
+
+// Number of cycles clocked per benchmark iteration.
+constexpr unsigned s_nCycles = 10000;
+// Number of executable address checks performed per benchmark iteration.
+constexpr unsigned s_nChecks = 100000;
+
+// A program which never finishes, keeping all pipeline stages busy.
+const QStringList s_loopProgram = {"loop:",
+                                   "addi a0 a0 1",
+                                   "addi a1 a1 2",
+                                   "add a2 a0 a1",
+                                   "sw a2 0(sp)",
+                                   "lw a3 0(sp)",
+                                   "j loop"};
+
+// This test measures the per-cycle overhead which Ripes adds on top of the
+// simulation of a processor model.
+
+class tst_Cycle : public QObject {
+  Q_OBJECT
+
+private slots:
+  void initTestCase();
+  void tst_addressRanges();
+  void tst_profiler();
+  void tst_retireHandler_data();
+  void tst_retireHandler();
+  void tst_registerJournal();
+  void tst_registerJournalReplay_data();
+  void tst_registerJournalReplay();
+  void tst_benchmarkExecutableCheck_data();
+  void tst_benchmarkExecutableCheck();
+  void tst_benchmarkCycle_data();
+  void tst_benchmarkCycle();
+
+private:
+  void loadProcessor(ProcessorID id);
+
+  ProgramLoader *m_loader = nullptr;
+};
+
+void tst_Cycle::initTestCase() { m_loader = new ProgramLoader(); }
+
+void tst_Cycle::loadProcessor(ProcessorID id) {
+  // Default register values are used to ensure a valid stack pointer.
+  ProcessorHandler::selectProcessor(
+      id, {}, ProcessorRegistry::getDescription(id).defaultRegisterVals);
+  RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+  ProcessorHandler::getProcessorNonConst()->trapHandler = [=] {};
+  m_loader->loadTest(s_loopProgram.join("\n"));
+}
+
+void tst_Cycle::tst_addressRanges() {
+  AddressRanges ranges;
+  QVERIFY(!ranges.contains(0));
+
+  ranges.add(0x1000, 0x1010);
+  ranges.add(0x100, 0x104);
+  ranges.add(0x2000, 0x2000); // Empty ranges are ignored
+  QVERIFY(!ranges.contains(0xFC));
+  QVERIFY(ranges.contains(0x100));
+  QVERIFY(!ranges.contains(0x104));
+  QVERIFY(!ranges.contains(0xFFF));
+  QVERIFY(ranges.contains(0x1000));
+  QVERIFY(ranges.contains(0x100C));
+  QVERIFY(!ranges.contains(0x1010));
+  QVERIFY(!ranges.contains(0x2000));
+
+  ranges.clear();
+  QVERIFY(ranges.empty());
+  QVERIFY(!ranges.contains(0x100));
+}
+
+void tst_Cycle::tst_profiler() {
+  loadProcessor(ProcessorID::RV32_5S);
+  auto *proc = ProcessorHandler::getProcessorNonConst();
+
+  CycleProfiler::reset();
+  for (unsigned i = 0; i < 10; ++i)
+    proc->clock();
+  // Disabled profiling must not record anything.
+  QCOMPARE(CycleProfiler::calls(CycleProfiler::Cycle), uint64_t(0));
+
+  CycleProfiler::setEnabled(true);
+  for (unsigned i = 0; i < 10; ++i)
+    proc->clock();
+  CycleProfiler::setEnabled(false);
+
+  QCOMPARE(CycleProfiler::calls(CycleProfiler::Cycle), uint64_t(10));
+  QCOMPARE(CycleProfiler::calls(CycleProfiler::DesignClock), uint64_t(10));
+  QVERIFY(CycleProfiler::nanoseconds(CycleProfiler::Cycle) >=
+          CycleProfiler::nanoseconds(CycleProfiler::DesignClock));
+}
+
+void tst_Cycle::tst_retireHandler_data() {
+  QTest::addColumn<ProcessorID>("id");
+  const auto idEnum = QMetaEnum::fromType<ProcessorID>();
+  for (const auto &desc : ProcessorRegistry::getAvailableProcessors()) {
+    QTest::newRow(idEnum.valueToKey(desc.first)) << desc.first;
+  }
+}
+
+void tst_Cycle::tst_retireHandler() {
+  QFETCH(ProcessorID, id);
+  loadProcessor(id);
+  auto *proc = ProcessorHandler::getProcessorNonConst();
+
+  std::vector<RetiredInstruction> retired;
+  proc->retireHandler = [&](const RetiredInstruction &instr) {
+    retired.push_back(instr);
+  };
+  while (retired.size() < s_loopProgram.size() - 1)
+    proc->clock();
+  proc->retireHandler = nullptr;
+
+  // Instructions retire in program order, reporting their effects.
+  const AInt sp = proc->getRegister(RegisterFileType::GPR, 2);
+  for (unsigned i = 0; i < retired.size(); ++i)
+    QCOMPARE(retired[i].pc, AInt(i * 4));
+  QVERIFY(retired[0].regWrite);
+  QCOMPARE(retired[0].rd, 10u);
+  QCOMPARE(retired[0].rdValue, VInt(1));
+  QCOMPARE(retired[0].instr, VInt(0x00150513)); // addi a0 a0 1
+  QCOMPARE(retired[2].rdValue, VInt(3));
+  QCOMPARE(retired[3].memAccess.type, MemoryAccess::Write);
+  QCOMPARE(retired[3].memAccess.address, sp);
+  QCOMPARE(retired[3].memValue, VInt(3));
+  QVERIFY(!retired[3].regWrite);
+  QCOMPARE(retired[4].memAccess.type, MemoryAccess::Read);
+  QCOMPARE(retired[4].rd, 13u);
+  QCOMPARE(retired[4].rdValue, VInt(3));
+}
+
+void tst_Cycle::tst_registerJournal() {
+  RegisterJournal journal;
+  std::vector<RegisterJournal::Write> writes;
+  const auto collect = [&](const RegisterJournal::Write &write) {
+    writes.push_back(write);
+  };
+
+  // Writes are replayed in the order in which they were recorded.
+  const uint64_t start = journal.position();
+  for (unsigned i = 0; i < 10; ++i)
+    journal.record(RegisterFileType::GPR, i, i * 2);
+  QCOMPARE(journal.writesRecorded(), uint64_t(10));
+  // The position up to which the journal was consumed is returned.
+  const auto end = journal.forEachSince(start, collect);
+  QVERIFY(end);
+  QCOMPARE(*end, journal.position());
+  QCOMPARE(writes.size(), size_t(10));
+  for (unsigned i = 0; i < writes.size(); ++i) {
+    QCOMPARE(writes[i].index, i);
+    QCOMPARE(writes[i].value, VInt(i * 2));
+  }
+
+  // Only the writes recorded since the given position are replayed.
+  writes.clear();
+  QVERIFY(journal.forEachSince(start + 7, collect));
+  QCOMPARE(writes.size(), size_t(3));
+  QCOMPARE(writes.front().index, 7u);
+  writes.clear();
+  QVERIFY(journal.forEachSince(journal.position(), collect));
+  QVERIFY(writes.empty());
+
+  // Up to s_capacity writes since a position can be replayed; any more
+  // overflow the journal.
+  const uint64_t beforeOverflow = journal.position();
+  for (unsigned i = 0; i < RegisterJournal::s_capacity; ++i)
+    journal.record(RegisterFileType::GPR, 1, i);
+  QVERIFY(journal.forEachSince(beforeOverflow, collect));
+  QCOMPARE(writes.size(), RegisterJournal::s_capacity);
+  QCOMPARE(writes.back().value, VInt(RegisterJournal::s_capacity - 1));
+  writes.clear();
+  journal.record(RegisterFileType::GPR, 1, 0);
+  QVERIFY(!journal.forEachSince(beforeOverflow, collect));
+  QVERIFY(writes.empty());
+  QVERIFY(journal.forEachSince(journal.position() - 1, collect));
+  QCOMPARE(writes.size(), size_t(1));
+
+  // Invalidation discards all writes recorded so far.
+  writes.clear();
+  const uint64_t beforeInvalidate = journal.position();
+  journal.record(RegisterFileType::GPR, 2, 42);
+  journal.invalidate();
+  QVERIFY(!journal.forEachSince(beforeInvalidate, collect));
+  QVERIFY(writes.empty());
+  const uint64_t afterInvalidate = journal.position();
+  journal.record(RegisterFileType::GPR, 3, 43);
+  QVERIFY(journal.forEachSince(afterInvalidate, collect));
+  QCOMPARE(writes.size(), size_t(1));
+  QCOMPARE(writes.front().index, 3u);
+
+  // Clearing additionally resets the count of recorded writes.
+  writes.clear();
+  const uint64_t beforeClear = journal.position();
+  journal.clear();
+  QCOMPARE(journal.writesRecorded(), uint64_t(0));
+  QVERIFY(!journal.forEachSince(beforeClear, collect));
+  QVERIFY(journal.forEachSince(journal.position(), collect));
+  QVERIFY(writes.empty());
+}
+
+void tst_Cycle::tst_registerJournalReplay_data() {
+  QTest::addColumn<ProcessorID>("id");
+  const auto idEnum = QMetaEnum::fromType<ProcessorID>();
+  for (const auto &desc : ProcessorRegistry::getAvailableProcessors()) {
+    QTest::newRow(idEnum.valueToKey(desc.first)) << desc.first;
+  }
+}
+
+void tst_Cycle::tst_registerJournalReplay() {
+  QFETCH(ProcessorID, id);
+  loadProcessor(id);
+  auto *proc = ProcessorHandler::getProcessorNonConst();
+  const auto &journal = proc->registerJournal();
+  const unsigned regCnt = ProcessorHandler::currentISA()->regCnt();
+
+  std::vector<VInt> regs(regCnt);
+  for (unsigned i = 0; i < regCnt; ++i)
+    regs[i] = proc->getRegister(RegisterFileType::GPR, i);
+  uint64_t position = journal.position();
+  const uint64_t recorded = journal.writesRecorded();
+
+  // Replaying the journaled writes onto the initial register state must
+  // reproduce the register file. The journal is consumed often enough for it
+  // to never overflow.
+  for (unsigned chunk = 0; chunk < 20; ++chunk) {
+    for (unsigned i = 0; i < 50; ++i)
+      proc->clock();
+    const auto end = journal.forEachSince(
+        position, [&](const RegisterJournal::Write &write) {
+          if (write.rfid == RegisterFileType::GPR)
+            regs[write.index] = write.value;
+        });
+    QVERIFY(end);
+    QCOMPARE(*end, journal.position());
+    position = *end;
+  }
+  QVERIFY(journal.writesRecorded() > recorded);
+
+  // x0 is hardwired to zero; writes to it are discarded by the register file.
+  for (unsigned i = 1; i < regCnt; ++i)
+    QCOMPARE(regs[i], proc->getRegister(RegisterFileType::GPR, i));
+}
+
+void tst_Cycle::tst_benchmarkExecutableCheck_data() {
+  QTest::addColumn<bool>("cached");
+  QTest::newRow("section lookup") << false;
+  QTest::newRow("address ranges") << true;
+}
+
+void tst_Cycle::tst_benchmarkExecutableCheck() {
+  QFETCH(bool, cached);
+  loadProcessor(ProcessorID::RV32_5S);
+  const auto program = ProcessorHandler::getProgram();
+  const auto *proc = ProcessorHandler::getProcessor();
+
+  // The executable address check as it was performed before executable ranges
+  // were cached within the processor.
+  std::function<bool(AInt)> sectionLookup = [=](AInt address) {
+    if (auto *textSection = program->getSection(TEXT_SECTION_NAME)) {
+      const auto textStart = textSection->address;
+      const auto textEnd = textSection->address + textSection->data.length();
+      return textStart <= address && address < textEnd;
+    }
+    return false;
+  };
+
+  const AInt textStart = program->getSection(TEXT_SECTION_NAME)->address;
+  unsigned nExecutable = 0;
+  QBENCHMARK {
+    for (unsigned i = 0; i < s_nChecks; ++i) {
+      const AInt address = textStart + (i % 64) * 4;
+      nExecutable += cached ? proc->isExecutableAddress(address)
+                            : sectionLookup(address);
+    }
+  }
+  QVERIFY(nExecutable > 0);
+}
+
+void tst_Cycle::tst_benchmarkCycle_data() {
+  QTest::addColumn<ProcessorID>("id");
+  const auto idEnum = QMetaEnum::fromType<ProcessorID>();
+  for (const auto &desc : ProcessorRegistry::getAvailableProcessors()) {
+    QTest::newRow(idEnum.valueToKey(desc.first)) << desc.first;
+  }
+}
+
+void tst_Cycle::tst_benchmarkCycle() {
+  QFETCH(ProcessorID, id);
+  loadProcessor(id);
+  auto *proc = ProcessorHandler::getProcessorNonConst();
+
+  // Clock as done in ProcessorHandler::run, with signals disabled.
+  auto *vsrtlProc = dynamic_cast<vsrtl::SimDesign *>(proc);
+  if (vsrtlProc)
+    vsrtlProc->setEnableSignals(false);
+
+  QBENCHMARK {
+    for (unsigned i = 0; i < s_nCycles; ++i) {
+      proc->clock();
+    }
+  }
+
+  if (vsrtlProc)
+    vsrtlProc->setEnableSignals(true);
+  QVERIFY(!proc->finished());
+}
+
+QTEST_MAIN(tst_Cycle)
+#include "tst_cycle.moc"
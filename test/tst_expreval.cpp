@@ -9,6 +9,9 @@ class tst_ExprEval : public QObject {
 
 private slots:
   void tst_binops();
+  void tst_compiled();
+  void tst_benchmarkParse();
+  void tst_benchmarkCompiled();
 };
 
 void expect(const ExprEvalRes &res, const ExprEvalVT &expected) {
@@ -23,8 +26,61 @@ void tst_ExprEval::tst_binops() {
   expect(evaluate(Location::unknown(), "(0x2*(3+4))+4"), 18);
   expect(evaluate(Location::unknown(), "2+3*7*5"), 107);
   SymbolMap symbols;
-  Location::unknown(), symbols.abs["B"] = 2;
-  expect(evaluate(Location::unknown(), "(B *(3+ 4))+4", &symbols.abs), 18);
+  symbols.addAbsSymbol(0, "B", 2);
+  expect(evaluate(Location::unknown(), "(B *(3+ 4))+4", &symbols), 18);
+}
+
+void tst_ExprEval::tst_compiled() {
+  SymbolMap symbols;
+  auto compiled = compileExpression(Location::unknown(),
+                                    "((B - __address__) * 2) + 1b", symbols);
+  QVERIFY(compiled.isResult());
+  const auto &expr = compiled.value();
+
+  // Symbols may be defined after compilation.
+  QVERIFY(evaluate(Location(1), expr, symbols).isError());
+  symbols.addAbsSymbol(0, "B", 100);
+  symbols.addRelSymbol(1, "1", 10);
+  symbols.addRelSymbol(3, "1", 20);
+  QVERIFY(evaluate(Location(0), expr, symbols, 60).isError());
+  expect(evaluate(Location(2), expr, symbols, 60), 90);
+  expect(evaluate(Location(3), expr, symbols, 60), 100);
+
+  // Agrees with the expression tree evaluator.
+  for (const auto &s : {"(0x2*(3+4))+4", "2+3*7*5", "-4+(B%7)", "(B|3)&0x1f",
+                        "(0xfff@12)-1"}) {
+    auto res = compileExpression(Location::unknown(), s, symbols);
+    QVERIFY(res.isResult());
+    expect(evaluate(Location::unknown(), res.value(), symbols),
+           std::get<ExprEvalVT>(evaluate(Location::unknown(), s, &symbols)));
+  }
+
+  QVERIFY(compileExpression(Location::unknown(), "1+2)", symbols).isError());
+  auto divByZero = compileExpression(Location::unknown(), "B/0", symbols);
+  QVERIFY(evaluate(Location::unknown(), divByZero.value(), symbols).isError());
+}
+
+// Representative of the expressions of %hi/%lo relocations.
+static const QString s_benchmarkExpr = "((B + 0x800) & 0xfffff000) + 4";
+
+void tst_ExprEval::tst_benchmarkParse() {
+  SymbolMap symbols;
+  symbols.addAbsSymbol(0, "B", 0x10000);
+  QBENCHMARK {
+    expect(evaluate(Location::unknown(), s_benchmarkExpr, &symbols), 0x10004);
+  }
+}
+
+void tst_ExprEval::tst_benchmarkCompiled() {
+  SymbolMap symbols;
+  symbols.addAbsSymbol(0, "B", 0x10000);
+  auto compiled =
+      compileExpression(Location::unknown(), s_benchmarkExpr, symbols);
+  QVERIFY(compiled.isResult());
+  const auto &expr = compiled.value();
+  QBENCHMARK {
+    expect(evaluate(Location::unknown(), expr, symbols), 0x10004);
+  }
 }
 
 QTEST_APPLESS_MAIN(tst_ExprEval)
@@ -0,0 +1,115 @@
+#include <QtTest/QTest>
+
+#include "io/iomanager.h"
+#include "processorhandler.h"
+
+using namespace Ripes;
+
+// Number of accesses performed per benchmark iteration.
+constexpr unsigned s_nAccesses = 100000;
+// An address outside of any memory-mapped peripheral.
+constexpr AInt s_ramAddress = 0x10000000;
+
+class tst_IO : public QObject {
+  Q_OBJECT
+
+private slots:
+  void initTestCase();
+  void cleanupTestCase();
+  void tst_dispatch();
+  void tst_benchmarkRAMLoads();
+  void tst_benchmarkIOLoads();
+  void tst_benchmarkRAMStores();
+  void tst_benchmarkIOStores();
+
+private:
+  AInt baseAddress(IOBase *peripheral) const;
+
+  IOBase *m_ledMatrix = nullptr;
+  IOBase *m_switches = nullptr;
+  IOBase *m_dpad = nullptr;
+};
+
+void tst_IO::initTestCase() {
+  ProcessorHandler::selectProcessor(ProcessorID::RV32_SS);
+  m_ledMatrix = IOManager::get().createPeripheral(IOType::LED_MATRIX);
+  m_switches = IOManager::get().createPeripheral(IOType::SWITCHES);
+  m_dpad = IOManager::get().createPeripheral(IOType::DPAD);
+}
+
+void tst_IO::cleanupTestCase() {
+  delete m_ledMatrix;
+  delete m_switches;
+  delete m_dpad;
+}
+
+AInt tst_IO::baseAddress(IOBase *peripheral) const {
+  for (const auto &entry : IOManager::get().memoryMap()) {
+    if (entry.second.name == peripheral->name()) {
+      return entry.second.startAddr;
+    }
+  }
+  QTest::qFail("Peripheral not found in memory map", __FILE__, __LINE__);
+  return 0;
+}
+
+void tst_IO::tst_dispatch() {
+  auto &mem = ProcessorHandler::getMemory();
+
+  // Stores to the LED matrix must reach the peripheral and be readable back.
+  const AInt ledBase = baseAddress(m_ledMatrix);
+  mem.writeMem(ledBase + 8, 0x00FF00, 4);
+  QCOMPARE(m_ledMatrix->ioRead(8, 4), VInt(0x00FF00));
+  QCOMPARE(mem.readMem(ledBase + 8, 4), VInt(0x00FF00));
+
+  // Switches and D-pad are read-only, and default to 0.
+  QCOMPARE(mem.readMem(baseAddress(m_switches), 4), VInt(0));
+  const AInt dpadBase = baseAddress(m_dpad);
+  mem.writeMem(dpadBase, 1, 4);
+  QCOMPARE(mem.readMem(dpadBase, 4), VInt(0));
+
+  // RAM is unaffected by IO mappings.
+  mem.writeMem(s_ramAddress, 0xCAFE, 4);
+  QCOMPARE(mem.readMem(s_ramAddress, 4), VInt(0xCAFE));
+}
+
+void tst_IO::tst_benchmarkRAMLoads() {
+  auto &mem = ProcessorHandler::getMemory();
+  QBENCHMARK {
+    for (unsigned i = 0; i < s_nAccesses; ++i) {
+      mem.readMem(s_ramAddress + (i % 16) * 4, 4);
+    }
+  }
+}
+
+void tst_IO::tst_benchmarkIOLoads() {
+  auto &mem = ProcessorHandler::getMemory();
+  const AInt switches = baseAddress(m_switches);
+  QBENCHMARK {
+    for (unsigned i = 0; i < s_nAccesses; ++i) {
+      mem.readMem(switches, 4);
+    }
+  }
+}
+
+void tst_IO::tst_benchmarkRAMStores() {
+  auto &mem = ProcessorHandler::getMemory();
+  QBENCHMARK {
+    for (unsigned i = 0; i < s_nAccesses; ++i) {
+      mem.writeMem(s_ramAddress + (i % 16) * 4, i, 4);
+    }
+  }
+}
+
+void tst_IO::tst_benchmarkIOStores() {
+  auto &mem = ProcessorHandler::getMemory();
+  const AInt ledBase = baseAddress(m_ledMatrix);
+  QBENCHMARK {
+    for (unsigned i = 0; i < s_nAccesses; ++i) {
+      mem.writeMem(ledBase + (i % 16) * 4, i, 4);
+    }
+  }
+}
+
+QTEST_MAIN(tst_IO)
+#include "tst_io.moc"
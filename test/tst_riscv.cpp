@@ -6,6 +6,7 @@
 #include "processorhandler.h"
 #include "processorregistry.h"
 #include "ripessettings.h"
+#include "testsharding.h"
 
 #include "assembler/rv32i_assembler.h"
 
@@ -61,6 +62,7 @@ private:
   bool m_stop = false;
   std::shared_ptr<Program> m_program;
   QString m_err;
+  TestSharding m_sharding;
 
 private slots:
 
@@ -191,6 +193,8 @@ void tst_RISCV::runTests(const ProcessorID &id, const QStringList &extensions,
       m_currentTest = testPath;
       if (skipTest(test))
         continue;
+      if (!m_sharding.next())
+        continue;
 
       qInfo() << "Running test: " << m_currentTest;
 